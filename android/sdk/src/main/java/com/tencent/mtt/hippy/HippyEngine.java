@@ -228,6 +228,8 @@ public abstract class HippyEngine {
   public static class V8InitParams {
     public long initialHeapSize;
     public long maximumHeapSize;
+    // WorkerTaskRunner 线程数，0 使用默认值
+    public int workerPoolSize;
   }
 
   // Hippy 引擎初始化时的参数设置
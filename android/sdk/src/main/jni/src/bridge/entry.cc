@@ -464,6 +464,10 @@ jlong InitInstance(JNIEnv* j_env,
     TDF_BASE_CHECK(maximum_heap_size_in_bytes <= std::numeric_limits<size_t>::max());
     param->maximum_heap_size_in_bytes = static_cast<size_t>(maximum_heap_size_in_bytes);
     TDF_BASE_CHECK(initial_heap_size_in_bytes <= maximum_heap_size_in_bytes);
+    jfieldID pool_field = j_env->GetFieldID(cls,"workerPoolSize","I");
+    jint worker_pool_size = j_env->GetIntField(j_vm_init_param, pool_field);
+    TDF_BASE_CHECK(worker_pool_size >= 0);
+    param->worker_pool_size = static_cast<uint32_t>(worker_pool_size);
   }
   std::shared_ptr<Engine> engine;
   if (j_is_dev_module) {
@@ -0,0 +1,25 @@
+#! /bin/bash
+
+CMAKE=`which cmake`
+MAKE=`which make`
+
+BASH_SOURCE_DIR=$(cd `dirname "${BASH_SOURCE[0]}"` && pwd)
+BUILD_DIR="${BASH_SOURCE_DIR}"/../out
+
+rm -rf "${BUILD_DIR}"/task_runner_benchmark
+mkdir -p "${BUILD_DIR}"/task_runner_benchmark
+cd "${BUILD_DIR}"/task_runner_benchmark
+
+#cmake generate make file
+"${CMAKE}" ../../benchmark
+
+echo "Start build in directory: `pwd`"
+${MAKE}
+
+#run task_runner_benchmark and worker_task_runner_benchmark
+for BENCHMARK in task_runner_benchmark worker_task_runner_benchmark; do
+BENCHMARK_RUN_PATH="${BUILD_DIR}"/task_runner_benchmark/${BENCHMARK}
+if [ -x "${BENCHMARK_RUN_PATH}" ];then
+${BENCHMARK_RUN_PATH}
+fi
+done
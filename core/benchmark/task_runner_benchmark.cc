@@ -0,0 +1,195 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Post/dispatch throughput of hippy::base::TaskRunner with 1 to 8 producer
+// threads, the way JNI threads post JavaScriptTasks to the JS thread.
+// "mutex queue" is the runner before the lock-free queue, one std::queue
+// under one mutex and condition_variable, kept here as the baseline.
+//   task_runner_benchmark [--tasks N]  // tasks per producer
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>              // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <memory>
+#include <mutex>   // NOLINT(build/c++11)
+#include <queue>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "core/base/task.h"
+#include "core/base/task_runner.h"
+
+namespace hippy {
+namespace napi {
+// the benchmark runs no JS engine
+void DetachThread() {}
+}  // namespace napi
+}  // namespace hippy
+
+namespace {
+
+std::atomic<uint64_t> g_run_count{0};
+
+class CountTask : public hippy::base::Task {
+ public:
+  bool isPriorityTask() override { return false; }
+  void Run() override { g_run_count.fetch_add(1, std::memory_order_relaxed); }
+};
+
+class MutexQueueRunner {
+ public:
+  MutexQueueRunner() : is_terminated_(false) {}
+
+  void Start() { thread_ = std::thread([this] { Run(); }); }
+  void Terminate() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_terminated_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+  }
+  void PostTask(std::shared_ptr<hippy::base::Task> task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_queue_.push(std::move(task));
+    cv_.notify_one();
+  }
+
+ private:
+  void Run() {
+    for (;;) {
+      std::shared_ptr<hippy::base::Task> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !task_queue_.empty() || is_terminated_; });
+        if (task_queue_.empty()) {
+          return;
+        }
+        task = std::move(task_queue_.front());
+        task_queue_.pop();
+      }
+      bool is_cancel;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_cancel = task->canceled_;
+      }
+      if (!is_cancel) {
+        task->Run();
+      }
+    }
+  }
+
+  bool is_terminated_;
+  std::queue<std::shared_ptr<hippy::base::Task>> task_queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+};
+
+struct Result {
+  // posts per second of all producers, until the last post returns
+  double post_mops;
+  // tasks run per second, until the last task has run
+  double dispatch_mops;
+};
+
+template <class Runner>
+Result RunBenchmark(Runner* runner, int producers, int tasks_per_producer) {
+  // tasks are created ahead, only posting is measured
+  std::vector<std::vector<std::shared_ptr<hippy::base::Task>>> tasks(producers);
+  for (int i = 0; i < producers; i++) {
+    for (int j = 0; j < tasks_per_producer; j++) {
+      tasks[i].push_back(std::make_shared<CountTask>());
+    }
+  }
+  uint64_t total = static_cast<uint64_t>(producers) * tasks_per_producer;
+  g_run_count = 0;
+  std::atomic<int> ready{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producers; i++) {
+    threads.emplace_back([&, i] {
+      ready++;
+      while (!go) {
+        std::this_thread::yield();
+      }
+      for (auto& task : tasks[i]) {
+        runner->PostTask(std::move(task));
+      }
+    });
+  }
+  while (ready < producers) {
+    std::this_thread::yield();
+  }
+  auto start = std::chrono::steady_clock::now();
+  go = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto posted = std::chrono::steady_clock::now();
+  while (g_run_count.load(std::memory_order_relaxed) < total) {
+    std::this_thread::yield();
+  }
+  auto done = std::chrono::steady_clock::now();
+
+  Result result;
+  result.post_mops =
+      total / std::chrono::duration<double, std::micro>(posted - start).count();
+  result.dispatch_mops =
+      total / std::chrono::duration<double, std::micro>(done - start).count();
+  return result;
+}
+
+void PrintResult(const char* name, int producers, const Result& result) {
+  printf("%-14s producers %d  post %8.3f Mops/s  dispatch %8.3f Mops/s\n", name,
+         producers, result.post_mops, result.dispatch_mops);
+}
+
+}  // namespace
+
+int main(int argc, char const* argv[]) {
+  int tasks_per_producer = 200000;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--tasks") == 0) {
+      tasks_per_producer = atoi(argv[i + 1]) > 0 ? atoi(argv[i + 1]) : 1;
+    }
+  }
+
+  for (int producers = 1; producers <= 8; producers *= 2) {
+    hippy::base::TaskRunner runner;
+    runner.Start();
+    PrintResult("TaskRunner", producers,
+                RunBenchmark(&runner, producers, tasks_per_producer));
+    runner.Terminate();
+
+    MutexQueueRunner baseline;
+    baseline.Start();
+    PrintResult("mutex queue", producers,
+                RunBenchmark(&baseline, producers, tasks_per_producer));
+    baseline.Terminate();
+  }
+  return 0;
+}
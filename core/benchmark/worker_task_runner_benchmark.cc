@@ -0,0 +1,111 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Throughput of WorkerTaskRunner for a mix of I/O-bound and CPU-bound tasks,
+// like file loads followed by code cache work. Every job is one I/O task,
+// which sleeps like a blocking read and then posts a CPU-bound task from the
+// worker thread, exercising worker queues and stealing.
+//   worker_task_runner_benchmark [--jobs N] [--io-us N] [--cpu-iterations N]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "core/task/common_task.h"
+#include "core/task/worker_task_runner.h"
+
+namespace hippy {
+namespace napi {
+// the benchmark runs no JS engine
+void DetachThread() {}
+}  // namespace napi
+}  // namespace hippy
+
+namespace {
+
+std::atomic<uint32_t> g_done_count{0};
+std::atomic<uint64_t> g_checksum{0};
+
+void CpuWork(uint32_t seed, int iterations) {
+  uint64_t hash = 14695981039346656037ull ^ seed;
+  for (int i = 0; i < iterations; i++) {
+    hash = (hash ^ static_cast<uint64_t>(i)) * 1099511628211ull;
+  }
+  g_checksum.fetch_add(hash, std::memory_order_relaxed);
+  g_done_count.fetch_add(1, std::memory_order_release);
+}
+
+double RunBenchmark(uint32_t pool_size, uint32_t jobs, int io_us,
+                    int cpu_iterations) {
+  WorkerTaskRunner runner(pool_size);
+  g_done_count = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < jobs; i++) {
+    std::unique_ptr<CommonTask> task = std::make_unique<CommonTask>();
+    task->func_ = [&runner, i, io_us, cpu_iterations] {
+      std::this_thread::sleep_for(std::chrono::microseconds(io_us));
+      std::unique_ptr<CommonTask> cpu_task = std::make_unique<CommonTask>();
+      cpu_task->func_ = [i, cpu_iterations] { CpuWork(i, cpu_iterations); };
+      runner.PostTask(std::move(cpu_task));
+    };
+    runner.PostTask(std::move(task));
+  }
+  while (g_done_count.load(std::memory_order_acquire) < jobs) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  auto end = std::chrono::steady_clock::now();
+  runner.Terminate();
+  return jobs / std::chrono::duration<double>(end - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char const* argv[]) {
+  uint32_t jobs = 2000;
+  int io_us = 1000;
+  int cpu_iterations = 200000;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    int value = atoi(argv[i + 1]);
+    if (strcmp(argv[i], "--jobs") == 0) {
+      jobs = value > 0 ? value : 1;
+    } else if (strcmp(argv[i], "--io-us") == 0) {
+      io_us = value >= 0 ? value : 0;
+    } else if (strcmp(argv[i], "--cpu-iterations") == 0) {
+      cpu_iterations = value >= 0 ? value : 0;
+    }
+  }
+
+  printf("jobs %u, io %d us, cpu %d iterations, %u hardware threads\n", jobs,
+         io_us, cpu_iterations, std::thread::hardware_concurrency());
+  for (uint32_t pool_size = 1; pool_size <= 8; pool_size *= 2) {
+    double jobs_per_second = RunBenchmark(pool_size, jobs, io_us, cpu_iterations);
+    printf("pool size %u  %10.1f jobs/s\n", pool_size, jobs_per_second);
+  }
+  // keeps the CPU work from being optimized out
+  printf("checksum %llx\n", static_cast<unsigned long long>(g_checksum.load()));
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/mpsc_queue.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest.h"
+
+namespace hippy {
+namespace base {
+namespace {
+
+constexpr uint32_t kProducers = 4;
+constexpr uint32_t kItemsPerProducer = 100000;
+
+struct Item {
+  uint32_t producer;
+  uint32_t sequence;
+};
+
+TEST(MpscQueueTest, PopsInPushOrder) {
+  MpscQueue<int> queue;
+  int value = 0;
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_FALSE(queue.Pop(&value));
+  for (int i = 0; i < 10; i++) {
+    queue.Push(i);
+  }
+  EXPECT_FALSE(queue.Empty());
+  for (int i = 0; i < 10; i++) {
+    ASSERT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_FALSE(queue.Pop(&value));
+}
+
+TEST(MpscQueueTest, ReleasesItemsLeftInQueue) {
+  std::shared_ptr<int> item = std::make_shared<int>(0);
+  {
+    MpscQueue<std::shared_ptr<int>> queue;
+    queue.Push(item);
+    queue.Push(item);
+    std::shared_ptr<int> popped;
+    ASSERT_TRUE(queue.Pop(&popped));
+    EXPECT_EQ(3, item.use_count());
+  }
+  EXPECT_EQ(1, item.use_count());
+}
+
+// every item pushed by the producers is popped once, and the items of one
+// producer come out in the order it pushed them.
+TEST(MpscQueueTest, MultiProducerTotals) {
+  MpscQueue<Item> queue;
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < kProducers; p++) {
+    producers.emplace_back([&queue, p] {
+      for (uint32_t i = 0; i < kItemsPerProducer; i++) {
+        queue.Push(Item{p, i});
+      }
+    });
+  }
+
+  std::vector<uint32_t> next(kProducers, 0);
+  uint64_t popped = 0;
+  uint64_t sum = 0;
+  while (popped < kProducers * kItemsPerProducer) {
+    Item item;
+    if (!queue.Pop(&item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_LT(item.producer, kProducers);
+    ASSERT_EQ(next[item.producer], item.sequence);
+    next[item.producer]++;
+    sum += item.sequence;
+    popped++;
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  Item item;
+  EXPECT_FALSE(queue.Pop(&item));
+  EXPECT_TRUE(queue.Empty());
+  uint64_t per_producer =
+      uint64_t(kItemsPerProducer) * (kItemsPerProducer - 1) / 2;
+  EXPECT_EQ(kProducers * per_producer, sum);
+  for (uint32_t p = 0; p < kProducers; p++) {
+    EXPECT_EQ(kItemsPerProducer, next[p]);
+  }
+}
+
+}  // namespace
+}  // namespace base
+}  // namespace hippy
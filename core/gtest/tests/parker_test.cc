@@ -0,0 +1,128 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/parker.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+
+#include "gtest.h"
+
+// built with OS_ANDROID the parker waits on a futex, without it on a
+// condition variable, CMakeLists.txt runs these tests on both.
+
+namespace hippy {
+namespace base {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// long enough not to expire on a loaded machine, a lost wakeup still fails
+constexpr int64_t kWakeupTimeoutInMs = 10000;
+
+int64_t MillisecondsSince(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() -
+                                                               start)
+      .count();
+}
+
+TEST(ParkerTest, UnparkBeforeParkLeavesToken) {
+  Parker parker;
+  parker.Unpark();
+  Clock::time_point start = Clock::now();
+  EXPECT_TRUE(parker.Park(-1));
+  EXPECT_LT(MillisecondsSince(start), kWakeupTimeoutInMs);
+  // the token was taken
+  EXPECT_FALSE(parker.Park(0));
+}
+
+TEST(ParkerTest, TokensDoNotAccumulate) {
+  Parker parker;
+  parker.Unpark();
+  parker.Unpark();
+  EXPECT_TRUE(parker.Park(0));
+  EXPECT_FALSE(parker.Park(10));
+}
+
+TEST(ParkerTest, TimesOut) {
+  Parker parker;
+  EXPECT_FALSE(parker.Park(0));
+  Clock::time_point start = Clock::now();
+  EXPECT_FALSE(parker.Park(30));
+  EXPECT_GE(MillisecondsSince(start), 30);
+  // a timeout leaves no state behind, the next wakeup is kept
+  parker.Unpark();
+  EXPECT_TRUE(parker.Park(0));
+}
+
+TEST(ParkerTest, UnparkWakesParkedThread) {
+  Parker parker;
+  std::atomic<bool> parking{false};
+  bool notified = false;
+  std::thread consumer([&] {
+    parking = true;
+    notified = parker.Park(kWakeupTimeoutInMs);
+  });
+  while (!parking) {
+    std::this_thread::yield();
+  }
+  // most of the time the consumer is asleep by now
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  Clock::time_point start = Clock::now();
+  parker.Unpark();
+  consumer.join();
+  EXPECT_TRUE(notified);
+  EXPECT_LT(MillisecondsSince(start), kWakeupTimeoutInMs);
+}
+
+// two threads wake each other in turn, every wakeup either finds the other
+// parked or leaves a token, none is lost.
+TEST(ParkerTest, PingPong) {
+  constexpr uint32_t kRounds = 20000;
+  Parker ping;
+  Parker pong;
+  // a lost wakeup times out, both threads stop then
+  std::atomic<bool> lost{false};
+  std::thread other([&] {
+    for (uint32_t i = 0; i < kRounds && !lost; i++) {
+      if (!pong.Park(kWakeupTimeoutInMs)) {
+        lost = true;
+      }
+      ping.Unpark();
+    }
+  });
+  for (uint32_t i = 0; i < kRounds && !lost; i++) {
+    pong.Unpark();
+    if (!ping.Park(kWakeupTimeoutInMs)) {
+      lost = true;
+    }
+  }
+  other.join();
+  EXPECT_FALSE(lost);
+}
+
+}  // namespace
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,203 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/task_runner.h"
+
+#include <stdint.h>
+
+#include <functional>
+#include <future>  // NOLINT(build/c++11)
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "core/base/base_time.h"
+#include "core/task/common_task.h"
+#include "gtest.h"
+
+namespace hippy {
+namespace base {
+namespace {
+
+std::shared_ptr<CommonTask> MakeTask(std::function<void()> func) {
+  std::shared_ptr<CommonTask> task = std::make_shared<CommonTask>();
+  task->func_ = std::move(func);
+  return task;
+}
+
+// runs a task after all the others posted before it from this thread, and
+// all delayed ones due before, and waits for it.
+void Drain(TaskRunner* runner, uint64_t delay_in_ms = 0) {
+  std::promise<void> done;
+  std::shared_ptr<CommonTask> task = MakeTask([&done] { done.set_value(); });
+  if (delay_in_ms > 0) {
+    runner->PostDelayedTask(task, delay_in_ms);
+  } else {
+    runner->PostTask(task);
+  }
+  done.get_future().wait();
+}
+
+// tasks of one thread run in the order it posted them, all of them run.
+TEST(TaskRunnerTest, RunsTasksPostedFromManyThreads) {
+  constexpr uint32_t kPosters = 4;
+  constexpr uint32_t kTasksPerPoster = 2000;
+  TaskRunner runner;
+  runner.Start();
+
+  // only touched by the runner thread
+  std::vector<uint32_t> next(kPosters, 0);
+  uint32_t out_of_order = 0;
+  std::vector<std::thread> posters;
+  for (uint32_t p = 0; p < kPosters; p++) {
+    posters.emplace_back([&, p] {
+      for (uint32_t i = 0; i < kTasksPerPoster; i++) {
+        runner.PostTask(MakeTask([&, p, i] {
+          if (next[p] != i) {
+            out_of_order++;
+          }
+          next[p] = i + 1;
+        }));
+      }
+    });
+  }
+  for (std::thread& poster : posters) {
+    poster.join();
+  }
+  Drain(&runner);
+
+  EXPECT_EQ(0u, out_of_order);
+  for (uint32_t p = 0; p < kPosters; p++) {
+    EXPECT_EQ(kTasksPerPoster, next[p]);
+  }
+  runner.Terminate();
+}
+
+// delayed tasks run in deadline order, not before it, and after the tasks
+// posted without delay.
+TEST(TaskRunnerTest, RunsDelayedTasksInDeadlineOrder) {
+  TaskRunner runner;
+  runner.Start();
+
+  std::vector<uint64_t> order;
+  std::vector<bool> early;
+  const uint64_t delays[] = {60, 20, 40};
+  for (uint64_t delay : delays) {
+    uint64_t deadline = MonotonicallyIncreasingTime() + delay;
+    runner.PostDelayedTask(MakeTask([&, delay, deadline] {
+                             order.push_back(delay);
+                             early.push_back(MonotonicallyIncreasingTime() <
+                                             deadline);
+                           }),
+                           delay);
+  }
+  runner.PostTask(MakeTask([&] { order.push_back(0); }));
+  Drain(&runner, 80);
+
+  EXPECT_EQ((std::vector<uint64_t>{0, 20, 40, 60}), order);
+  EXPECT_EQ((std::vector<bool>{false, false, false}), early);
+  runner.Terminate();
+}
+
+// delayed tasks posted and canceled from other threads, in any order
+// relative to each other, canceled ones never run.
+TEST(TaskRunnerTest, CancelsDelayedTasksAcrossThreads) {
+  constexpr uint32_t kTasks = 200;
+  TaskRunner runner;
+  runner.Start();
+
+  std::vector<uint32_t> ran(kTasks, 0);
+  std::vector<std::shared_ptr<CommonTask>> tasks;
+  for (uint32_t i = 0; i < kTasks; i++) {
+    tasks.push_back(MakeTask([&ran, i] { ran[i]++; }));
+  }
+  std::thread poster([&] {
+    for (uint32_t i = 0; i < kTasks; i++) {
+      runner.PostDelayedTask(tasks[i], 50 + i % 20);
+    }
+  });
+  std::thread canceler([&] {
+    for (uint32_t i = 0; i < kTasks; i += 2) {
+      runner.CancelTask(tasks[i]);
+    }
+  });
+  poster.join();
+  canceler.join();
+  Drain(&runner, 150);
+
+  for (uint32_t i = 0; i < kTasks; i++) {
+    EXPECT_EQ(i % 2 == 0 ? 0u : 1u, ran[i]) << "task " << i;
+  }
+  runner.Terminate();
+}
+
+// a task posting and canceling a delayed task on the runner thread.
+TEST(TaskRunnerTest, CancelsDelayedTaskOnRunnerThread) {
+  TaskRunner runner;
+  runner.Start();
+
+  bool canceled_ran = false;
+  bool kept_ran = false;
+  std::shared_ptr<CommonTask> canceled =
+      MakeTask([&canceled_ran] { canceled_ran = true; });
+  std::shared_ptr<CommonTask> kept = MakeTask([&kept_ran] { kept_ran = true; });
+  runner.PostTask(MakeTask([&] {
+    runner.PostDelayedTask(canceled, 10);
+    runner.PostDelayedTask(kept, 10);
+    runner.CancelTask(canceled);
+  }));
+  Drain(&runner, 50);
+
+  EXPECT_FALSE(canceled_ran);
+  EXPECT_TRUE(kept_ran);
+  // released by the wheel, only this test holds it
+  EXPECT_EQ(1, canceled.use_count());
+  runner.Terminate();
+}
+
+TEST(TaskRunnerTest, TerminateRunsQueuedTasksAndDropsLaterPosts) {
+  TaskRunner runner;
+  runner.Start();
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  uint32_t ran = 0;
+  runner.PostTask(MakeTask([released, &ran] {
+    released.wait();
+    ran++;
+  }));
+  for (uint32_t i = 0; i < 10; i++) {
+    runner.PostTask(MakeTask([&ran] { ran++; }));
+  }
+  std::thread terminator([&runner] { runner.Terminate(); });
+  release.set_value();
+  terminator.join();
+  EXPECT_EQ(11u, ran);
+
+  runner.PostTask(MakeTask([&ran] { ran++; }));
+  EXPECT_EQ(11u, ran);
+}
+
+}  // namespace
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,218 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/timer_wheel.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "gtest.h"
+
+namespace hippy {
+namespace base {
+namespace {
+
+using Tick = TimerWheel::Tick;
+
+// one level of the wheel spans 2^6 ticks, the four levels 2^24
+const Tick kLevelTicks[] = {Tick(1) << 6, Tick(1) << 12, Tick(1) << 18,
+                            Tick(1) << 24};
+
+class TestTask : public Task {
+ public:
+  bool isPriorityTask() override { return false; }
+  void Run() override {}
+};
+
+std::shared_ptr<Task> Add(TimerWheel* wheel, Tick deadline) {
+  std::shared_ptr<Task> task = std::make_shared<TestTask>();
+  wheel->Add(deadline, task);
+  return task;
+}
+
+std::vector<Task::TaskId> Advance(TimerWheel* wheel, Tick now) {
+  std::vector<std::shared_ptr<Task>> expired;
+  wheel->Advance(now, &expired);
+  std::vector<Task::TaskId> ids;
+  for (const auto& task : expired) {
+    ids.push_back(task->id_);
+  }
+  return ids;
+}
+
+TEST(TimerWheelTest, ExpiresInDeadlineOrder) {
+  TimerWheel wheel(100);
+  auto late = Add(&wheel, 170);
+  auto first = Add(&wheel, 110);
+  auto second = Add(&wheel, 110);
+  auto past = Add(&wheel, 90);
+  EXPECT_EQ(4u, wheel.Size());
+  EXPECT_EQ(99u, wheel.NextTick());
+
+  EXPECT_EQ(std::vector<Task::TaskId>({past->id_}), Advance(&wheel, 109));
+  // tasks of the same tick expire in the order they were added
+  EXPECT_EQ(std::vector<Task::TaskId>({first->id_, second->id_, late->id_}),
+            Advance(&wheel, 200));
+  EXPECT_EQ(0u, wheel.Size());
+  EXPECT_EQ(TimerWheel::kNoTick, wheel.NextTick());
+}
+
+TEST(TimerWheelTest, ExpiresAtCascadeBoundaries) {
+  // from an aligned and an unaligned start, timers just before, at and just
+  // after the tick a level wraps expire on their tick and not one earlier
+  for (Tick start : {Tick(0), Tick(12345)}) {
+    for (Tick span : kLevelTicks) {
+      for (Tick offset : {span - 1, span, span + 1}) {
+        TimerWheel wheel(start);
+        Tick deadline = start - start % span + offset;
+        if (deadline <= start) {
+          deadline += span;
+        }
+        auto task = Add(&wheel, deadline);
+        EXPECT_LE(wheel.NextTick(), deadline);
+        EXPECT_TRUE(Advance(&wheel, deadline - 1).empty())
+            << "start " << start << " deadline " << deadline;
+        EXPECT_EQ(std::vector<Task::TaskId>({task->id_}),
+                  Advance(&wheel, deadline))
+            << "start " << start << " deadline " << deadline;
+        EXPECT_EQ(0u, wheel.Size());
+      }
+    }
+  }
+}
+
+TEST(TimerWheelTest, OverflowMigratesIntoWheel) {
+  const Tick start = 5;
+  TimerWheel wheel(start);
+  auto near = Add(&wheel, start + kLevelTicks[3] + 100);
+  auto far = Add(&wheel, start + 2 * kLevelTicks[3] + 7);
+  EXPECT_EQ(2u, wheel.Size());
+
+  // the overflow list moves into the wheel when the top level wraps
+  EXPECT_EQ(kLevelTicks[3], wheel.NextTick());
+  EXPECT_TRUE(Advance(&wheel, kLevelTicks[3]).empty());
+  EXPECT_EQ(2u, wheel.Size());
+  EXPECT_LE(wheel.NextTick(), start + kLevelTicks[3] + 100);
+
+  EXPECT_TRUE(Advance(&wheel, start + kLevelTicks[3] + 99).empty());
+  EXPECT_EQ(std::vector<Task::TaskId>({near->id_}),
+            Advance(&wheel, start + kLevelTicks[3] + 100));
+  EXPECT_TRUE(Advance(&wheel, start + 2 * kLevelTicks[3] + 6).empty());
+  EXPECT_EQ(std::vector<Task::TaskId>({far->id_}),
+            Advance(&wheel, start + 2 * kLevelTicks[3] + 7));
+  EXPECT_EQ(TimerWheel::kNoTick, wheel.NextTick());
+}
+
+TEST(TimerWheelTest, CancelsAfterCascade) {
+  TimerWheel wheel(0);
+  auto task = Add(&wheel, kLevelTicks[1] + 10);
+  auto other = Add(&wheel, kLevelTicks[1] + 20);
+
+  // both timers move from level 2 to level 0 at the wrap
+  EXPECT_TRUE(Advance(&wheel, kLevelTicks[1]).empty());
+  EXPECT_TRUE(wheel.Cancel(task->id_));
+  EXPECT_FALSE(wheel.Cancel(task->id_));
+  EXPECT_EQ(1u, wheel.Size());
+  EXPECT_EQ(kLevelTicks[1] + 20, wheel.NextTick());
+
+  EXPECT_EQ(std::vector<Task::TaskId>({other->id_}),
+            Advance(&wheel, kLevelTicks[1] + 30));
+  EXPECT_EQ(0u, wheel.Size());
+  EXPECT_EQ(TimerWheel::kNoTick, wheel.NextTick());
+}
+
+TEST(TimerWheelTest, CancelOfFiredTimerFails) {
+  TimerWheel wheel(0);
+  auto task = Add(&wheel, 10);
+  auto other = Add(&wheel, 20);
+  EXPECT_EQ(std::vector<Task::TaskId>({task->id_}), Advance(&wheel, 10));
+  EXPECT_FALSE(wheel.Cancel(task->id_));
+  EXPECT_EQ(1u, wheel.Size());
+  EXPECT_EQ(std::vector<Task::TaskId>({other->id_}), Advance(&wheel, 20));
+}
+
+// random adds, cancels and advances, from near to beyond the overflow, are
+// checked against a map of deadlines
+TEST(TimerWheelTest, MatchesReferenceModel) {
+  std::mt19937_64 random(42);
+  for (int round = 0; round < 8; ++round) {
+    Tick now = random() % (Tick(1) << 30);
+    TimerWheel wheel(now);
+    std::map<Task::TaskId, Tick> deadlines;
+    for (int step = 0; step < 20000; ++step) {
+      uint32_t op = random() % 10;
+      if (op < 4) {
+        Tick deadline;
+        uint32_t range = random() % 10;
+        if (range < 5) {
+          deadline = now + random() % 100;
+        } else if (range < 8) {
+          deadline = now + random() % 100000;
+        } else if (range < 9) {
+          deadline = now + random() % (Tick(1) << 26);
+        } else {
+          deadline = now - random() % 10;
+        }
+        auto task = Add(&wheel, deadline);
+        deadlines[task->id_] = std::max(deadline, now);
+      } else if (op < 6 && !deadlines.empty()) {
+        auto it = deadlines.begin();
+        std::advance(it, random() % deadlines.size());
+        ASSERT_TRUE(wheel.Cancel(it->first));
+        deadlines.erase(it);
+      } else {
+        now += random() % 4 == 0 ? random() % 5000000 : random() % 50;
+        std::vector<Task::TaskId> expired = Advance(&wheel, now);
+        std::set<Task::TaskId> expired_set(expired.begin(), expired.end());
+        ASSERT_EQ(expired.size(), expired_set.size());
+        Tick next = TimerWheel::kNoTick;
+        for (auto it = deadlines.begin(); it != deadlines.end();) {
+          bool due = it->second <= now;
+          ASSERT_EQ(due, expired_set.count(it->first) > 0)
+              << "deadline " << it->second << " now " << now;
+          if (due) {
+            it = deadlines.erase(it);
+          } else {
+            next = std::min(next, it->second);
+            ++it;
+          }
+        }
+        ASSERT_EQ(deadlines.size(), wheel.Size());
+        if (deadlines.empty()) {
+          ASSERT_EQ(TimerWheel::kNoTick, wheel.NextTick());
+        } else {
+          ASSERT_LE(wheel.NextTick(), next);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,201 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/task/worker_task_runner.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>              // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <functional>
+#include <future>  // NOLINT(build/c++11)
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <set>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "gtest.h"
+
+namespace {
+
+// long enough not to expire on a loaded machine, a stranded task still fails
+constexpr std::chrono::seconds kWaitTimeout(10);
+
+std::unique_ptr<CommonTask> MakeTask(std::function<void()> func) {
+  std::unique_ptr<CommonTask> task = std::make_unique<CommonTask>();
+  task->func_ = std::move(func);
+  return task;
+}
+
+bool IsReady(std::future<void>* future) {
+  return future->wait_for(kWaitTimeout) == std::future_status::ready;
+}
+
+// the worker running the poster stays busy until its continuations are
+// done, so the other workers must have stolen all of them.
+TEST(WorkerTaskRunnerTest, OtherWorkersStealContinuations) {
+  constexpr uint32_t kContinuations = 64;
+  WorkerTaskRunner runner(4);
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  uint32_t done = 0;
+  std::set<std::thread::id> thieves;
+  std::thread::id poster_id;
+  bool all_done = false;
+  std::promise<void> finished;
+  runner.PostTask(MakeTask([&] {
+    poster_id = std::this_thread::get_id();
+    for (uint32_t i = 0; i < kContinuations; i++) {
+      runner.PostTask(MakeTask([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        thieves.insert(std::this_thread::get_id());
+        done++;
+        cv.notify_all();
+      }));
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    all_done = cv.wait_for(lock, kWaitTimeout,
+                           [&] { return done == kContinuations; });
+    finished.set_value();
+  }));
+  std::future<void> future = finished.get_future();
+  ASSERT_TRUE(IsReady(&future));
+
+  EXPECT_TRUE(all_done);
+  EXPECT_EQ(0u, thieves.count(poster_id));
+  EXPECT_GE(thieves.size(), 1u);
+  runner.Terminate();
+}
+
+// continuations posted while the other workers go to sleep or wake up, each
+// round must finish, a task left in a deque with all workers asleep would
+// hang it.
+TEST(WorkerTaskRunnerTest, NoTaskStrandedWhileWorkersSleep) {
+  constexpr uint32_t kRounds = 2000;
+  constexpr uint32_t kFanOut = 8;
+  constexpr uint32_t kDepth = 8;
+  WorkerTaskRunner runner(4);
+
+  for (uint32_t round = 0; round < kRounds; round++) {
+    std::promise<void> fanned_out;
+    std::promise<void> chained;
+    std::atomic<uint32_t> remaining{kFanOut};
+    std::function<void(uint32_t)> chain = [&](uint32_t depth) {
+      if (depth == kDepth) {
+        chained.set_value();
+        return;
+      }
+      runner.PostTask(MakeTask([&chain, depth] { chain(depth + 1); }));
+    };
+    runner.PostTask(MakeTask([&] {
+      for (uint32_t i = 0; i < kFanOut; i++) {
+        runner.PostTask(MakeTask([&] {
+          if (remaining.fetch_sub(1) == 1) {
+            fanned_out.set_value();
+          }
+        }));
+      }
+      chain(0);
+    }));
+    std::future<void> fanned_out_future = fanned_out.get_future();
+    std::future<void> chained_future = chained.get_future();
+    ASSERT_TRUE(IsReady(&fanned_out_future)) << "round " << round;
+    ASSERT_TRUE(IsReady(&chained_future)) << "round " << round;
+  }
+  runner.Terminate();
+}
+
+// tasks in a deque when Terminate is called still run, the ones they post
+// after it are dropped.
+TEST(WorkerTaskRunnerTest, TerminateRunsQueuedLocalTasks) {
+  constexpr uint32_t kQueued = 100;
+  WorkerTaskRunner runner(1);
+
+  std::atomic<uint32_t> ran{0};
+  std::atomic<uint32_t> posted_after_terminate{0};
+  std::shared_ptr<int> token = std::make_shared<int>(0);
+  std::promise<void> queued;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  runner.PostTask(MakeTask([&, released] {
+    for (uint32_t i = 0; i < kQueued; i++) {
+      runner.PostTask(MakeTask([&, token] {
+        ran++;
+        runner.PostTask(MakeTask([&] { posted_after_terminate++; }));
+      }));
+    }
+    queued.set_value();
+    released.wait();
+  }));
+  queued.get_future().wait();
+
+  std::thread terminator([&runner] { runner.Terminate(); });
+  // Terminate marks the runner terminated before it joins the worker
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  release.set_value();
+  terminator.join();
+
+  EXPECT_EQ(kQueued, ran.load());
+  EXPECT_EQ(0u, posted_after_terminate.load());
+  // all the queued tasks were released
+  EXPECT_EQ(1, token.use_count());
+}
+
+// a single worker keeps feeding its own deque, a task posted from outside
+// still runs within a bounded number of its tasks.
+TEST(WorkerTaskRunnerTest, InjectedTaskNotStarvedByLocalTasks) {
+  WorkerTaskRunner runner(1);
+
+  std::atomic<bool> stop{false};
+  std::atomic<uint32_t> local_runs{0};
+  std::function<void()> spin = [&] {
+    local_runs++;
+    if (!stop) {
+      runner.PostTask(MakeTask(spin));
+    }
+  };
+  runner.PostTask(MakeTask(spin));
+  while (local_runs.load() == 0) {
+    std::this_thread::yield();
+  }
+
+  uint32_t runs_before = local_runs.load();
+  uint32_t runs_at_injected = 0;
+  std::promise<void> injected;
+  runner.PostTask(MakeTask([&] {
+    runs_at_injected = local_runs.load();
+    stop = true;
+    injected.set_value();
+  }));
+  std::future<void> future = injected.get_future();
+  bool ran = IsReady(&future);
+  stop = true;
+  runner.Terminate();
+
+  ASSERT_TRUE(ran);
+  EXPECT_LT(runs_at_injected - runs_before, 1000u);
+}
+
+}  // namespace
@@ -0,0 +1,91 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+#include "core/base/macros.h"
+
+namespace hippy {
+namespace base {
+
+// Unbounded multi-producer/single-consumer queue (Vyukov's intrusive node
+// queue). Push is wait-free and may be called from any thread, Pop must only
+// be called from the consumer thread. A Pop racing with a Push that has not
+// linked its node yet returns false, the producer wakes the consumer after
+// linking, so the item is never lost.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(new Node()) {
+    tail_ = head_.load(std::memory_order_relaxed);
+  }
+  ~MpscQueue() {
+    T value;
+    while (Pop(&value)) {
+    }
+    delete tail_;
+  }
+  DISALLOW_COPY_AND_ASSIGN(MpscQueue);
+
+  void Push(T value) {
+    Node* node = new Node(std::move(value));
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // consumer only
+  bool Pop(T* value) {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+    *value = std::move(next->value);
+    // next becomes the new stub, its value has been moved out
+    tail_ = next;
+    delete tail;
+    return true;
+  }
+
+  // consumer only
+  bool Empty() const {
+    return tail_->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  struct Node {
+    Node() : next(nullptr) {}
+    explicit Node(T&& v) : next(nullptr), value(std::move(v)) {}
+    std::atomic<Node*> next;
+    T value;
+  };
+
+  // producers and the consumer write different ends, keep them apart
+  alignas(64) std::atomic<Node*> head_;
+  alignas(64) Node* tail_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,63 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <mutex>               // NOLINT(build/c++11)
+
+#include "core/base/macros.h"
+
+namespace hippy {
+namespace base {
+
+// Parks one consumer thread until another thread unparks it, it waits on a
+// futex on Android and on a condition variable elsewhere. Unpark only costs
+// an atomic exchange while the consumer is running. A wakeup is kept as a
+// token if the consumer is not parked yet, the next Park returns at once.
+class Parker {
+ public:
+  Parker();
+  ~Parker() = default;
+  DISALLOW_COPY_AND_ASSIGN(Parker);
+
+  // consumer only, timeout_in_ms < 0 waits until unparked.
+  // returns false on timeout.
+  bool Park(int64_t timeout_in_ms);
+  // any thread
+  void Unpark();
+
+ private:
+  enum State : int32_t { kParked = -1, kEmpty = 0, kNotified = 1 };
+
+  std::atomic<int32_t> state_;
+#ifndef OS_ANDROID
+  std::mutex mutex_;
+  std::condition_variable cv_;
+#endif
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -24,6 +24,8 @@
 
 #include <stdint.h>
 
+#include <atomic>
+
 namespace hippy {
 namespace base {
 
@@ -37,7 +39,8 @@ class Task {
   virtual void Run() = 0;
 
   TaskId id_;
-  bool canceled_ = false;
+  // set from any thread, read by the runner without a lock
+  std::atomic<bool> canceled_{false};
 };
 
 }  // namespace base
@@ -24,19 +24,20 @@
 
 #include <stdint.h>
 
-#include <condition_variable>  // NOLINT(build/c++11)
+#include <atomic>
 #include <memory>
-#include <mutex>  // NOLINT(build/c++11)
-#include <queue>
 #include <utility>
 #include <vector>
 
+#include "core/base/mpsc_queue.h"
+#include "core/base/parker.h"
+#include "core/base/task.h"
 #include "core/base/thread.h"
+#include "core/base/timer_wheel.h"
 
 namespace hippy {
 namespace base {
 
-class Task;
 class TaskRunner : public Thread {
  public:
   using DelayedTimeInMs = uint64_t;
@@ -49,30 +50,30 @@ class TaskRunner : public Thread {
   void PostTask(std::shared_ptr<Task> task);
   void PostDelayedTask(std::shared_ptr<Task> task,
                        DelayedTimeInMs delay_in_milliseconds);
+  // a canceled delayed task is removed from the timer wheel and released
+  // at once on the runner thread, or on its next wakeup from other threads
   void CancelTask(const std::shared_ptr<Task>& task);
 
  protected:
-  void PostTaskNoLock(std::shared_ptr<Task> task);
-  std::shared_ptr<Task> popTaskFromDelayedQueueNoLock(DelayedTimeInMs now);
+  using DelayedEntry = std::pair<DelayedTimeInMs, std::shared_ptr<Task>>;
+
+  // the methods below run on the runner thread only
+  void MoveIncomingDelayedTasks();
   std::shared_ptr<Task> GetNext();
 
  protected:
-  bool is_terminated_;
-  std::queue<std::shared_ptr<Task>> task_queue_;
-
-  using DelayedEntry = std::pair<DelayedTimeInMs, std::shared_ptr<Task>>;
-  struct DelayedEntryCompare {
-    bool operator()(const DelayedEntry& left, const DelayedEntry& right) const {
-      return left.first > right.first;
-    }
-  };
-  std::priority_queue<DelayedEntry,
-                      std::vector<DelayedEntry>,
-                      DelayedEntryCompare>
-      delayed_task_queue_;
+  std::atomic<bool> is_terminated_;
+  // posted from any thread without a lock, see MpscQueue
+  MpscQueue<std::shared_ptr<Task>> task_queue_;
+  // delayed tasks and cancellations posted from other threads, applied to
+  // timer_wheel_ by the runner thread, so the wheel itself is never shared
+  MpscQueue<DelayedEntry> incoming_delayed_queue_;
+  MpscQueue<Task::TaskId> incoming_canceled_queue_;
+  TimerWheel timer_wheel_;
+  // reused by GetNext for the tasks expired in one wakeup
+  std::vector<std::shared_ptr<Task>> expired_tasks_;
 
-  std::mutex mutex_;
-  std::condition_variable cv_;
+  Parker parker_;
 };
 
 }  // namespace base
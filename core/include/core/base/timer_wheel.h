@@ -0,0 +1,98 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "core/base/macros.h"
+#include "core/base/task.h"
+
+namespace hippy {
+namespace base {
+
+// Hierarchical timing wheel of delayed tasks, with one millisecond ticks.
+// Four levels of 64 slots cover 2^24 ms (about 4.6 hours) and a timer further
+// away waits in an overflow list. A timer is inserted into the slot of its
+// deadline in O(1) and moves to the level below when its slot comes around,
+// so all tasks due in the same tick expire together. Cancel unlinks and frees
+// a timer in O(1). Not thread safe, owned by the TaskRunner thread.
+class TimerWheel {
+ public:
+  using Tick = uint64_t;
+  static const Tick kNoTick;
+
+  explicit TimerWheel(Tick now);
+  ~TimerWheel();
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+
+  void Add(Tick deadline, std::shared_ptr<Task> task);
+  // drops the last timer added for the task, returns false if there is none
+  bool Cancel(Task::TaskId task_id);
+  // appends the tasks due up to now to expired, in deadline order
+  void Advance(Tick now, std::vector<std::shared_ptr<Task>>* expired);
+  // first tick that has timers to expire or cascade, kNoTick if empty.
+  // the wheel may have nothing due then, the caller just advances again.
+  Tick NextTick() const;
+  inline size_t Size() const { return count_; }
+
+ private:
+  static const uint32_t kLevelBits = 6;
+  static const uint32_t kSlotCount = 1 << kLevelBits;
+  static const uint32_t kSlotMask = kSlotCount - 1;
+  static const uint32_t kLevelCount = 4;
+  // slot index of the overflow list, and of timers added for ticks already
+  // processed, which expire on the next Advance
+  static const uint32_t kOverflowSlot = kLevelCount * kSlotCount;
+  static const uint32_t kDueSlot = kOverflowSlot + 1;
+
+  struct Node {
+    Node* prev;
+    Node* next;
+    Tick deadline;
+    uint32_t slot;
+    std::shared_ptr<Task> task;
+  };
+
+  void Link(Node* node);
+  void Unlink(Node* node);
+  void Cascade(uint32_t slot);
+  void ExpireTick(std::vector<std::shared_ptr<Task>>* expired);
+  void ExpireSlot(uint32_t slot, std::vector<std::shared_ptr<Task>>* expired);
+
+  // next tick to expire, all ticks before have been processed
+  Tick current_;
+  // circular list heads, kLevelCount * kSlotCount slots, the overflow list and
+  // the due list
+  Node slots_[kLevelCount * kSlotCount + 2];
+  // bit i set if slot i of the level is not empty
+  uint64_t occupied_[kLevelCount];
+  size_t count_;
+  std::unordered_map<Task::TaskId, Node*> task_map_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -62,7 +62,7 @@ class Engine {
   }
 
  private:
-  void SetupThreads();
+  void SetupThreads(uint32_t worker_pool_size);
   void CreateVM(const std::shared_ptr<VMInitParam>& param);
 
  private:
@@ -174,7 +174,10 @@ class Ctx {
       const std::shared_ptr<JSValueWrapper>& wrapper) = 0;
 };
 
-struct VMInitParam {};
+struct VMInitParam {
+  // threads of the engine's WorkerTaskRunner, 0 uses the engine default
+  uint32_t worker_pool_size = 0;
+};
 
 class VM {
  public:
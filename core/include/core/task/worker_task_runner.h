@@ -24,9 +24,12 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <condition_variable>  // NOLINT(build/c++11)
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT(build/c++11)
 #include <queue>
 #include <vector>
 
@@ -35,42 +38,68 @@
 #include "core/base/thread.h"
 #include "core/task/common_task.h"
 
+// Work-stealing pool. Tasks posted from outside the pool go to a shared
+// priority queue; tasks posted by a running task with the default priority go
+// to the deque of its worker, which pops them LIFO while idle workers steal
+// them FIFO. Now and then a worker takes the shared queue first, so it can't
+// be starved by a worker busy with its own deque.
 class WorkerTaskRunner {
  public:
+  static const uint32_t kDefaultTaskPriority;
+  static const uint32_t kHighPriorityTaskPriority;
+  static const uint32_t kLowPriorityTaskPriority;
+
   explicit WorkerTaskRunner(uint32_t pool_size);
   ~WorkerTaskRunner() = default;
 
   void PostTask(std::unique_ptr<CommonTask> task,
                 uint32_t priority = WorkerTaskRunner::kDefaultTaskPriority);
-  std::unique_ptr<CommonTask> GetNext();
   void Terminate();
+  inline uint32_t GetPoolSize() { return pool_size_; }
 
  private:
   class WorkerThread : public hippy::base::Thread {
    public:
-    explicit WorkerThread(WorkerTaskRunner*);
+    WorkerThread(WorkerTaskRunner*, uint32_t index);
     ~WorkerThread();
     void Run();
 
    private:
     WorkerTaskRunner* runner_;
+    uint32_t index_;
 
     DISALLOW_COPY_AND_ASSIGN(WorkerThread);
   };
 
-  static const uint32_t kDefaultTaskPriority;
-  static const uint32_t kHighPriorityTaskPriority;
-  static const uint32_t kLowPriorityTaskPriority;
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::unique_ptr<CommonTask>> tasks;
+    // GetNext calls of the owner, only touched by it
+    uint32_t next_count = 0;
+  };
+
+  std::unique_ptr<CommonTask> GetNext(uint32_t index);
+  std::unique_ptr<CommonTask> PopLocal(uint32_t index);
+  // the caller holds mutex_
+  std::unique_ptr<CommonTask> PopInjected();
+  std::unique_ptr<CommonTask> Steal(uint32_t index);
+
   using Entry = std::pair<uint32_t, std::unique_ptr<CommonTask>>;
   struct EntryCompare {
     bool operator()(const Entry& left, const Entry& right) const {
       return left.first > right.first;
     }
   };
+  // injection queue, guarded by mutex_
   std::priority_queue<Entry, std::vector<Entry>, EntryCompare> task_queue_;
   std::condition_variable cv_;
   std::mutex mutex_;
   uint32_t pool_size_;
-  bool terminated_ = false;
+  // written under mutex_, read without it by PostTask to worker queues
+  std::atomic<bool> terminated_{false};
+  // tasks in all worker queues, and workers waiting on cv_
+  std::atomic<uint32_t> local_task_count_{0};
+  std::atomic<uint32_t> sleeping_count_{0};
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
   std::vector<std::unique_ptr<WorkerThread>> thread_pool_;
 };
@@ -0,0 +1,121 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/parker.h"
+
+#ifdef OS_ANDROID
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>  // NOLINT(build/c++11)
+
+namespace hippy {
+namespace base {
+
+#ifdef OS_ANDROID
+static void FutexWait(std::atomic<int32_t>* state,
+                      int32_t expected,
+                      int64_t timeout_in_ns) {
+  struct timespec timeout;
+  struct timespec* timeout_ptr = nullptr;
+  if (timeout_in_ns >= 0) {
+    timeout.tv_sec = timeout_in_ns / 1000000000;
+    timeout.tv_nsec = timeout_in_ns % 1000000000;
+    timeout_ptr = &timeout;
+  }
+  // returns at once if state is not expected any more
+  syscall(SYS_futex, reinterpret_cast<int32_t*>(state), FUTEX_WAIT_PRIVATE,
+          expected, timeout_ptr, nullptr, 0);
+}
+
+static void FutexWake(std::atomic<int32_t>* state) {
+  syscall(SYS_futex, reinterpret_cast<int32_t*>(state), FUTEX_WAKE_PRIVATE, 1,
+          nullptr, nullptr, 0);
+}
+#endif
+
+Parker::Parker() : state_(kEmpty) {}
+
+bool Parker::Park(int64_t timeout_in_ms) {
+  // kNotified -> kEmpty takes the token, kEmpty -> kParked goes to sleep
+  if (state_.fetch_sub(1, std::memory_order_acq_rel) == kNotified) {
+    return true;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_in_ms);
+#ifdef OS_ANDROID
+  for (;;) {
+    int64_t wait_in_ns = -1;
+    if (timeout_in_ms >= 0) {
+      // not rounded to milliseconds, that would wake up before the deadline
+      auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          deadline - std::chrono::steady_clock::now());
+      if (remaining.count() <= 0) {
+        break;
+      }
+      wait_in_ns = remaining.count();
+    }
+    FutexWait(&state_, kParked, wait_in_ns);
+    int32_t expected = kNotified;
+    if (state_.compare_exchange_strong(expected, kEmpty,
+                                       std::memory_order_acq_rel)) {
+      return true;
+    }
+    // spurious wakeup or interrupted
+  }
+#else
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto notified = [this] {
+      return state_.load(std::memory_order_acquire) == kNotified;
+    };
+    if (timeout_in_ms < 0) {
+      cv_.wait(lock, notified);
+    } else {
+      cv_.wait_until(lock, deadline, notified);
+    }
+  }
+#endif
+  // notified, or timed out and racing with an Unpark, take its token too
+  return state_.exchange(kEmpty, std::memory_order_acq_rel) == kNotified;
+}
+
+void Parker::Unpark() {
+  if (state_.exchange(kNotified, std::memory_order_acq_rel) != kParked) {
+    return;
+  }
+#ifdef OS_ANDROID
+  FutexWake(&state_);
+#else
+  // the consumer checks state under the mutex before it waits,
+  // taking the mutex here makes sure it's waiting or sees kNotified
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  cv_.notify_one();
+#endif
+}
+
+}  // namespace base
+}  // namespace hippy
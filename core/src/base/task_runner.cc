@@ -35,7 +35,9 @@
 namespace hippy {
 namespace base {
 
-TaskRunner::TaskRunner() : Thread(Options("Task Runner")) {
+TaskRunner::TaskRunner()
+    : Thread(Options("Task Runner")),
+      timer_wheel_(MonotonicallyIncreasingTime()) {
   is_terminated_ = false;
 }
 
@@ -51,33 +53,22 @@ void TaskRunner::Run() {
     }
     // TDF_BASE_DLOG(INFO) <<  "run task, id = %d", task->id_);
 
-    bool is_cancel;
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      is_cancel = task->canceled_;
-    }
-    if (!is_cancel) {
+    if (!task->canceled_) {
       task->Run();
     }
   }
 }
 
 void TaskRunner::Terminate() {
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    TDF_BASE_DLOG(INFO)
-        << "TaskRunner::Terminate task_queue_ size = " << task_queue_.size();
-    if (is_terminated_) {
-      TDF_BASE_DLOG(INFO) << "TaskRunner has been terminated";
-      return;
-    }
-    is_terminated_ = true;
-    if (this->Id() == hippy::base::ThreadId::GetCurrent()) {
-      TDF_BASE_DLOG(ERROR) << "terminate in task";
-      return;
-    }
+  if (is_terminated_.exchange(true)) {
+    TDF_BASE_DLOG(INFO) << "TaskRunner has been terminated";
+    return;
   }
-  cv_.notify_one();
+  if (this->Id() == hippy::base::ThreadId::GetCurrent()) {
+    TDF_BASE_DLOG(ERROR) << "terminate in task";
+    return;
+  }
+  parker_.Unpark();
   TDF_BASE_DLOG(INFO) << "TaskRunner Terminate join begin";
   Join();
   TDF_BASE_DLOG(INFO) << "TaskRunner Terminate join end";
@@ -85,59 +76,65 @@ void TaskRunner::Terminate() {
 
 void TaskRunner::PostTask(std::shared_ptr<Task> task) {
   TDF_BASE_DLOG(INFO) << "TaskRunner::PostTask task id = " << task->id_;
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  PostTaskNoLock(std::move(task));
+  if (is_terminated_) {
+    return;
+  }
 
-  cv_.notify_one();
+  task_queue_.Push(std::move(task));
+  parker_.Unpark();
 }
 
 void TaskRunner::PostDelayedTask(
     std::shared_ptr<Task> task,
     TaskRunner::DelayedTimeInMs delay_in_milliseconds) {
-  std::lock_guard<std::mutex> lock(mutex_);
-
   if (is_terminated_) {
     return;
   }
 
   DelayedTimeInMs deadline = MonotonicallyIncreasingTime() + delay_in_milliseconds;
-  delayed_task_queue_.push(std::make_pair(deadline, std::move(task)));
-
-  cv_.notify_one();
+  incoming_delayed_queue_.Push(std::make_pair(deadline, std::move(task)));
+  parker_.Unpark();
 }
 
 void TaskRunner::CancelTask(const std::shared_ptr<Task>& task) {
-  std::lock_guard<std::mutex> lock(mutex_);
-
   if (!task) {
     return;
   }
   task->canceled_ = true;
+  if (this->Id() == hippy::base::ThreadId::GetCurrent()) {
+    // the task may have been posted by the running task
+    MoveIncomingDelayedTasks();
+    timer_wheel_.Cancel(task->id_);
+  } else {
+    incoming_canceled_queue_.Push(task->id_);
+  }
 }
 
-void TaskRunner::PostTaskNoLock(std::shared_ptr<Task> task) {
-  if (is_terminated_) {
-    return;
+void TaskRunner::MoveIncomingDelayedTasks() {
+  DelayedEntry entry;
+  while (incoming_delayed_queue_.Pop(&entry)) {
+    timer_wheel_.Add(entry.first, std::move(entry.second));
+  }
+  Task::TaskId task_id;
+  while (incoming_canceled_queue_.Pop(&task_id)) {
+    timer_wheel_.Cancel(task_id);
   }
-
-  task_queue_.push(std::move(task));
 }
 
 std::shared_ptr<Task> TaskRunner::GetNext() {
-  std::unique_lock<std::mutex> lock(mutex_);
-
   for (;;) {
+    MoveIncomingDelayedTasks();
     DelayedTimeInMs now = MonotonicallyIncreasingTime();
-    std::shared_ptr<Task> task = popTaskFromDelayedQueueNoLock(now);
-    while (task) {
-      PostTaskNoLock(std::move(task));
-      task = popTaskFromDelayedQueueNoLock(now);
+    // due tasks queue up behind the tasks posted before, all the timers of a
+    // tick expire in one wakeup
+    timer_wheel_.Advance(now, &expired_tasks_);
+    for (std::shared_ptr<Task>& task : expired_tasks_) {
+      task_queue_.Push(std::move(task));
     }
+    expired_tasks_.clear();
 
-    if (!task_queue_.empty()) {
-      std::shared_ptr<Task> result = std::move(task_queue_.front());
-      task_queue_.pop();
+    std::shared_ptr<Task> result;
+    if (task_queue_.Pop(&result)) {
       return result;
     }
 
@@ -147,33 +144,17 @@ std::shared_ptr<Task> TaskRunner::GetNext() {
       return nullptr;
     }
 
-    if (task_queue_.empty() && !delayed_task_queue_.empty()) {
-      const DelayedEntry& delayed_task = delayed_task_queue_.top();
-      DelayedTimeInMs wait_in_msseconds = delayed_task.first - now;
-      bool notified =
-          cv_.wait_for(lock, std::chrono::milliseconds(wait_in_msseconds)) ==
-          std::cv_status::timeout;
+    // a post after the checks above leaves a token, Park returns at once
+    TimerWheel::Tick next_tick = timer_wheel_.NextTick();
+    if (next_tick != TimerWheel::kNoTick) {
+      DelayedTimeInMs wait_in_msseconds = next_tick > now ? next_tick - now : 0;
+      bool notified = parker_.Park(static_cast<int64_t>(wait_in_msseconds));
       HIPPY_USE(notified);
     } else {
-      cv_.wait(lock);
+      parker_.Park(-1);
     }
   }
 }
 
-std::shared_ptr<Task> TaskRunner::popTaskFromDelayedQueueNoLock(
-    TaskRunner::DelayedTimeInMs now) {
-  if (delayed_task_queue_.empty())
-    return {};
-
-  const DelayedEntry& deadline_and_task = delayed_task_queue_.top();
-  if (deadline_and_task.first > now)
-    return {};
-
-  std::shared_ptr<Task> result =
-      std::move(const_cast<DelayedEntry&>(deadline_and_task).second);
-  delayed_task_queue_.pop();
-  return result;
-}
-
 }  // namespace base
 }  // namespace hippy
@@ -0,0 +1,220 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/timer_wheel.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace hippy {
+namespace base {
+
+namespace {
+
+// bit k of the result is bit (k + n) % 64 of value
+inline uint64_t RotateRight(uint64_t value, uint32_t n) {
+  return n == 0 ? value : (value >> n) | (value << (64 - n));
+}
+
+}  // namespace
+
+const TimerWheel::Tick TimerWheel::kNoTick = UINT64_MAX;
+
+TimerWheel::TimerWheel(Tick now) : current_(now), count_(0) {
+  for (Node& head : slots_) {
+    head.prev = &head;
+    head.next = &head;
+  }
+  std::fill(occupied_, occupied_ + kLevelCount, 0);
+}
+
+TimerWheel::~TimerWheel() {
+  for (Node& head : slots_) {
+    while (head.next != &head) {
+      Node* node = head.next;
+      Unlink(node);
+      delete node;
+    }
+  }
+}
+
+void TimerWheel::Add(Tick deadline, std::shared_ptr<Task> task) {
+  Node* node = new Node();
+  node->deadline = deadline;
+  node->task = std::move(task);
+  task_map_[node->task->id_] = node;
+  Link(node);
+  ++count_;
+}
+
+bool TimerWheel::Cancel(Task::TaskId task_id) {
+  auto it = task_map_.find(task_id);
+  if (it == task_map_.end()) {
+    return false;
+  }
+  Node* node = it->second;
+  task_map_.erase(it);
+  Unlink(node);
+  delete node;
+  --count_;
+  return true;
+}
+
+void TimerWheel::Advance(Tick now,
+                         std::vector<std::shared_ptr<Task>>* expired) {
+  ExpireSlot(kDueSlot, expired);
+  while (current_ <= now) {
+    // ticks without timers are skipped
+    Tick next = NextTick();
+    if (next > now) {
+      current_ = now + 1;
+      return;
+    }
+    current_ = next;
+    ExpireTick(expired);
+  }
+}
+
+TimerWheel::Tick TimerWheel::NextTick() const {
+  if (count_ == 0) {
+    return kNoTick;
+  }
+
+  const Node& due = slots_[kDueSlot];
+  if (due.next != &due) {
+    return current_ - 1;
+  }
+
+  Tick next = kNoTick;
+  // a level 0 timer is due less than kSlotCount ticks after current_
+  if (occupied_[0]) {
+    uint64_t rotated = RotateRight(occupied_[0], current_ & kSlotMask);
+    next = current_ + __builtin_ctzll(rotated);
+  }
+  // timers of upper levels are due no earlier than their slot cascades
+  for (uint32_t level = 1; level < kLevelCount; ++level) {
+    if (!occupied_[level]) {
+      continue;
+    }
+    uint32_t shift = kLevelBits * level;
+    Tick round = (current_ + (Tick(1) << shift) - 1) >> shift;
+    uint64_t rotated = RotateRight(occupied_[level], round & kSlotMask);
+    next = std::min(next, (round + __builtin_ctzll(rotated)) << shift);
+  }
+  const Node& overflow = slots_[kOverflowSlot];
+  if (overflow.next != &overflow) {
+    uint32_t shift = kLevelBits * kLevelCount;
+    Tick round = (current_ + (Tick(1) << shift) - 1) >> shift;
+    next = std::min(next, round << shift);
+  }
+  return next;
+}
+
+void TimerWheel::Link(Node* node) {
+  Tick deadline = node->deadline;
+  Tick delta = deadline - current_;
+  uint32_t slot = deadline < current_ ? kDueSlot : kOverflowSlot;
+  for (uint32_t level = 0; slot == kOverflowSlot && level < kLevelCount;
+       ++level) {
+    uint32_t shift = kLevelBits * level;
+    if (delta < (Tick(1) << (shift + kLevelBits))) {
+      uint32_t index = (deadline >> shift) & kSlotMask;
+      slot = level * kSlotCount + index;
+      occupied_[level] |= uint64_t(1) << index;
+    }
+  }
+
+  // append, timers of the same tick expire in the order they were added
+  Node* head = &slots_[slot];
+  node->slot = slot;
+  node->prev = head->prev;
+  node->next = head;
+  head->prev->next = node;
+  head->prev = node;
+}
+
+void TimerWheel::Unlink(Node* node) {
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+  Node* head = &slots_[node->slot];
+  if (head->next == head && node->slot < kOverflowSlot) {
+    occupied_[node->slot / kSlotCount] &=
+        ~(uint64_t(1) << (node->slot & kSlotMask));
+  }
+}
+
+void TimerWheel::Cascade(uint32_t slot) {
+  Node* head = &slots_[slot];
+  if (head->next == head) {
+    return;
+  }
+  // detach the list first, a timer may be linked back into the same slot
+  Node* first = head->next;
+  Node* last = head->prev;
+  head->prev = head;
+  head->next = head;
+  if (slot < kOverflowSlot) {
+    occupied_[slot / kSlotCount] &= ~(uint64_t(1) << (slot & kSlotMask));
+  }
+  last->next = nullptr;
+  while (first) {
+    Node* node = first;
+    first = first->next;
+    Link(node);
+  }
+}
+
+void TimerWheel::ExpireTick(std::vector<std::shared_ptr<Task>>* expired) {
+  // upper level slots come around when the levels below wrap
+  for (uint32_t level = 1; level < kLevelCount; ++level) {
+    uint32_t shift = kLevelBits * level;
+    if (current_ & ((Tick(1) << shift) - 1)) {
+      break;
+    }
+    Cascade(level * kSlotCount + ((current_ >> shift) & kSlotMask));
+  }
+  if ((current_ & ((Tick(1) << (kLevelBits * kLevelCount)) - 1)) == 0) {
+    Cascade(kOverflowSlot);
+  }
+
+  ExpireSlot(current_ & kSlotMask, expired);
+  ++current_;
+}
+
+void TimerWheel::ExpireSlot(uint32_t slot,
+                            std::vector<std::shared_ptr<Task>>* expired) {
+  Node* head = &slots_[slot];
+  while (head->next != head) {
+    Node* node = head->next;
+    Unlink(node);
+    auto it = task_map_.find(node->task->id_);
+    if (it != task_map_.end() && it->second == node) {
+      task_map_.erase(it);
+    }
+    expired->push_back(std::move(node->task));
+    delete node;
+    --count_;
+  }
+}
+
+}  // namespace base
+}  // namespace hippy
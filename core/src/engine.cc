@@ -33,7 +33,9 @@ constexpr uint32_t Engine::kDefaultWorkerPoolSize = 1;
 
 Engine::Engine(std::unique_ptr<RegisterMap> map, const std::shared_ptr<VMInitParam>& init_param)
     : vm_(nullptr), map_(std::move(map)), scope_cnt_(0) {
-  SetupThreads();
+  SetupThreads(init_param && init_param->worker_pool_size > 0
+                   ? init_param->worker_pool_size
+                   : kDefaultWorkerPoolSize);
 
   std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
   task->callback = [=] { CreateVM(init_param); };
@@ -78,13 +80,12 @@ std::shared_ptr<Scope> Engine::CreateScope(const std::string& name,
   return scope;
 }
 
-void Engine::SetupThreads() {
+void Engine::SetupThreads(uint32_t worker_pool_size) {
   TDF_BASE_DLOG(INFO) << "Engine SetupThreads";
   js_runner_ = std::make_shared<JavaScriptTaskRunner>();
   js_runner_->Start();
 
-  worker_task_runner_ =
-          std::make_shared<WorkerTaskRunner>(kDefaultWorkerPoolSize);
+  worker_task_runner_ = std::make_shared<WorkerTaskRunner>(worker_pool_size);
 }
 
 void Engine::CreateVM(const std::shared_ptr<VMInitParam>& param) {
@@ -163,9 +163,11 @@ void TimerModule::Cancel(TaskId task_id, const std::shared_ptr<Scope>& scope) {
   if (item != task_map_.end()) {
     std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
     std::shared_ptr<JavaScriptTask> task = item->second->task.lock();
+    // the runner drops the task and its callback right away, the map entry
+    // holds the JS function
     if (runner) {
       runner->CancelTask(task);
     }
-    task_map_.erase(item->first);
+    task_map_.erase(item);
   }
 }
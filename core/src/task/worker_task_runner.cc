@@ -29,14 +29,51 @@ const uint32_t WorkerTaskRunner::kDefaultTaskPriority = 10000;
 const uint32_t WorkerTaskRunner::kHighPriorityTaskPriority = 5000;
 const uint32_t WorkerTaskRunner::kLowPriorityTaskPriority = 15000;
 
-WorkerTaskRunner::WorkerTaskRunner(uint32_t pool_size) : pool_size_(pool_size) {
+namespace {
+
+// runner and worker index of the current thread, set by WorkerThread::Run
+thread_local WorkerTaskRunner* current_runner = nullptr;
+thread_local uint32_t current_index = 0;
+
+// a worker takes the injection queue before its own deque once in this many
+// tasks, one feeding its deque can't starve the tasks posted from outside
+constexpr uint32_t kInjectionCheckInterval = 61;
+
+}  // namespace
+
+WorkerTaskRunner::WorkerTaskRunner(uint32_t pool_size)
+    : pool_size_(pool_size > 0 ? pool_size : 1) {
   for (uint32_t i = 0; i < pool_size_; ++i) {
-    thread_pool_.push_back(std::make_unique<WorkerThread>(this));
+    worker_queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  for (uint32_t i = 0; i < pool_size_; ++i) {
+    thread_pool_.push_back(std::make_unique<WorkerThread>(this, i));
   }
 }
 
 void WorkerTaskRunner::PostTask(std::unique_ptr<CommonTask> task,
                                 uint32_t priority) {
+  if (current_runner == this && priority == kDefaultTaskPriority) {
+    if (terminated_) {
+      return;
+    }
+    WorkerQueue* queue = worker_queues_[current_index].get();
+    // counted before it is published, a thief popping it at once can't take
+    // the unsigned count below zero. pairs with the sleeping_count_ increment
+    // in GetNext, one of the two threads sees the other so the task can't be
+    // left with all workers asleep
+    local_task_count_.fetch_add(1);
+    {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      queue->tasks.push_back(std::move(task));
+    }
+    if (sleeping_count_.load() > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cv_.notify_one();
+    }
+    return;
+  }
+
   std::lock_guard<std::mutex> lock(mutex_);
   if (terminated_) {
     return;
@@ -45,19 +82,81 @@ void WorkerTaskRunner::PostTask(std::unique_ptr<CommonTask> task,
   cv_.notify_one();
 }
 
-std::unique_ptr<CommonTask> WorkerTaskRunner::GetNext() {
-  std::unique_lock<std::mutex> lock(mutex_);
+std::unique_ptr<CommonTask> WorkerTaskRunner::PopLocal(uint32_t index) {
+  WorkerQueue* queue = worker_queues_[index].get();
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  if (queue->tasks.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<CommonTask> result = std::move(queue->tasks.back());
+  queue->tasks.pop_back();
+  local_task_count_.fetch_sub(1);
+  return result;
+}
+
+std::unique_ptr<CommonTask> WorkerTaskRunner::Steal(uint32_t index) {
+  for (uint32_t i = 1; i < pool_size_; ++i) {
+    WorkerQueue* queue = worker_queues_[(index + i) % pool_size_].get();
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->tasks.empty()) {
+      std::unique_ptr<CommonTask> result = std::move(queue->tasks.front());
+      queue->tasks.pop_front();
+      local_task_count_.fetch_sub(1);
+      return result;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<CommonTask> WorkerTaskRunner::PopInjected() {
+  if (task_queue_.empty()) {
+    return nullptr;
+  }
+  const Entry& entry = task_queue_.top();
+  std::unique_ptr<CommonTask> result =
+      std::move(const_cast<Entry&>(entry).second);
+  task_queue_.pop();
+  return result;
+}
+
+std::unique_ptr<CommonTask> WorkerTaskRunner::GetNext(uint32_t index) {
+  WorkerQueue* queue = worker_queues_[index].get();
   while (true) {
-    if (!task_queue_.empty()) {
-      const Entry& entry = task_queue_.top();
-      std::unique_ptr<CommonTask> result =
-          std::move(const_cast<Entry&>(entry).second);
+    std::unique_ptr<CommonTask> result;
+    if (++queue->next_count % kInjectionCheckInterval == 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      result = PopInjected();
+    }
+    if (!result) {
+      result = PopLocal(index);
+    }
+    if (result) {
+      return result;
+    }
 
-      task_queue_.pop();
+    std::unique_lock<std::mutex> lock(mutex_);
+    result = PopInjected();
+    if (result) {
       return result;
     }
 
+    if (local_task_count_.load() > 0) {
+      lock.unlock();
+      result = Steal(index);
+      if (result) {
+        return result;
+      }
+      continue;
+    }
+
+    sleeping_count_.fetch_add(1);
+    if (local_task_count_.load() > 0) {
+      sleeping_count_.fetch_sub(1);
+      continue;
+    }
+
     if (terminated_) {
+      sleeping_count_.fetch_sub(1);
       hippy::napi::DetachThread();
       cv_.notify_all();
       TDF_BASE_DLOG(INFO) << "WorkerTaskRunner Terminate";
@@ -65,6 +164,7 @@ std::unique_ptr<CommonTask> WorkerTaskRunner::GetNext() {
     }
 
     cv_.wait(lock);
+    sleeping_count_.fetch_sub(1);
   }
 }
 
@@ -79,8 +179,11 @@ void WorkerTaskRunner::Terminate() {
   TDF_BASE_DLOG(INFO) << "WorkerTaskRunner::Terminate end";
 }
 
-WorkerTaskRunner::WorkerThread::WorkerThread(WorkerTaskRunner* runner)
-    : Thread(Options("Hippy WorkerTaskRunner WorkerThread")), runner_(runner) {
+WorkerTaskRunner::WorkerThread::WorkerThread(WorkerTaskRunner* runner,
+                                             uint32_t index)
+    : Thread(Options("Hippy WorkerTaskRunner WorkerThread")),
+      runner_(runner),
+      index_(index) {
   TDF_BASE_DLOG(INFO) << "WorkerThread create";
   Start();
 }
@@ -92,7 +195,9 @@ WorkerTaskRunner::WorkerThread::~WorkerThread() {
 }
 
 void WorkerTaskRunner::WorkerThread::Run() {
-  while (std::unique_ptr<CommonTask> task = runner_->GetNext()) {
+  current_runner = runner_;
+  current_index = index_;
+  while (std::unique_ptr<CommonTask> task = runner_->GetNext(index_)) {
     task->Run();
   }
   TDF_BASE_DLOG(INFO) << "WorkerThread Run Terminate";
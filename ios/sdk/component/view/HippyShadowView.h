@@ -60,6 +60,15 @@ typedef void (^HippyApplierVirtualBlock)(NSDictionary<NSNumber *, HippyVirtualNo
 - (void)insertHippySubview:(HippyShadowView *)subview atIndex:(NSInteger)atIndex NS_REQUIRES_SUPER;
 - (void)removeHippySubview:(HippyShadowView *)subview NS_REQUIRES_SUPER;
 
+/**
+ * Removes subviews in removed, then inserts each subview in added at its index in atIndices,
+ * through removeHippySubview: and insertHippySubview:atIndex: as manageChildren does one by
+ * one. The layout node changes its children in one pass and is marked dirty once.
+ */
+- (void)removeHippySubviews:(NSArray<HippyShadowView *> *)removed
+        insertHippySubviews:(NSArray<HippyShadowView *> *)added
+                  atIndices:(NSArray<NSNumber *> *)atIndices;
+
 @property (nonatomic, weak, readonly) HippyShadowView *superview;
 //@property (nonatomic, assign, readonly) CSSNodeRef cssNode;
 @property (nonatomic, assign, readonly) MTTNodeRef nodeRef;
@@ -30,6 +30,9 @@
 #import "MTTNode.h"
 #import "HippyI18nUtils.h"
 
+#include <algorithm>
+#include <vector>
+
 static NSString *const HippyBackgroundColorProp = @"backgroundColor";
 
 typedef NS_ENUM(unsigned int, meta_prop_t) {
@@ -52,6 +55,8 @@ typedef NS_ENUM(unsigned int, meta_prop_t) {
     BOOL _recomputeMargin;
     BOOL _recomputeBorder;
     BOOL _didUpdateSubviews;
+    // layout node moves collected by removeHippySubviews:insertHippySubviews:atIndices:.
+    std::vector<MTTChildMove> *_pendingChildMoves;
     float _paddingMetaProps[META_PROP_COUNT];
     float _marginMetaProps[META_PROP_COUNT];
     float _borderMetaProps[META_PROP_COUNT];
@@ -433,7 +438,11 @@ DEFINE_PROCESS_META_PROPS(Border);
 - (void)insertHippySubview:(HippyShadowView *)subview atIndex:(NSInteger)atIndex {
     [_hippySubviews insertObject:subview atIndex:atIndex];
     if (![self isCSSLeafNode]) {
-        MTTNodeInsertChild(_nodeRef, subview.nodeRef, (uint32_t)atIndex);
+        if (_pendingChildMoves) {
+            [self recordChildMove:subview.nodeRef toIndex:(int32_t)atIndex];
+        } else {
+            MTTNodeInsertChild(_nodeRef, subview.nodeRef, (uint32_t)atIndex);
+        }
     }
     subview->_superview = self;
     _didUpdateSubviews = YES;
@@ -448,7 +457,65 @@ DEFINE_PROCESS_META_PROPS(Border);
     subview->_superview = nil;
     [_hippySubviews removeObject:subview];
     if (![self isCSSLeafNode]) {
-        MTTNodeRemoveChild(_nodeRef, subview.nodeRef);
+        if (_pendingChildMoves) {
+            [self recordChildMove:subview.nodeRef toIndex:-1];
+        } else {
+            MTTNodeRemoveChild(_nodeRef, subview.nodeRef);
+        }
+    }
+}
+
+// a child removed and inserted again is moved, it keeps one move.
+- (void)recordChildMove:(MTTNodeRef)child toIndex:(int32_t)toIndex {
+    for (MTTChildMove &move : *_pendingChildMoves) {
+        if (move.child == child) {
+            move.toIndex = toIndex;
+            return;
+        }
+    }
+    _pendingChildMoves->push_back({ child, toIndex });
+}
+
+- (void)removeHippySubviews:(NSArray<HippyShadowView *> *)removed
+        insertHippySubviews:(NSArray<HippyShadowView *> *)added
+                  atIndices:(NSArray<NSNumber *> *)atIndices {
+    HippyAssert(added.count == atIndices.count, @"added had size %tu, atIndices had size %tu", added.count, atIndices.count);
+    // subclasses hook insertHippySubview:atIndex: and removeHippySubview:, so they are
+    // still called one by one, only the layout node moves are applied at once.
+    std::vector<MTTChildMove> moves;
+    _pendingChildMoves = &moves;
+    for (HippyShadowView *subview in removed) {
+        [self removeHippySubview:subview];
+    }
+
+    // inserting in ascending order leaves each subview at its index.
+    NSMutableArray<NSNumber *> *order = [NSMutableArray arrayWithCapacity:added.count];
+    for (NSUInteger i = 0; i < added.count; i++) {
+        [order addObject:@(i)];
+    }
+    [order sortUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+        return [atIndices[a.unsignedIntegerValue] compare:atIndices[b.unsignedIntegerValue]];
+    }];
+    for (NSNumber *i in order) {
+        [self insertHippySubview:added[i.unsignedIntegerValue] atIndex:atIndices[i.unsignedIntegerValue].integerValue];
+    }
+    _pendingChildMoves = nullptr;
+
+    if (!moves.empty() && !MTTNodeApplyChildMoves(_nodeRef, moves.data(), (uint32_t)moves.size())) {
+        // rejected moves change nothing, apply them one by one.
+        std::vector<MTTChildMove> inserts;
+        for (const MTTChildMove &move : moves) {
+            MTTNodeRemoveChild(_nodeRef, move.child);
+            if (move.toIndex >= 0) {
+                inserts.push_back(move);
+            }
+        }
+        std::sort(inserts.begin(), inserts.end(), [](const MTTChildMove &a, const MTTChildMove &b) {
+            return a.toIndex < b.toIndex;
+        });
+        for (const MTTChildMove &move : inserts) {
+            MTTNodeInsertChild(_nodeRef, move.child, (uint32_t)move.toIndex);
+        }
     }
 }
 
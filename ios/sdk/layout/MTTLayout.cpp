@@ -17,506 +17,317 @@
 
 #include "MTTLayout.h"
 
-#include "MTTUtil.h"
+#include "Hippy.h"
 
 MTTNodeRef MTTNodeNew() {
-  return new MTTNode();
+  return HPNodeNew();
+}
+
+// nodes of a scale factor share a config, scale factor of ios screen
+// doesn't change in practice, so it's a short list.
+static HPConfigRef MTTConfigWithScaleFactor(float scaleFactor) {
+  static std::vector<HPConfigRef> configs;
+  for (size_t i = 0; i < configs.size(); i++) {
+    if (FloatIsEqual(configs[i]->GetScaleFactor(), scaleFactor)) {
+      return configs[i];
+    }
+  }
+  HPConfigRef config = new HPConfig();
+  config->SetScaleFactor(scaleFactor);
+  configs.push_back(config);
+  return config;
 }
 
 MTTNodeRef MTTNodeNewWithScaleFactor(float scaleFactor) {
-  return new MTTNode(scaleFactor);
+  return HPNodeNewWithConfig(MTTConfigWithScaleFactor(scaleFactor));
 }
 
 void MTTNodeFree(MTTNodeRef node) {
-  if (node == nullptr)
-    return;
-  // free self
-  delete node;
+  HPNodeFree(node);
 }
 
 void MTTNodeFreeRecursive(MTTNodeRef node) {
-  if (node == nullptr) {
-    return;
-  }
-
-  while (node->childCount() > 0) {
-    MTTNodeRef child = node->getChild(0);
-    MTTNodeFreeRecursive(child);
-  }
-
-  MTTNodeFree(node);
+  HPNodeFreeRecursive(node);
 }
 
 void MTTNodeStyleSetDirection(MTTNodeRef node, MTTDirection direction) {
-  if (node == nullptr || node->style.direction == direction) {
-    return;
-  }
-
-  node->style.direction = direction;
-  node->markAsDirty();
+  HPNodeStyleSetDirection(node, direction);
 }
 
 void MTTNodeStyleSetWidth(MTTNodeRef node, float width) {
-  if (node == nullptr || FloatIsEqual(node->style.dim[DimWidth], width)) {
-    return;
-  }
-
-  node->style.dim[DimWidth] = width;
-  node->markAsDirty();
+  HPNodeStyleSetWidth(node, width);
 }
 
 void MTTNodeStyleSetHeight(MTTNodeRef node, float height) {
-  if (node == nullptr || FloatIsEqual(node->style.dim[DimHeight], height))
-    return;
-
-  node->style.dim[DimHeight] = height;
-  node->markAsDirty();
+  HPNodeStyleSetHeight(node, height);
 }
 
 bool MTTNodeSetMeasureFunc(MTTNodeRef node, MTTMeasureFunc _measure) {
-  if (node == nullptr)
-    return false;
-
-  return node->setMeasureFunc(_measure);
+  return HPNodeSetMeasureFunc(node, _measure);
 }
 
 void MTTNodeStyleSetFlex(MTTNodeRef node, float flex) {
-  if (node == nullptr || FloatIsEqual(node->style.flex, flex))
-    return;
-  if (FloatIsEqual(flex, 0.0f)) {
-    MTTNodeStyleSetFlexGrow(node, 0.0f);
-    MTTNodeStyleSetFlexShrink(node, 0.0f);
-  } else if (flex > 0.0f) {
-    MTTNodeStyleSetFlexGrow(node, flex);
-    MTTNodeStyleSetFlexShrink(node, 1.0f);
-  } else {
-    MTTNodeStyleSetFlexGrow(node, 0.0f);
-    MTTNodeStyleSetFlexShrink(node, -flex);
-  }
-  node->style.flex = flex;
-  node->markAsDirty();
+  HPNodeStyleSetFlex(node, flex);
 }
 
 void MTTNodeStyleSetFlexGrow(MTTNodeRef node, float flexGrow) {
-  if (node == nullptr || FloatIsEqual(node->style.flexGrow, flexGrow))
-    return;
-
-  node->style.flexGrow = flexGrow;
-  node->markAsDirty();
+  HPNodeStyleSetFlexGrow(node, flexGrow);
 }
 
 void MTTNodeStyleSetFlexShrink(MTTNodeRef node, float flexShrink) {
-  if (node == nullptr || FloatIsEqual(node->style.flexShrink, flexShrink))
-    return;
-
-  node->style.flexShrink = flexShrink;
-  node->markAsDirty();
+  HPNodeStyleSetFlexShrink(node, flexShrink);
 }
 
 void MTTNodeStyleSetFlexBasis(MTTNodeRef node, float flexBasis) {
-  if (node == nullptr || FloatIsEqual(node->style.flexBasis, flexBasis))
-    return;
-
-  node->style.flexBasis = flexBasis;
-  node->markAsDirty();
+  HPNodeStyleSetFlexBasis(node, flexBasis);
 }
 
 void MTTNodeStyleSetFlexDirection(MTTNodeRef node, FlexDirection direction) {
-  if (node == nullptr || node->style.flexDirection == direction)
-    return;
-
-  node->style.flexDirection = direction;
-  node->markAsDirty();
+  HPNodeStyleSetFlexDirection(node, direction);
 }
 
 void MTTNodeStyleSetPositionType(MTTNodeRef node, PositionType positionType) {
-  if (node == nullptr || node->style.positionType == positionType)
-    return;
-  node->style.positionType = positionType;
-  node->markAsDirty();
+  HPNodeStyleSetPositionType(node, positionType);
 }
 
 void MTTNodeStyleSetPosition(MTTNodeRef node, CSSDirection dir, float value) {
-  if (node == nullptr || FloatIsEqual(node->style.position[dir], value))
-    return;
-  if (node->style.setPosition(dir, value)) {
-    node->markAsDirty();
-  }
+  HPNodeStyleSetPosition(node, dir, value);
 }
 
 void MTTNodeStyleSetMargin(MTTNodeRef node, CSSDirection dir, float value) {
-  if (node == nullptr)
-    return;
-  if (node->style.setMargin(dir, value)) {
-    node->markAsDirty();
-  }
+  HPNodeStyleSetMargin(node, dir, value);
 }
 
 void MTTNodeStyleSetMarginAuto(MTTNodeRef node, CSSDirection dir) {
-  MTTNodeStyleSetMargin(node, dir, VALUE_AUTO);
+  HPNodeStyleSetMarginAuto(node, dir);
 }
 
 void MTTNodeStyleSetPadding(MTTNodeRef node, CSSDirection dir, float value) {
-  if (node == nullptr)
-    return;
-  if (node->style.setPadding(dir, value)) {
-    node->markAsDirty();
-  }
+  HPNodeStyleSetPadding(node, dir, value);
 }
 
 void MTTNodeStyleSetBorder(MTTNodeRef node, CSSDirection dir, float value) {
-  if (node == nullptr)
-    return;
-  if (node->style.setBorder(dir, value)) {
-    node->markAsDirty();
-  }
+  HPNodeStyleSetBorder(node, dir, value);
 }
 
 void MTTNodeStyleSetFlexWrap(MTTNodeRef node, FlexWrapMode wrapMode) {
-  if (node == nullptr || node->style.flexWrap == wrapMode)
-    return;
-
-  node->style.flexWrap = wrapMode;
-  node->markAsDirty();
+  HPNodeStyleSetFlexWrap(node, wrapMode);
 }
 
 void MTTNodeStyleSetJustifyContent(MTTNodeRef node, FlexAlign justify) {
-  if (node == nullptr || node->style.justifyContent == justify)
-    return;
-  node->style.justifyContent = justify;
-  node->markAsDirty();
+  HPNodeStyleSetJustifyContent(node, justify);
 }
 
 void MTTNodeStyleSetAlignContent(MTTNodeRef node, FlexAlign align) {
-  if (node == nullptr || node->style.alignContent == align)
-    return;
-  node->style.alignContent = align;
-  node->markAsDirty();
+  HPNodeStyleSetAlignContent(node, align);
 }
 
 void MTTNodeStyleSetAlignItems(MTTNodeRef node, FlexAlign align) {
-  if (node == nullptr || node->style.alignItems == align)
-    return;
-  // FlexAlignStart == FlexAlignBaseline
-  node->style.alignItems = align;
-  node->markAsDirty();
+  HPNodeStyleSetAlignItems(node, align);
 }
 
 void MTTNodeStyleSetAlignSelf(MTTNodeRef node, FlexAlign align) {
-  if (node == nullptr || node->style.alignSelf == align)
-    return;
-  node->style.alignSelf = align;
-  node->markAsDirty();
+  HPNodeStyleSetAlignSelf(node, align);
+}
+
+void MTTNodeStyleSetDisplay(MTTNodeRef node, DisplayType displayType) {
+  HPNodeStyleSetDisplay(node, displayType);
+}
+
+void MTTNodeStyleSetMaxWidth(MTTNodeRef node, float value) {
+  HPNodeStyleSetMaxWidth(node, value);
+}
+
+void MTTNodeStyleSetMaxHeight(MTTNodeRef node, float value) {
+  HPNodeStyleSetMaxHeight(node, value);
+}
+
+void MTTNodeStyleSetMinWidth(MTTNodeRef node, float value) {
+  HPNodeStyleSetMinWidth(node, value);
+}
+
+void MTTNodeStyleSetMinHeight(MTTNodeRef node, float value) {
+  HPNodeStyleSetMinHeight(node, value);
+}
+
+void MTTNodeSetNodeType(MTTNodeRef node, NodeType nodeType) {
+  HPNodeSetNodeType(node, nodeType);
+}
+
+void MTTNodeStyleSetOverflow(MTTNodeRef node, OverflowType overflowType) {
+  HPNodeStyleSetOverflow(node, overflowType);
 }
 
 float MTTNodeLayoutGetLeft(MTTNodeRef node) {
-  if (node == nullptr)
-    return 0;
-  return node->result.position[CSSLeft];
+  return HPNodeLayoutGetLeft(node);
 }
 
 float MTTNodeLayoutGetTop(MTTNodeRef node) {
-  if (node == nullptr)
-    return 0;
-  return node->result.position[CSSTop];
+  return HPNodeLayoutGetTop(node);
 }
 
 float MTTNodeLayoutGetRight(MTTNodeRef node) {
-  if (node == nullptr)
-    return 0;
-  return node->result.position[CSSRight];
+  return HPNodeLayoutGetRight(node);
 }
 
 float MTTNodeLayoutGetBottom(MTTNodeRef node) {
-  if (node == nullptr)
-    return 0;
-  return node->result.position[CSSBottom];
+  return HPNodeLayoutGetBottom(node);
 }
 
 float MTTNodeLayoutGetWidth(MTTNodeRef node) {
-  if (node == nullptr)
-    return 0;
-  return node->result.dim[DimWidth];
+  return HPNodeLayoutGetWidth(node);
 }
 
 float MTTNodeLayoutGetHeight(MTTNodeRef node) {
-  if (node == nullptr)
-    return 0;
-  return node->result.dim[DimHeight];
+  return HPNodeLayoutGetHeight(node);
 }
 
 float MTTNodeLayoutGetMaxWidth(MTTNodeRef node) {
-  if (node == nullptr) {
-    return 0;
-  }
-  return node->style.maxDim[DimWidth];
+  return HPNodeStyleGetMaxWidth(node);
 }
 
 float MTTNodeLayoutGetMaxHeight(MTTNodeRef node) {
-  if (node == nullptr) {
-    return 0;
-  }
-  return node->style.maxDim[DimHeight];
+  return HPNodeStyleGetMaxHeight(node);
 }
 
 float MTTNodeLayoutGetMinWidth(MTTNodeRef node) {
-  if (node == nullptr) {
-    return 0;
-  }
-  return node->style.minDim[DimWidth];
+  return HPNodeStyleGetMinWidth(node);
 }
 
 float MTTNodeLayoutGetMinHeight(MTTNodeRef node) {
-  if (node == nullptr) {
-    return 0;
-  }
-  return node->style.minDim[DimHeight];
+  return HPNodeStyleGetMinHeight(node);
 }
 
 float MTTNodeLayoutGetMargin(MTTNodeRef node, CSSDirection dir) {
-  if (node == nullptr || dir > CSSBottom)
-    return 0;
-  return node->result.margin[dir];
+  return HPNodeLayoutGetMargin(node, dir);
 }
 
 float MTTNodeLayoutGetPadding(MTTNodeRef node, CSSDirection dir) {
-  if (node == nullptr || dir > CSSBottom)
-    return 0;
-  return node->result.padding[dir];
-}
-float MTTNodeLayoutGetBorder(MTTNodeRef node, CSSDirection dir) {
-  if (node == nullptr || dir > CSSBottom)
-    return 0;
-  return node->result.border[dir];
+  return HPNodeLayoutGetPadding(node, dir);
 }
 
-bool MTTNodeLayoutGetHadOverflow(MTTNodeRef node) {
-  if (node == nullptr)
-    return false;
-  return node->result.hadOverflow;
+float MTTNodeLayoutGetBorder(MTTNodeRef node, CSSDirection dir) {
+  return HPNodeLayoutGetBorder(node, dir);
 }
 
 float MTTNodeLayoutGetFlexGrow(MTTNodeRef node) {
-  if (nullptr != node) {
-    return node->style.flexGrow;
-  }
-  return 0.f;
+  return HPNodeStyleGetFlexGrow(node);
 }
+
 float MTTNodeLayoutGetFlexShrink(MTTNodeRef node) {
-  if (nullptr != node) {
-    return node->style.flexShrink;
-  }
-  return 0.f;
+  return HPNodeStyleGetFlexShrink(node);
 }
 
 float MTTNodeLayoutGetPosition(MTTNodeRef node, CSSDirection dir) {
-  if (nullptr == node) {
-    return 0;
-  }
-  return node->style.position[dir];
+  return HPNodeStyleGetPosition(node, dir);
 }
 
 DisplayType MTTNodeLayoutGetDisplay(MTTNodeRef node) {
-  if (nullptr == node) {
-    return DisplayTypeFlex;
-  }
-  return node->style.displayType;
+  return HPNodeStyleGetDisplay(node);
 }
 
 float MTTNodeLayoutGetFlexBasis(MTTNodeRef node) {
-  if (nullptr == node) {
-    return 0;
-  }
-  return node->style.getFlexBasis();
+  return HPNodeStyleGetFlexBasis(node);
 }
 
 FlexDirection MTTNodeLayoutGetFlexDirection(MTTNodeRef node) {
-  if (nullptr == node) {
-    return FLexDirectionRow;
-  }
-  return node->style.flexDirection;
+  return HPNodeStyleGetFlexDirection(node);
 }
 
 FlexAlign MTTNodeLayoutGetJustifyContent(MTTNodeRef node) {
-  if (nullptr == node) {
-    return FlexAlignStart;
-  }
-  return node->style.alignContent;
+  return HPNodeStyleGetJustifyContent(node);
 }
 
 FlexAlign MTTNodeLayoutGetAlignSelf(MTTNodeRef node) {
-  if (nullptr == node) {
-    return FlexAlignAuto;
-  }
-  return node->style.alignSelf;
+  return HPNodeStyleGetAlignSelf(node);
 }
 
 FlexAlign MTTNodeLayoutGetAlignItems(MTTNodeRef node) {
-  if (nullptr == node) {
-    return FlexAlignStart;
-  }
-  return node->style.alignItems;
+  return HPNodeStyleGetAlignItems(node);
 }
 
 PositionType MTTNodeLayoutGetPositionType(MTTNodeRef node) {
-  if (nullptr == node) {
-    return PositionTypeRelative;
-  }
-  return node->style.positionType;
+  return HPNodeStyleGetPositionType(node);
 }
 
 FlexWrapMode MTTNodeLayoutGetFlexWrap(MTTNodeRef node) {
-  if (nullptr == node) {
-    return FlexNoWrap;
-  }
-  return node->style.flexWrap;
+  return HPNodeStyleGetFlexWrap(node);
 }
 
 OverflowType MTTNodeLayoutGetOverflow(MTTNodeRef node) {
-  if (nullptr == node) {
-    return OverflowVisible;
-  }
-  return node->style.overflowType;
-}
-
-void MTTNodeStyleSetDisplay(MTTNodeRef node, DisplayType displayType) {
-  if (node == nullptr)
-    return;
-  node->setDisplayType(displayType);
-}
-
-void MTTNodeStyleSetMaxWidth(MTTNodeRef node, float value) {
-  if (node == nullptr || FloatIsEqual(node->style.maxDim[DimWidth], value))
-    return;
-  node->style.maxDim[DimWidth] = value;
-  node->markAsDirty();
-}
-
-void MTTNodeStyleSetMaxHeight(MTTNodeRef node, float value) {
-  if (node == nullptr || FloatIsEqual(node->style.maxDim[DimHeight], value))
-    return;
-  node->style.maxDim[DimHeight] = value;
-  node->markAsDirty();
-}
-
-void MTTNodeStyleSetMinWidth(MTTNodeRef node, float value) {
-  if (node == nullptr || FloatIsEqual(node->style.minDim[DimWidth], value))
-    return;
-  node->style.minDim[DimWidth] = value;
-  node->markAsDirty();
-}
-
-void MTTNodeStyleSetMinHeight(MTTNodeRef node, float value) {
-  if (node == nullptr || FloatIsEqual(node->style.minDim[DimHeight], value))
-    return;
-  node->style.minDim[DimHeight] = value;
-  node->markAsDirty();
+  return HPNodeStyleGetOverflow(node);
 }
 
-void MTTNodeSetNodeType(MTTNodeRef node, NodeType nodeType) {
-  if (node == nullptr || nodeType == node->style.nodeType)
-    return;
-  node->style.nodeType = nodeType;
-  // node->markAsDirty();
-}
-
-void MTTNodeStyleSetOverflow(MTTNodeRef node, OverflowType overflowType) {
-  if (node == nullptr || overflowType == node->style.overflowType)
-    return;
-
-  node->style.overflowType = overflowType;
-  node->markAsDirty();
+bool MTTNodeLayoutGetHadOverflow(MTTNodeRef node) {
+  return HPNodeLayoutGetHadOverflow(node);
 }
 
 bool MTTNodeInsertChild(MTTNodeRef node, MTTNodeRef child, uint32_t index) {
-  if (node == nullptr)
-    return false;
-
-  return node->insertChild(child, index);
+  return HPNodeInsertChild(node, child, index);
 }
 
 bool MTTNodeRemoveChild(MTTNodeRef node, MTTNodeRef child) {
-  if (node == nullptr)
-    return false;
-  return node->removeChild(child);
+  return HPNodeRemoveChild(node, child);
+}
+
+bool MTTNodeApplyChildMoves(MTTNodeRef node, const MTTChildMove *moves, uint32_t count) {
+  return HPNodeApplyChildMoves(node, moves, count);
 }
 
 uint32_t MTTNodeChildCount(MTTNodeRef node) {
-  if (nullptr == node) {
-    return 0;
-  }
-  return node->childCount();
+  return HPNodeChildCount(node);
 }
 
 MTTNodeRef MTTNodeGetChild(MTTNodeRef node, uint32_t index) {
-  return node->getChild(index);
+  return HPNodeGetChild(node, index);
 }
 
 void MTTNodeSetParent(MTTNodeRef node, MTTNodeRef parentNode) {
+  if (node == nullptr)
+    return;
   node->setParent(parentNode);
 }
 
 MTTNodeRef MTTNodeGetParent(MTTNodeRef node) {
-  return node->getParent();
+  return HPNodeGetParent(node);
 }
 
 bool MTTNodeHasNewLayout(MTTNodeRef node) {
-  if (node == nullptr)
-    return false;
-  return node->hasNewLayout();
+  return HPNodeHasNewLayout(node);
 }
 
 void MTTNodesetHasNewLayout(MTTNodeRef node, bool hasNewLayout) {
-  if (node == nullptr)
-    return;
-  node->setHasNewLayout(hasNewLayout);
+  HPNodesetHasNewLayout(node, hasNewLayout);
 }
 
 void MTTNodeSetContext(MTTNodeRef node, void *context) {
-  if (nullptr != node) {
-    node->setContext(context);
-  }
+  HPNodeSetContext(node, context);
 }
 
 void *MTTNodeGetContext(MTTNodeRef node) {
-  if (nullptr != node) {
-    return node->getContext();
-  }
-  return NULL;
+  return HPNodeGetContext(node);
 }
 
 void MTTNodeMarkDirty(MTTNodeRef node) {
-  if (node == nullptr)
-    return;
-  node->markAsDirty();
+  HPNodeMarkDirty(node);
 }
 
 bool MTTNodeIsDirty(MTTNodeRef node) {
-  if (node == nullptr)
-    return false;
-  return node->isDirty;
+  return HPNodeIsDirty(node);
 }
 
 void MTTNodeDoLayout(MTTNodeRef node,
-                    float parentWidth,
-                    float parentHeight,
-                    MTTDirection direction,
-                    void* layoutContext) {
-  if (node == nullptr)
-    return;
-
-  node->layout(parentWidth, parentHeight, direction, layoutContext);
+                     float parentWidth,
+                     float parentHeight,
+                     MTTDirection direction,
+                     void* layoutContext) {
+  HPNodeDoLayout(node, parentWidth, parentHeight, direction, layoutContext);
 }
 
 void MTTNodePrint(MTTNodeRef node) {
-  if (node == nullptr)
-    return;
-  node->printNode();
+  HPNodePrint(node);
 }
 
 bool MTTNodeReset(MTTNodeRef node) {
-  if (node == nullptr || node->childCount() != 0 || node->getParent() != nullptr)
-    return false;
-
-  return node->reset();
+  return HPNodeReset(node);
 }
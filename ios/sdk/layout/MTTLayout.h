@@ -17,6 +17,7 @@
 
 /* this module hold common operations for MTTNode
  *  It's open to outside
+ *  they forward to Hippy.h of the layout engine shared with android.
  */
 
 #pragma once
@@ -86,6 +87,7 @@ bool MTTNodeLayoutGetHadOverflow(MTTNodeRef node);
 
 bool MTTNodeInsertChild(MTTNodeRef node, MTTNodeRef child, uint32_t index);
 bool MTTNodeRemoveChild(MTTNodeRef node, MTTNodeRef child);
+bool MTTNodeApplyChildMoves(MTTNodeRef node, const MTTChildMove *moves, uint32_t count);
 uint32_t MTTNodeChildCount(MTTNodeRef node);
 MTTNodeRef MTTNodeGetChild(MTTNodeRef node, uint32_t index);
 
@@ -827,6 +827,17 @@ HIPPY_EXPORT_METHOD(manageChildren:(nonnull NSNumber *)containerTag
     NSArray<id<HippyComponent>> *permanentlyRemovedChildren = [self _childrenToRemoveFromContainer:container atIndices:removeAtIndices];
     NSArray<id<HippyComponent>> *temporarilyRemovedChildren = [self _childrenToRemoveFromContainer:container atIndices:moveFromIndices];
     BOOL isUIViewRegistry = registry == (NSMutableDictionary<NSNumber *, id<HippyComponent>> *)_viewRegistry;
+    if (registry == (NSMutableDictionary<NSNumber *, id<HippyComponent>> *)_shadowViewRegistry &&
+        [container isKindOfClass:[HippyShadowView class]]) {
+        // shadow views change children of their layout nodes in one pass.
+        [self _manageShadowChildren:(HippyShadowView *)container
+                      moveToIndices:moveToIndices
+                  addChildHippyTags:addChildHippyTags
+                       addAtIndices:addAtIndices
+                 permanentlyRemoved:(NSArray<HippyShadowView *> *)permanentlyRemovedChildren
+                 temporarilyRemoved:(NSArray<HippyShadowView *> *)temporarilyRemovedChildren];
+        return;
+    }
     [self _removeChildren:permanentlyRemovedChildren fromContainer:container];
 
     [self _removeChildren:temporarilyRemovedChildren fromContainer:container];
@@ -873,6 +884,34 @@ HIPPY_EXPORT_METHOD(manageChildren:(nonnull NSNumber *)containerTag
     }
 }
 
+- (void)_manageShadowChildren:(HippyShadowView *)container
+                moveToIndices:(NSArray<NSNumber *> *)moveToIndices
+            addChildHippyTags:(NSArray<NSNumber *> *)addChildHippyTags
+                 addAtIndices:(NSArray<NSNumber *> *)addAtIndices
+           permanentlyRemoved:(NSArray<HippyShadowView *> *)permanentlyRemovedChildren
+           temporarilyRemoved:(NSArray<HippyShadowView *> *)temporarilyRemovedChildren {
+    NSMutableArray<HippyShadowView *> *removed = [NSMutableArray arrayWithArray:permanentlyRemovedChildren];
+    [removed addObjectsFromArray:temporarilyRemovedChildren];
+
+    // merge temporary inserts and adds as _manageChildren does.
+    NSMutableDictionary<NSNumber *, HippyShadowView *> *destinationsToChildrenToAdd = [NSMutableDictionary dictionary];
+    for (NSInteger index = 0, length = temporarilyRemovedChildren.count; index < length; index++) {
+        destinationsToChildrenToAdd[moveToIndices[index]] = temporarilyRemovedChildren[index];
+    }
+    for (NSInteger index = 0, length = addAtIndices.count; index < length; index++) {
+        HippyShadowView *shadowView = _shadowViewRegistry[addChildHippyTags[index]];
+        if (shadowView) {
+            destinationsToChildrenToAdd[addAtIndices[index]] = shadowView;
+        }
+    }
+    NSArray<NSNumber *> *atIndices = destinationsToChildrenToAdd.allKeys;
+    NSArray<HippyShadowView *> *added = [destinationsToChildrenToAdd objectsForKeys:atIndices notFoundMarker:[NSNull null]];
+
+    [container removeHippySubviews:removed insertHippySubviews:added atIndices:atIndices];
+    [self _purgeChildren:(NSArray<id<HippyComponent>> *)permanentlyRemovedChildren
+            fromRegistry:(NSMutableDictionary<NSNumber *, id<HippyComponent>> *)_shadowViewRegistry];
+}
+
 // clang-format off
 HIPPY_EXPORT_METHOD(createView:(nonnull NSNumber *)hippyTag
                   viewName:(NSString *)viewName
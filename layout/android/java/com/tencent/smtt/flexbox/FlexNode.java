@@ -31,6 +31,8 @@ import com.tencent.mtt.hippy.dom.flex.FlexWrap;
 import com.tencent.mtt.hippy.dom.flex.FloatUtil;
 import com.tencent.smtt.flexbox.FlexNodeStyle.Edge;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.ArrayList;
 import java.util.List;
 
@@ -76,6 +78,58 @@ public class FlexNode implements FlexNodeAPI<FlexNode> {
 	    return measure(width, widthMode, height, heightMode);
 	  }
 
+	  // copy layout of count nodes written by native HPNodeExportLayout, a record is
+	  // index in nodes, left, top, width, height, then left, top, right, bottom of
+	  // margin, padding and border.
+	  @CalledByNative
+	  private static void applyLayoutBuffer(FlexNode[] nodes, ByteBuffer buffer, int count) {
+	    buffer.order(ByteOrder.nativeOrder());
+	    for (int i = 0; i < count; i++) {
+	      FlexNode node = nodes[buffer.getInt()];
+	      node.mLeft = buffer.getFloat();
+	      node.mTop = buffer.getFloat();
+	      node.mWidth = buffer.getFloat();
+	      node.mHeight = buffer.getFloat();
+	      if ((node.mEdgeSetFlag & MARGIN) == MARGIN) {
+	        node.mMarginLeft = buffer.getFloat();
+	        node.mMarginTop = buffer.getFloat();
+	        node.mMarginRight = buffer.getFloat();
+	        node.mMarginBottom = buffer.getFloat();
+	      } else {
+	        buffer.position(buffer.position() + 16);
+	      }
+	      if ((node.mEdgeSetFlag & PADDING) == PADDING) {
+	        node.mPaddingLeft = buffer.getFloat();
+	        node.mPaddingTop = buffer.getFloat();
+	        node.mPaddingRight = buffer.getFloat();
+	        node.mPaddingBottom = buffer.getFloat();
+	      } else {
+	        buffer.position(buffer.position() + 16);
+	      }
+	      if ((node.mEdgeSetFlag & BORDER) == BORDER) {
+	        node.mBorderLeft = buffer.getFloat();
+	        node.mBorderTop = buffer.getFloat();
+	        node.mBorderRight = buffer.getFloat();
+	        node.mBorderBottom = buffer.getFloat();
+	      } else {
+	        buffer.position(buffer.position() + 16);
+	      }
+	      node.mHasNewLayout = true;
+	    }
+	  }
+
+	  // measure content nodes of a layout pass in one call, sizes and modes hold
+	  // width and height of each node, see setBatchMeasureEnabled
+	  @CalledByNative
+	  private static void measureBatchFunc(FlexNode[] nodes, float[] sizes, int[] modes, long[] results) {
+	    for (int i = 0; i < nodes.length; i++) {
+	      if (nodes[i] == null) {
+	        continue;
+	      }
+	      results[i] = nodes[i].measure(sizes[i * 2], modes[i * 2], sizes[i * 2 + 1], modes[i * 2 + 1]);
+	    }
+	  }
+
     protected String resultToString(){
         return "layout: {" +
                 "left: " + getLayoutX() + ", " +
@@ -322,6 +376,61 @@ public class FlexNode implements FlexNodeAPI<FlexNode> {
 	    return nativeFlexNodeNodeIsDirty(mNativeFlexNode);
 	  }
 	  
+	  private native void nativeFlexNodeSetMeasureContentHash(long nativePointer, long contentHash);
+	  // nodes with same content (text, font...) give same hash to share measure results,
+	  // 0 means not shared. see setSharedMeasureCacheCapacity
+	  public void setMeasureContentHash(long contentHash) {
+	    nativeFlexNodeSetMeasureContentHash(mNativeFlexNode, contentHash);
+	  }
+
+	  private native void nativeFlexNodeSetViewport(long nativePointer, float offset, float size,
+	      float margin, float estimatedItemSize);
+	  // for scroll container, lay out only children within [offset - margin, offset + size + margin]
+	  // along main axis, the others keep last size or estimatedItemSize. call it when scrolled.
+	  public void setViewport(float offset, float size, float margin, float estimatedItemSize) {
+	    nativeFlexNodeSetViewport(mNativeFlexNode, offset, size, margin, estimatedItemSize);
+	  }
+
+	  private native void nativeFlexNodeClearViewport(long nativePointer);
+	  public void clearViewport() {
+	    nativeFlexNodeClearViewport(mNativeFlexNode);
+	  }
+
+	  private static native void nativeFlexNodeSetSharedMeasureCacheCapacity(int capacity);
+	  // capacity of measure results shared by all nodes, 0 to disable.
+	  public static void setSharedMeasureCacheCapacity(int capacity) {
+	    nativeFlexNodeSetSharedMeasureCacheCapacity(capacity);
+	  }
+
+	  private static native boolean nativeFlexNodeApplyStyleBuffer(long[] nativeNodes, ByteBuffer buffer, int size);
+	  // apply styles written by FlexStyleBuffer to nodes in one jni call,
+	  // node index of the buffer refers to nodes. return false if the buffer is bad.
+	  public static boolean applyStyleBuffer(FlexNode[] nodes, FlexStyleBuffer buffer) {
+	    long[] nativeNodes = new long[nodes.length];
+	    for (int i = 0; i < nodes.length; i++) {
+	      nativeNodes[i] = nodes[i].mNativeFlexNode;
+	    }
+	    return nativeFlexNodeApplyStyleBuffer(nativeNodes, buffer.buffer(), buffer.size());
+	  }
+
+	  private static native void nativeFlexNodeSetBatchMeasureEnabled(boolean enabled);
+	  // measure content nodes in one jni call per layout round instead of one call per node.
+	  public static void setBatchMeasureEnabled(boolean enabled) {
+	    nativeFlexNodeSetBatchMeasureEnabled(enabled);
+	  }
+
+	  private static native void nativeFlexNodeSetTraceEnabled(boolean enabled);
+	  private static native String nativeFlexNodeGetTraceJson();
+	  // trace layout passes in release builds, events recorded since enabled are
+	  // returned by getTraceJson in chrome trace event format.
+	  public static void setTraceEnabled(boolean enabled) {
+	    nativeFlexNodeSetTraceEnabled(enabled);
+	  }
+
+	  public static String getTraceJson() {
+	    return nativeFlexNodeGetTraceJson();
+	  }
+
 	  private native void nativeFlexNodeNodeSetHasMeasureFunc(long nativePointer, boolean hasMeasureFunc);
 	  public final long measure(float width, int widthMode, float height, int heightMode) {
 	    if (!isMeasureDefined()) {
@@ -0,0 +1,122 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+package com.tencent.smtt.flexbox;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+// writes styles of many nodes in the layout of native HPStyleBuffer.h,
+// see FlexNode.applyStyleBuffer
+public class FlexStyleBuffer {
+	// keep in sync with HP_STYLE_BUFFER_VERSION and HPStyleProperty
+	public static final int VERSION = 1;
+
+	public static final int DIRECTION = 0;
+	public static final int WIDTH = 1;
+	public static final int HEIGHT = 2;
+	public static final int FLEX = 3;
+	public static final int FLEX_GROW = 4;
+	public static final int FLEX_SHRINK = 5;
+	public static final int FLEX_BASIS = 6;
+	public static final int FLEX_DIRECTION = 7;
+	public static final int POSITION_TYPE = 8;
+	public static final int POSITION = 9;
+	public static final int MARGIN = 10;
+	public static final int MARGIN_AUTO = 11;
+	public static final int PADDING = 12;
+	public static final int BORDER = 13;
+	public static final int FLEX_WRAP = 14;
+	public static final int JUSTIFY_CONTENT = 15;
+	public static final int ALIGN_CONTENT = 16;
+	public static final int ALIGN_ITEMS = 17;
+	public static final int ALIGN_SELF = 18;
+	public static final int DISPLAY = 19;
+	public static final int MAX_WIDTH = 20;
+	public static final int MAX_HEIGHT = 21;
+	public static final int MIN_WIDTH = 22;
+	public static final int MIN_HEIGHT = 23;
+	public static final int NODE_TYPE = 24;
+	public static final int OVERFLOW = 25;
+
+	private static final int HEADER_SIZE = 8;
+	private static final int NODE_SIZE = 8;
+	private static final int PROPERTY_SIZE = 8;
+
+	private ByteBuffer mBuffer;
+	private int mNodeCount = 0;
+	// offset of property count of current node
+	private int mPropertyCountOffset = -1;
+	private int mPropertyCount = 0;
+
+	public FlexStyleBuffer(int capacity) {
+		mBuffer = ByteBuffer.allocateDirect(Math.max(capacity, HEADER_SIZE)).order(ByteOrder.nativeOrder());
+		clear();
+	}
+
+	public void clear() {
+		mBuffer.clear();
+		mBuffer.putInt(VERSION);
+		mBuffer.putInt(0);
+		mNodeCount = 0;
+		mPropertyCountOffset = -1;
+		mPropertyCount = 0;
+	}
+
+	// start properties of node at nodeIndex of nodes given to FlexNode.applyStyleBuffer
+	public void beginNode(int nodeIndex) {
+		ensureCapacity(NODE_SIZE);
+		mBuffer.putInt(nodeIndex);
+		mPropertyCountOffset = mBuffer.position();
+		mBuffer.putInt(0);
+		mPropertyCount = 0;
+		mBuffer.putInt(4, ++mNodeCount);
+	}
+
+	public void put(int property, float value) {
+		put(property, -1, value);
+	}
+
+	// edge is FlexNodeStyle.Edge ordinal for POSITION, MARGIN, MARGIN_AUTO, PADDING and BORDER
+	public void put(int property, int edge, float value) {
+		if (mPropertyCountOffset < 0) {
+			throw new IllegalStateException("beginNode must be called before put");
+		}
+		ensureCapacity(PROPERTY_SIZE);
+		mBuffer.putShort((short) property);
+		mBuffer.putShort((short) edge);
+		mBuffer.putFloat(value);
+		mBuffer.putInt(mPropertyCountOffset, ++mPropertyCount);
+	}
+
+	ByteBuffer buffer() {
+		return mBuffer;
+	}
+
+	int size() {
+		return mBuffer.position();
+	}
+
+	private void ensureCapacity(int size) {
+		if (mBuffer.remaining() >= size) {
+			return;
+		}
+		ByteBuffer buffer = ByteBuffer.allocateDirect(Math.max(mBuffer.capacity() * 2, mBuffer.position() + size))
+				.order(ByteOrder.nativeOrder());
+		mBuffer.flip();
+		buffer.put(mBuffer);
+		mBuffer = buffer;
+	}
+}
@@ -17,7 +17,6 @@
 #include "FlexNode.h"
 
 #include <android/log.h>
-#include <time.h>
 
 #include <iostream>
 #include <map>
@@ -30,37 +29,6 @@ static inline HPNodeRef _jlong2HPNodeRef(jlong addr) {
   return (reinterpret_cast<FlexNode*>(addr))->mHPNode;
 }
 
-#ifdef LAYOUT_TIME_ANALYZE
-static int layout_analyze_measureCount = 0;
-static double layout_analyze_measureTime = 0.0f;
-static int newLayoutCount = 0;
-#endif
-
-static jclass clazz;
-
-static jfieldID widthField;
-static jfieldID heightField;
-static jfieldID leftField;
-static jfieldID topField;
-
-static jfieldID marginLeftField;
-static jfieldID marginTopField;
-static jfieldID marginRightField;
-static jfieldID marginBottomField;
-
-static jfieldID paddingLeftField;
-static jfieldID paddingTopField;
-static jfieldID paddingRightField;
-static jfieldID paddingBottomField;
-
-static jfieldID borderLeftField;
-static jfieldID borderTopField;
-static jfieldID borderRightField;
-static jfieldID borderBottomField;
-
-static jfieldID edgeSetFlagField;
-static jfieldID hasNewLayoutField;
-
 class LayoutContext {
  public:
   LayoutContext(jlongArray nativeNodes, jobjectArray javaNodes) {
@@ -84,6 +52,16 @@ class LayoutContext {
     jnode_arr = javaNodes;
   }
 
+  // index of the node's java node in javaNodes, -1 if not found.
+  int32_t indexOf(HPNodeRef node) {
+    auto idx = node_ptr_index_map.find(node);
+    return idx == node_ptr_index_map.end() ? -1 : static_cast<int32_t>(idx->second);
+  }
+
+  size_t size() { return node_ptr_index_map.size(); }
+
+  jobjectArray javaNodes() { return jnode_arr; }
+
   base::android::ScopedJavaLocalRef<jobject> get(HPNodeRef node) {
     JNIEnv* env = GetJNIEnv();
     auto idx = node_ptr_index_map.find(node);
@@ -111,16 +89,8 @@ static HPSize HPJNIMeasureFunc(HPNodeRef node,
       (reinterpret_cast<LayoutContext*>(layoutContext))->get(node);
 
   if (!jnode.is_null()) {
-#ifdef LAYOUT_TIME_ANALYZE
-    clock_t start = clock();
-#endif
     const auto measureResult =
         Java_FlexNode_measureFunc(GetJNIEnv(), jnode.obj(), width, widthMode, height, heightMode);
-#ifdef LAYOUT_TIME_ANALYZE
-    clock_t end = clock();
-    layout_analyze_measureTime += (end - start);
-    layout_analyze_measureCount++;
-#endif
     static_assert(sizeof(measureResult) == 8,
                   "Expected measureResult to be 8 bytes, or two 32 bit ints");
 
@@ -138,107 +108,92 @@ static HPSize HPJNIMeasureFunc(HPNodeRef node,
   }
 }
 
+// measure content nodes of a layout pass in one java call,
+// see FlexNode.setBatchMeasureEnabled. set from ui thread, read by layout.
+static std::atomic<bool> batchMeasureEnabled(false);
+
+static void HPJNIBatchMeasureFunc(HPMeasureRequest* requests,
+                                  uint32_t count,
+                                  void* layoutContext) {
+  ASSERT(layoutContext != nullptr);
+  LayoutContext* context = reinterpret_cast<LayoutContext*>(layoutContext);
+  JNIEnv* env = GetJNIEnv();
+  jclass nodeClass = env->FindClass(kFlexNodeClassPath);
+  jobjectArray nodes = env->NewObjectArray(count, nodeClass, nullptr);
+  jfloatArray sizes = env->NewFloatArray(count * 2);
+  jintArray modes = env->NewIntArray(count * 2);
+  jlongArray results = env->NewLongArray(count);
+  env->DeleteLocalRef(nodeClass);
+
+  std::vector<jfloat> sizeValues(count * 2);
+  std::vector<jint> modeValues(count * 2);
+  for (uint32_t i = 0; i < count; i++) {
+    // request of a node without java node is left null, and falls back below.
+    base::android::ScopedJavaLocalRef<jobject> jnode = context->get(requests[i].node);
+    if (!jnode.is_null()) {
+      env->SetObjectArrayElement(nodes, i, jnode.obj());
+    }
+    sizeValues[i * 2] = requests[i].width;
+    sizeValues[i * 2 + 1] = requests[i].height;
+    modeValues[i * 2] = requests[i].widthMeasureMode;
+    modeValues[i * 2 + 1] = requests[i].heightMeasureMode;
+  }
+  env->SetFloatArrayRegion(sizes, 0, count * 2, sizeValues.data());
+  env->SetIntArrayRegion(modes, 0, count * 2, modeValues.data());
+
+  Java_FlexNode_measureBatchFunc(env, nodes, sizes, modes, results);
+
+  std::vector<jlong> resultValues(count);
+  env->GetLongArrayRegion(results, 0, count, resultValues.data());
+  for (uint32_t i = 0; i < count; i++) {
+    HPMeasureRequest& request = requests[i];
+    jobject jnode = env->GetObjectArrayElement(nodes, i);
+    if (jnode != nullptr) {
+      // packed as HPJNIMeasureFunc's result
+      int32_t wBits = 0xFFFFFFFF & (resultValues[i] >> 32);
+      int32_t hBits = 0xFFFFFFFF & resultValues[i];
+      request.result = HPSize{static_cast<float>(wBits), static_cast<float>(hBits)};
+      env->DeleteLocalRef(jnode);
+    } else {
+      request.result = HPSize{
+          request.widthMeasureMode == 0 ? 0 : request.width,
+          request.heightMeasureMode == 0 ? 0 : request.height,
+      };
+    }
+  }
+
+  env->DeleteLocalRef(nodes);
+  env->DeleteLocalRef(sizes);
+  env->DeleteLocalRef(modes);
+  env->DeleteLocalRef(results);
+}
+
 static jlong FlexNodeNew(JNIEnv* env, const base::android::JavaParamRef<jobject>& jcaller) {
   FlexNode* flex_node = new FlexNode(env, jcaller);
   return reinterpret_cast<intptr_t>(flex_node);
 }
 
-#ifdef LAYOUT_TIME_ANALYZE
-static int FlexNodeCount(HPNodeRef node) {
-  int allCount = node->childCount();
-  for (unsigned int i = 0; i < node->childCount(); i++) {
-    allCount += FlexNodeCount(node->getChild(i));
-  }
-  return allCount;
+static int32_t LayoutExportId(HPNodeRef node, void* layoutContext) {
+  return (reinterpret_cast<LayoutContext*>(layoutContext))->indexOf(node);
 }
-#endif
 
-static void TransferLayoutOutputsRecursive(HPNodeRef node, void* layoutContext) {
-  ASSERT(layoutContext != nullptr);
-  base::android::ScopedJavaLocalRef<jobject> jnode =
-      (reinterpret_cast<LayoutContext*>(layoutContext))->get(node);
-  if (jnode.is_null()) {
+// write layout of nodes with new layout into one buffer, java side copies
+// it to its nodes, see FlexNode.applyLayoutBuffer
+static void TransferLayoutOutputs(HPNodeRef root, LayoutContext* layoutContext) {
+  uint32_t exportFlags = HP_EXPORT_MARGIN | HP_EXPORT_PADDING | HP_EXPORT_BORDER;
+  // a record for every java node at most.
+  std::vector<uint32_t> buffer(layoutContext->size() * HPLayoutExportRecordSize(exportFlags));
+  uint32_t count =
+      HPNodeExportLayout(root, exportFlags, LayoutExportId, layoutContext, buffer.data(),
+                         static_cast<uint32_t>(buffer.size() * sizeof(uint32_t)));
+  if (count == 0) {
     return;
   }
 
   JNIEnv* env = GetJNIEnv();
-  jobject java_node = jnode.obj();
-
-  if (!HPNodeHasNewLayout(node)) {
-#ifdef LAYOUT_TIME_ANALYZE
-    //    if (weakRef && ( localRef = GetJNIEnv()->NewLocalRef( weakRef) ) !=NULL ) {
-    //      JNIEnv* env = GetJNIEnv();
-    static jclass clazz = env->FindClass(kFlexNodeClassPath);
-    static jfieldID widthField = env->GetFieldID(clazz, "mWidth", "F");
-    float javaWidth = env->GetFloatField(java_node, widthField);
-    // static jfieldID hasNewLayoutField = env->GetFieldID( clazz, "mHasNewLayout",  "Z");
-    // hasNewLayout = env->GetBooleanField(weakRef ,hasNewLayoutField );
-    if (!isDefined(javaWidth)) {
-      __android_log_print(ANDROID_LOG_ERROR, "HippyLayoutTime",
-                          "cache width NAN  node's fetchCount %d nodetype %d", node->fetchCount,
-                          node->style.nodeType);
-    }
-//      GetJNIEnv()->DeleteLocalRef( localRef );
-//    }
-#endif
-    return;
-  }
-
-#ifdef LAYOUT_TIME_ANALYZE
-  newLayoutCount++;
-#endif
-  const int MARGIN = 1;
-  const int PADDING = 2;
-  const int BORDER = 4;
-
-  int hasEdgeSetFlag = env->GetIntField(java_node, edgeSetFlagField);
-
-  env->SetFloatField(java_node, widthField, HPNodeLayoutGetWidth(node));
-  env->SetFloatField(java_node, heightField, HPNodeLayoutGetHeight(node));
-  env->SetFloatField(java_node, leftField, HPNodeLayoutGetLeft(node));
-  env->SetFloatField(java_node, topField, HPNodeLayoutGetTop(node));
-
-  if ((hasEdgeSetFlag & MARGIN) == MARGIN) {
-    env->SetFloatField(java_node, marginLeftField,
-                       HPNodeLayoutGetMargin(node, CSSDirection::CSSLeft));
-    env->SetFloatField(java_node, marginTopField,
-                       HPNodeLayoutGetMargin(node, CSSDirection::CSSTop));
-    env->SetFloatField(java_node, marginRightField,
-                       HPNodeLayoutGetMargin(node, CSSDirection::CSSRight));
-    env->SetFloatField(java_node, marginBottomField,
-                       HPNodeLayoutGetMargin(node, CSSDirection::CSSBottom));
-  }
-
-  if ((hasEdgeSetFlag & PADDING) == PADDING) {
-    env->SetFloatField(java_node, paddingLeftField,
-                       HPNodeLayoutGetPadding(node, CSSDirection::CSSLeft));
-    env->SetFloatField(java_node, paddingTopField,
-                       HPNodeLayoutGetPadding(node, CSSDirection::CSSTop));
-    env->SetFloatField(java_node, paddingRightField,
-                       HPNodeLayoutGetPadding(node, CSSDirection::CSSRight));
-    env->SetFloatField(java_node, paddingBottomField,
-                       HPNodeLayoutGetPadding(node, CSSDirection::CSSBottom));
-  }
-
-  if ((hasEdgeSetFlag & BORDER) == BORDER) {
-    env->SetFloatField(java_node, borderLeftField,
-                       HPNodeLayoutGetBorder(node, CSSDirection::CSSLeft));
-    env->SetFloatField(java_node, borderTopField,
-                       HPNodeLayoutGetBorder(node, CSSDirection::CSSTop));
-    env->SetFloatField(java_node, borderRightField,
-                       HPNodeLayoutGetBorder(node, CSSDirection::CSSRight));
-    env->SetFloatField(java_node, borderBottomField,
-                       HPNodeLayoutGetBorder(node, CSSDirection::CSSBottom));
-  }
-
-  env->SetBooleanField(java_node, hasNewLayoutField, true);
-  HPNodesetHasNewLayout(node, false);
-#ifdef LAYOUT_TIME_ANALYZE
-  node->fetchCount++;
-#endif
-  for (unsigned int i = 0; i < node->childCount(); i++) {
-    TransferLayoutOutputsRecursive(node->getChild(i), layoutContext);
-  }
+  jobject byteBuffer = env->NewDirectByteBuffer(buffer.data(), buffer.size() * sizeof(uint32_t));
+  Java_FlexNode_applyLayoutBuffer(env, layoutContext->javaNodes(), byteBuffer, count);
+  env->DeleteLocalRef(byteBuffer);
 }
 
 FlexNode::FlexNode(JNIEnv* env, const base::android::JavaParamRef<jobject>& jcaller) {
@@ -286,40 +241,23 @@ void FlexNode::FlexNodeCalculateLayout(JNIEnv* env,
 
   // __android_log_print(ANDROID_LOG_INFO,  "HippyLayout", "start
   // HPNodeDoLayout===========================================");
-#ifdef LAYOUT_TIME_ANALYZE
-  // clock_t start =  clock();
-  newLayoutCount = 0;
-  struct timeval start, end;
-  gettimeofday(&start, NULL);
-  layout_analyze_measureCount = 0;
-  layout_analyze_measureTime = 0.0f;
-#endif
   if (direction < 0 || direction > 2) {
     direction = 1;  // HPDirection::LTR
   }
 
-  HPNodeDoLayout(mHPNode, width, height, (HPDirection)direction,
-                 reinterpret_cast<void*>(&layoutContext));
-
-#ifdef LAYOUT_TIME_ANALYZE
-  // clock_t end = clock();
-  gettimeofday(&end, NULL);
-  __android_log_print(ANDROID_LOG_INFO, "HippyLayoutTime",
-                      "HPNodeDoLayout %ld ms MeasureCount %d MeasureTime %lf ms",
-                      // (end - start)/(double) CLOCKS_PER_SEC * 1000,
-                      (1000 * (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec) / 1000),
-                      layout_analyze_measureCount,
-                      layout_analyze_measureTime / static_cast<double>(CLOCKS_PER_SEC) * 1000);
-#endif
-  TransferLayoutOutputsRecursive(mHPNode, reinterpret_cast<void*>(&layoutContext));
-#ifdef LAYOUT_TIME_ANALYZE
-  gettimeofday(&start, NULL);
-  __android_log_print(ANDROID_LOG_INFO, "HippyLayoutTime", "TransferLayoutOutputsRecursive %ld ms ",
-                      (1000 * (start.tv_sec - end.tv_sec) + (start.tv_usec - end.tv_usec) / 1000));
-  __android_log_print(ANDROID_LOG_INFO, "HippyLayoutTime",
-                      "FlexNodeCount %d TransferLayoutOutputsRecursive newLayoutCount %d",
-                      FlexNodeCount(mHPNode), newLayoutCount);
-#endif
+  if (batchMeasureEnabled.load(std::memory_order_relaxed)) {
+    HPNodeDoLayoutWithBatchMeasure(mHPNode, width, height, HPJNIBatchMeasureFunc,
+                                   (HPDirection)direction, reinterpret_cast<void*>(&layoutContext));
+  } else {
+    HPNodeDoLayout(mHPNode, width, height, (HPDirection)direction,
+                   reinterpret_cast<void*>(&layoutContext));
+  }
+
+  {
+    // java nodes are all created with the default config.
+    HPTraceScope scope(HPConfigGetDefault()->tracer, "TransferLayoutOutputs");
+    TransferLayoutOutputs(mHPNode, &layoutContext);
+  }
   // HPNodePrint(mHPNode);
   // __android_log_print(ANDROID_LOG_INFO,  "HippyLayout", "end
   // HPNodeDoLayout===========================================");
@@ -342,6 +280,84 @@ void FlexNode::FlexNodeNodeSetHasMeasureFunc(JNIEnv* env,
   HPNodeSetMeasureFunc(mHPNode, hasMeasureFunc ? HPJNIMeasureFunc : NULL);
 }
 
+void FlexNode::FlexNodeSetMeasureContentHash(JNIEnv* env,
+                                             const base::android::JavaParamRef<jobject>& obj,
+                                             jlong contentHash) {
+  FLEX_NODE_LOG("FlexNode::SetMeasureContentHash:%lld ", static_cast<long long>(contentHash));
+  HPNodeSetMeasureContentHash(mHPNode, static_cast<uint64_t>(contentHash));
+}
+
+void FlexNode::FlexNodeSetViewport(JNIEnv* env,
+                                   const base::android::JavaParamRef<jobject>& obj,
+                                   jfloat offset,
+                                   jfloat size,
+                                   jfloat margin,
+                                   jfloat estimatedItemSize) {
+  FLEX_NODE_LOG("FlexNode::SetViewport:%f %f %f %f", offset, size, margin, estimatedItemSize);
+  HPNodeSetViewport(mHPNode, offset, size, margin, estimatedItemSize);
+}
+
+void FlexNode::FlexNodeClearViewport(JNIEnv* env,
+                                     const base::android::JavaParamRef<jobject>& obj) {
+  FLEX_NODE_LOG("FlexNode::ClearViewport");
+  HPNodeClearViewport(mHPNode);
+}
+
+static void FlexNodeSetSharedMeasureCacheCapacity(
+    JNIEnv* env,
+    const base::android::JavaParamRef<jclass>& jcaller,
+    jint capacity) {
+  FLEX_NODE_LOG("FlexNode::SetSharedMeasureCacheCapacity:%d ", capacity);
+  // java nodes are all created with the default config.
+  HPConfigGetDefault()->SetSharedMeasureCacheCapacity(capacity > 0 ? capacity : 0);
+}
+
+static jboolean FlexNodeApplyStyleBuffer(
+    JNIEnv* env,
+    const base::android::JavaParamRef<jclass>& jcaller,
+    const base::android::JavaParamRef<jlongArray>& nativeNodes,
+    const base::android::JavaParamRef<jobject>& buffer,
+    jint size) {
+  FLEX_NODE_LOG("FlexNode::ApplyStyleBuffer:%d ", size);
+  void* data = env->GetDirectBufferAddress(buffer.obj());
+  if (data == nullptr || size < 0 || size > env->GetDirectBufferCapacity(buffer.obj())) {
+    return false;
+  }
+
+  jsize count = env->GetArrayLength(nativeNodes.obj());
+  std::vector<HPNodeRef> nodes(count);
+  jlong* flexNodes = env->GetLongArrayElements(nativeNodes.obj(), nullptr);
+  for (jsize i = 0; i < count; i++) {
+    nodes[i] = _jlong2HPNodeRef(flexNodes[i]);
+  }
+  env->ReleaseLongArrayElements(nativeNodes.obj(), flexNodes, JNI_ABORT);
+  return HPNodeApplyStyleBuffer(nodes.data(), count, data, size);
+}
+
+static void FlexNodeSetBatchMeasureEnabled(JNIEnv* env,
+                                           const base::android::JavaParamRef<jclass>& jcaller,
+                                           jboolean enabled) {
+  FLEX_NODE_LOG("FlexNode::SetBatchMeasureEnabled:%d ", enabled);
+  batchMeasureEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+static void FlexNodeSetTraceEnabled(JNIEnv* env,
+                                    const base::android::JavaParamRef<jclass>& jcaller,
+                                    jboolean enabled) {
+  FLEX_NODE_LOG("FlexNode::SetTraceEnabled:%d ", enabled);
+  HPTracer* tracer = HPConfigGetDefault()->GetTracer();
+  tracer->clear();
+  tracer->setEnabled(enabled);
+}
+
+static base::android::ScopedJavaLocalRef<jstring> FlexNodeGetTraceJson(
+    JNIEnv* env,
+    const base::android::JavaParamRef<jclass>& jcaller) {
+  FLEX_NODE_LOG("FlexNode::GetTraceJson");
+  std::string json = HPConfigGetDefault()->GetTracer()->toChromeTraceJson();
+  return base::android::ScopedJavaLocalRef<jstring>(env, env->NewStringUTF(json.c_str()));
+}
+
 void FlexNode::FlexNodeNodeSetHasBaselineFunc(JNIEnv* env,
                                               const base::android::JavaParamRef<jobject>& obj,
                                               jboolean hasMeasureFunc) {
@@ -548,31 +564,6 @@ jint JNI_OnLoad(JavaVM* vm, void*) {
   // DemoDocument();
   // __android_log_print(ANDROID_LOG_INFO, "FlexBox", "JNI_OnLoad Sucess");
 
-  clazz = env->FindClass(kFlexNodeClassPath);
-
-  widthField = env->GetFieldID(clazz, "mWidth", "F");
-  heightField = env->GetFieldID(clazz, "mHeight", "F");
-  leftField = env->GetFieldID(clazz, "mLeft", "F");
-  topField = env->GetFieldID(clazz, "mTop", "F");
-
-  marginLeftField = env->GetFieldID(clazz, "mMarginLeft", "F");
-  marginTopField = env->GetFieldID(clazz, "mMarginTop", "F");
-  marginRightField = env->GetFieldID(clazz, "mMarginRight", "F");
-  marginBottomField = env->GetFieldID(clazz, "mMarginBottom", "F");
-
-  paddingLeftField = env->GetFieldID(clazz, "mPaddingLeft", "F");
-  paddingTopField = env->GetFieldID(clazz, "mPaddingTop", "F");
-  paddingRightField = env->GetFieldID(clazz, "mPaddingRight", "F");
-  paddingBottomField = env->GetFieldID(clazz, "mPaddingBottom", "F");
-
-  borderLeftField = env->GetFieldID(clazz, "mBorderLeft", "F");
-  borderTopField = env->GetFieldID(clazz, "mBorderTop", "F");
-  borderRightField = env->GetFieldID(clazz, "mBorderRight", "F");
-  borderBottomField = env->GetFieldID(clazz, "mBorderBottom", "F");
-
-  edgeSetFlagField = env->GetFieldID(clazz, "mEdgeSetFlag", "I");
-  hasNewLayoutField = env->GetFieldID(clazz, "mHasNewLayout", "Z");
-
   return JNI_VERSION_1_4;
 }
 
@@ -56,6 +56,16 @@ class FlexNode {
   void FlexNodeNodeSetHasMeasureFunc(JNIEnv* env,
                                      const base::android::JavaParamRef<jobject>& obj,
                                      jboolean hasMeasureFunc);
+  void FlexNodeSetMeasureContentHash(JNIEnv* env,
+                                     const base::android::JavaParamRef<jobject>& obj,
+                                     jlong contentHash);
+  void FlexNodeSetViewport(JNIEnv* env,
+                           const base::android::JavaParamRef<jobject>& obj,
+                           jfloat offset,
+                           jfloat size,
+                           jfloat margin,
+                           jfloat estimatedItemSize);
+  void FlexNodeClearViewport(JNIEnv* env, const base::android::JavaParamRef<jobject>& obj);
   void FlexNodeNodeSetHasBaselineFunc(JNIEnv* env,
                                       const base::android::JavaParamRef<jobject>& obj,
                                       jboolean hasMeasureFunc);
@@ -458,6 +458,105 @@ Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeNodeSetHasMeasureFunc(
       env, base::android::JavaParamRef<jobject>(env, jcaller), hasMeasureFunc);
 }
 
+JNI_GENERATOR_EXPORT void
+Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetMeasureContentHash(
+    JNIEnv* env,
+    jobject jcaller,
+    jlong nativePointer,
+    jlong contentHash) {
+  FlexNode* native = reinterpret_cast<FlexNode*>(nativePointer);
+  CHECK_NATIVE_PTR(env, jcaller, native, "FlexNodeSetMeasureContentHash");
+  return native->FlexNodeSetMeasureContentHash(
+      env, base::android::JavaParamRef<jobject>(env, jcaller), contentHash);
+}
+
+JNI_GENERATOR_EXPORT void Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetViewport(
+    JNIEnv* env,
+    jobject jcaller,
+    jlong nativePointer,
+    jfloat offset,
+    jfloat size,
+    jfloat margin,
+    jfloat estimatedItemSize) {
+  FlexNode* native = reinterpret_cast<FlexNode*>(nativePointer);
+  CHECK_NATIVE_PTR(env, jcaller, native, "FlexNodeSetViewport");
+  return native->FlexNodeSetViewport(env, base::android::JavaParamRef<jobject>(env, jcaller),
+                                     offset, size, margin, estimatedItemSize);
+}
+
+JNI_GENERATOR_EXPORT void Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeClearViewport(
+    JNIEnv* env,
+    jobject jcaller,
+    jlong nativePointer) {
+  FlexNode* native = reinterpret_cast<FlexNode*>(nativePointer);
+  CHECK_NATIVE_PTR(env, jcaller, native, "FlexNodeClearViewport");
+  return native->FlexNodeClearViewport(env, base::android::JavaParamRef<jobject>(env, jcaller));
+}
+
+static void FlexNodeSetSharedMeasureCacheCapacity(
+    JNIEnv* env,
+    const base::android::JavaParamRef<jclass>& jcaller,
+    jint capacity);
+
+JNI_GENERATOR_EXPORT void
+Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetSharedMeasureCacheCapacity(
+    JNIEnv* env,
+    jclass jcaller,
+    jint capacity) {
+  return FlexNodeSetSharedMeasureCacheCapacity(
+      env, base::android::JavaParamRef<jclass>(env, jcaller), capacity);
+}
+
+static jboolean FlexNodeApplyStyleBuffer(
+    JNIEnv* env,
+    const base::android::JavaParamRef<jclass>& jcaller,
+    const base::android::JavaParamRef<jlongArray>& nativeNodes,
+    const base::android::JavaParamRef<jobject>& buffer,
+    jint size);
+
+JNI_GENERATOR_EXPORT jboolean
+Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeApplyStyleBuffer(JNIEnv* env,
+                                                                      jclass jcaller,
+                                                                      jlongArray nativeNodes,
+                                                                      jobject buffer,
+                                                                      jint size) {
+  return FlexNodeApplyStyleBuffer(env, base::android::JavaParamRef<jclass>(env, jcaller),
+                                  base::android::JavaParamRef<jlongArray>(env, nativeNodes),
+                                  base::android::JavaParamRef<jobject>(env, buffer), size);
+}
+
+static void FlexNodeSetBatchMeasureEnabled(JNIEnv* env,
+                                           const base::android::JavaParamRef<jclass>& jcaller,
+                                           jboolean enabled);
+
+JNI_GENERATOR_EXPORT void
+Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetBatchMeasureEnabled(JNIEnv* env,
+                                                                            jclass jcaller,
+                                                                            jboolean enabled) {
+  return FlexNodeSetBatchMeasureEnabled(env, base::android::JavaParamRef<jclass>(env, jcaller),
+                                        enabled);
+}
+
+static void FlexNodeSetTraceEnabled(JNIEnv* env,
+                                    const base::android::JavaParamRef<jclass>& jcaller,
+                                    jboolean enabled);
+
+JNI_GENERATOR_EXPORT void
+Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetTraceEnabled(JNIEnv* env,
+                                                                     jclass jcaller,
+                                                                     jboolean enabled) {
+  return FlexNodeSetTraceEnabled(env, base::android::JavaParamRef<jclass>(env, jcaller), enabled);
+}
+
+static base::android::ScopedJavaLocalRef<jstring> FlexNodeGetTraceJson(
+    JNIEnv* env,
+    const base::android::JavaParamRef<jclass>& jcaller);
+
+JNI_GENERATOR_EXPORT jstring
+Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeGetTraceJson(JNIEnv* env, jclass jcaller) {
+  return FlexNodeGetTraceJson(env, base::android::JavaParamRef<jclass>(env, jcaller)).Release();
+}
+
 JNI_GENERATOR_EXPORT void
 Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeNodeSetHasBaselineFunc(
     JNIEnv* env,
@@ -528,6 +627,42 @@ static jlong Java_FlexNode_measureFunc(JNIEnv* env,
   return ret;
 }
 
+static void Java_FlexNode_measureBatchFunc(JNIEnv* env,
+                                           jobjectArray nodes,
+                                           jfloatArray sizes,
+                                           jintArray modes,
+                                           jlongArray results) {
+  jclass clazz = env->FindClass(kFlexNodeClassPath);
+  jmethodID method_id = env->GetStaticMethodID(clazz, "measureBatchFunc",
+                                               "("
+                                               "[Lcom/tencent/smtt/flexbox/FlexNode;"
+                                               "[F"
+                                               "[I"
+                                               "[J"
+                                               ")"
+                                               "V");
+  env->CallStaticVoidMethod(clazz, method_id, nodes, sizes, modes, results);
+
+  env->DeleteLocalRef(clazz);
+}
+
+static void Java_FlexNode_applyLayoutBuffer(JNIEnv* env,
+                                            jobjectArray nodes,
+                                            jobject buffer,
+                                            jint count) {
+  jclass clazz = env->FindClass(kFlexNodeClassPath);
+  jmethodID method_id = env->GetStaticMethodID(clazz, "applyLayoutBuffer",
+                                               "("
+                                               "[Lcom/tencent/smtt/flexbox/FlexNode;"
+                                               "Ljava/nio/ByteBuffer;"
+                                               "I"
+                                               ")"
+                                               "V");
+  env->CallStaticVoidMethod(clazz, method_id, nodes, buffer, count);
+
+  env->DeleteLocalRef(clazz);
+}
+
 // Step 3: RegisterNatives.
 
 static const JNINativeMethod kMethodsFlexNode[] = {
@@ -824,6 +959,64 @@ static const JNINativeMethod kMethodsFlexNode[] = {
      "V",
      reinterpret_cast<void*>(
          Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeNodeSetHasMeasureFunc)},
+    {"nativeFlexNodeSetMeasureContentHash",
+     "("
+     "J"
+     "J"
+     ")"
+     "V",
+     reinterpret_cast<void*>(
+         Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetMeasureContentHash)},
+    {"nativeFlexNodeSetViewport",
+     "("
+     "J"
+     "F"
+     "F"
+     "F"
+     "F"
+     ")"
+     "V",
+     reinterpret_cast<void*>(Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetViewport)},
+    {"nativeFlexNodeClearViewport",
+     "("
+     "J"
+     ")"
+     "V",
+     reinterpret_cast<void*>(Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeClearViewport)},
+    {"nativeFlexNodeSetSharedMeasureCacheCapacity",
+     "("
+     "I"
+     ")"
+     "V",
+     reinterpret_cast<void*>(
+         Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetSharedMeasureCacheCapacity)},
+    {"nativeFlexNodeApplyStyleBuffer",
+     "("
+     "[J"
+     "Ljava/nio/ByteBuffer;"
+     "I"
+     ")"
+     "Z",
+     reinterpret_cast<void*>(
+         Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeApplyStyleBuffer)},
+    {"nativeFlexNodeSetBatchMeasureEnabled",
+     "("
+     "Z"
+     ")"
+     "V",
+     reinterpret_cast<void*>(
+         Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetBatchMeasureEnabled)},
+    {"nativeFlexNodeSetTraceEnabled",
+     "("
+     "Z"
+     ")"
+     "V",
+     reinterpret_cast<void*>(Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeSetTraceEnabled)},
+    {"nativeFlexNodeGetTraceJson",
+     "("
+     ")"
+     "Ljava/lang/String;",
+     reinterpret_cast<void*>(Java_com_tencent_smtt_flexbox_FlexNode_nativeFlexNodeGetTraceJson)},
     {"nativeFlexNodeNodeSetHasBaselineFunc",
      "("
      "J"
@@ -0,0 +1,214 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module is the harness shared by hippy and yoga layout benchmarks.
+ * a scenario is run repetitions times after a few warmup runs, only the part
+ * between timer.start() and timer.stop() is measured. besides latency
+ * percentiles, heap allocations, their bytes and measure callbacks happened
+ * in the measured part are reported, results can be written to a json file for
+ * regression tracking:
+ *   <benchmark> [--repetitions N] [--warmup N] [--filter TEXT] [--json PATH]
+ * it defines global operator new, include it in one translation unit only,
+ * and ahead of engine headers.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// heap allocations of the whole process, counted by operator new below.
+static uint64_t gBenchmarkAllocationCount = 0;
+static uint64_t gBenchmarkAllocatedBytes = 0;
+// measure callbacks, counted by measure functions of scenarios.
+static uint64_t gBenchmarkMeasureCount = 0;
+
+void* operator new(size_t size) {
+  gBenchmarkAllocationCount++;
+  gBenchmarkAllocatedBytes += size;
+  return malloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+class LayoutBenchmarkTimer {
+ public:
+  void start() {
+    allocationsAtStart = gBenchmarkAllocationCount;
+    bytesAtStart = gBenchmarkAllocatedBytes;
+    measuresAtStart = gBenchmarkMeasureCount;
+    startTime = std::chrono::steady_clock::now();
+  }
+  void stop() {
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    elapsedMs += std::chrono::duration<double, std::milli>(end - startTime).count();
+    allocations += gBenchmarkAllocationCount - allocationsAtStart;
+    allocatedBytes += gBenchmarkAllocatedBytes - bytesAtStart;
+    measures += gBenchmarkMeasureCount - measuresAtStart;
+  }
+
+ public:
+  double elapsedMs = 0;
+  uint64_t allocations = 0;
+  uint64_t allocatedBytes = 0;
+  uint64_t measures = 0;
+
+ private:
+  std::chrono::steady_clock::time_point startTime;
+  uint64_t allocationsAtStart = 0;
+  uint64_t bytesAtStart = 0;
+  uint64_t measuresAtStart = 0;
+};
+
+struct LayoutBenchmarkResult {
+  std::string name;
+  uint32_t repetitions;
+  double meanMs;
+  double minMs;
+  double p50Ms;
+  double p90Ms;
+  double p99Ms;
+  double maxMs;
+  // per repetition
+  double allocations;
+  double allocatedBytes;
+  double measures;
+};
+
+class LayoutBenchmark {
+ public:
+  LayoutBenchmark(const char* engine, int argc, char const* argv[])
+      : engine(engine), repetitions(100), warmup(5), filter(nullptr), jsonPath(nullptr) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+      if (strcmp(argv[i], "--repetitions") == 0) {
+        repetitions = std::max(atoi(argv[i + 1]), 1);
+      } else if (strcmp(argv[i], "--warmup") == 0) {
+        warmup = std::max(atoi(argv[i + 1]), 0);
+      } else if (strcmp(argv[i], "--filter") == 0) {
+        filter = argv[i + 1];
+      } else if (strcmp(argv[i], "--json") == 0) {
+        jsonPath = argv[i + 1];
+      }
+    }
+  }
+
+  // body is called as body(LayoutBenchmarkTimer&) once per repetition.
+  template <class Body>
+  void run(const char* name, Body body) {
+    if (filter != nullptr && strstr(name, filter) == nullptr) {
+      return;
+    }
+    for (uint32_t i = 0; i < warmup; i++) {
+      LayoutBenchmarkTimer timer;
+      body(timer);
+    }
+    std::vector<double> times;
+    times.reserve(repetitions);
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t measures = 0;
+    for (uint32_t i = 0; i < repetitions; i++) {
+      LayoutBenchmarkTimer timer;
+      body(timer);
+      times.push_back(timer.elapsedMs);
+      allocations += timer.allocations;
+      allocatedBytes += timer.allocatedBytes;
+      measures += timer.measures;
+    }
+    std::sort(times.begin(), times.end());
+    LayoutBenchmarkResult result;
+    result.name = name;
+    result.repetitions = repetitions;
+    double sum = 0;
+    for (size_t i = 0; i < times.size(); i++) {
+      sum += times[i];
+    }
+    result.meanMs = sum / times.size();
+    result.minMs = times.front();
+    result.p50Ms = percentile(times, 50);
+    result.p90Ms = percentile(times, 90);
+    result.p99Ms = percentile(times, 99);
+    result.maxMs = times.back();
+    result.allocations = static_cast<double>(allocations) / repetitions;
+    result.allocatedBytes = static_cast<double>(allocatedBytes) / repetitions;
+    result.measures = static_cast<double>(measures) / repetitions;
+    results.push_back(result);
+    printf("%-56s p50 %9.4lf ms  p90 %9.4lf ms  p99 %9.4lf ms  alloc %10.1lf  measure %9.1lf\n",
+           name, result.p50Ms, result.p90Ms, result.p99Ms, result.allocations, result.measures);
+  }
+
+  // write results to --json path if given, return false on io error.
+  bool writeJson() {
+    if (jsonPath == nullptr) {
+      return true;
+    }
+    FILE* file = fopen(jsonPath, "w");
+    if (file == nullptr) {
+      fprintf(stderr, "can't open %s\n", jsonPath);
+      return false;
+    }
+    fprintf(file, "{\n  \"engine\": \"%s\",\n  \"repetitions\": %u,\n  \"results\": [\n", engine,
+            repetitions);
+    for (size_t i = 0; i < results.size(); i++) {
+      const LayoutBenchmarkResult& r = results[i];
+      fprintf(file,
+              "    {\"name\": \"%s\", \"mean_ms\": %.6lf, \"min_ms\": %.6lf, \"p50_ms\": %.6lf, "
+              "\"p90_ms\": %.6lf, \"p99_ms\": %.6lf, \"max_ms\": %.6lf, "
+              "\"allocations\": %.1lf, \"allocated_bytes\": %.1lf, \"measure_calls\": %.1lf}%s\n",
+              escape(r.name).c_str(), r.meanMs, r.minMs, r.p50Ms, r.p90Ms, r.p99Ms, r.maxMs,
+              r.allocations, r.allocatedBytes, r.measures, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+  }
+
+ private:
+  // nearest-rank percentile of sorted times.
+  static double percentile(const std::vector<double>& sorted, uint32_t p) {
+    size_t rank = (sorted.size() * p + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+  }
+
+  static std::string escape(const std::string& text) {
+    std::string escaped;
+    for (size_t i = 0; i < text.size(); i++) {
+      if (text[i] == '"' || text[i] == '\\') {
+        escaped += '\\';
+      }
+      escaped += text[i];
+    }
+    return escaped;
+  }
+
+ private:
+  const char* engine;
+  uint32_t repetitions;
+  uint32_t warmup;
+  const char* filter;
+  const char* jsonPath;
+  std::vector<LayoutBenchmarkResult> results;
+};
@@ -0,0 +1,340 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module generates random style trees for differential layout runs,
+ * see layout/benchmark/diff. a tree is a plain description independent of
+ * engines, it's fully determined by its seed, so a tree found diverging or
+ * slow can be generated again from the seed alone. values are picked from
+ * small sets around the container sizes to hit the edge cases of wrap,
+ * min/max clamping, flex basis and text measure more often than uniform
+ * random values would.
+ * trees are built into an engine by an adapter E, which provides:
+ *   typedef ... Node;
+ *   static Node newNode();
+ *   static void insertChild(Node parent, Node child);  // append
+ *   static void applyStyle(Node, const FuzzStyle&);
+ *   static void setText(Node, uint32_t chars);  // measured by
+ *                                               // measureBenchmarkText
+ * LayoutScenarios.h must be included ahead of this file.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+typedef enum {
+  FuzzDirectionRow,
+  FuzzDirectionRowReverse,
+  FuzzDirectionColumn,
+  FuzzDirectionColumnReverse,
+} FuzzDirection;
+
+typedef enum {
+  FuzzWrapNone,
+  FuzzWrapWrap,
+  FuzzWrapReverse,
+} FuzzWrap;
+
+// justify content uses start to space evenly, align items and align self
+// use auto to stretch, align content uses start to space around.
+typedef enum {
+  FuzzAlignAuto,
+  FuzzAlignStart,
+  FuzzAlignCenter,
+  FuzzAlignEnd,
+  FuzzAlignStretch,
+  FuzzAlignSpaceBetween,
+  FuzzAlignSpaceAround,
+  FuzzAlignSpaceEvenly,
+} FuzzAlign;
+
+// edges are left, top, right, bottom.
+#define FUZZ_EDGES_COUNT 4
+
+// NAN is not set for sizes, flex basis and edges.
+typedef struct {
+  uint8_t direction;
+  uint8_t wrap;
+  uint8_t justifyContent;
+  uint8_t alignItems;
+  uint8_t alignSelf;
+  uint8_t alignContent;
+  bool absolute;
+  bool displayNone;
+  float width;
+  float height;
+  float minWidth;
+  float minHeight;
+  float maxWidth;
+  float maxHeight;
+  float flexGrow;
+  float flexShrink;
+  float flexBasis;
+  float margin[FUZZ_EDGES_COUNT];
+  float padding[FUZZ_EDGES_COUNT];
+  float border[FUZZ_EDGES_COUNT];
+  // only for absolute nodes
+  float position[FUZZ_EDGES_COUNT];
+} FuzzStyle;
+
+typedef struct {
+  FuzzStyle style;
+  // index of parent in FuzzTree::nodes, -1 for root.
+  int32_t parent;
+  uint32_t depth;
+  // text leaf if it's not 0
+  uint32_t textChars;
+} FuzzNode;
+
+typedef struct {
+  uint64_t seed;
+  // pre-order, a parent is always ahead of its children.
+  std::vector<FuzzNode> nodes;
+  // available size of root, NAN for undefined.
+  float width;
+  float height;
+} FuzzTree;
+
+// xorshift64*, same sequence on every platform.
+class FuzzRandom {
+ public:
+  explicit FuzzRandom(uint64_t seed) : state(seed != 0 ? seed : 0x9E3779B97F4A7C15ULL) {}
+  uint64_t next() {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+  }
+  uint32_t below(uint32_t count) { return static_cast<uint32_t>(next() % count); }
+  bool chance(uint32_t percent) { return below(100) < percent; }
+  template <size_t N>
+  float pick(const float (&values)[N]) {
+    return values[below(N)];
+  }
+
+ private:
+  uint64_t state;
+};
+
+// seed of index-th tree of a run, neighbour trees get unrelated seeds.
+static inline uint64_t fuzzTreeSeed(uint64_t runSeed, uint32_t index) {
+  // splitmix64
+  uint64_t z = runSeed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static void generateFuzzStyle(FuzzRandom& random, bool isRoot, FuzzStyle* style) {
+  static const float sizes[] = {0, 10, 25, 50, 100, 200, 400};
+  static const float minSizes[] = {0, 20, 60, 150};
+  static const float maxSizes[] = {10, 40, 100, 300};
+  static const float grows[] = {1, 2, 0.5f};
+  static const float shrinks[] = {0, 1, 1, 2};
+  static const float bases[] = {0, 20, 80, 200};
+  static const float edges[] = {0, 2, 5, 10};
+  static const float positions[] = {0, 5, 20};
+
+  uint32_t direction = random.below(10);
+  style->direction = direction < 4   ? FuzzDirectionColumn
+                     : direction < 8 ? FuzzDirectionRow
+                     : direction < 9 ? FuzzDirectionRowReverse
+                                     : FuzzDirectionColumnReverse;
+  uint32_t wrap = random.below(20);
+  style->wrap = wrap < 14 ? FuzzWrapNone : wrap < 19 ? FuzzWrapWrap : FuzzWrapReverse;
+  style->justifyContent = FuzzAlignStart + random.below(3);
+  if (random.chance(30)) {
+    style->justifyContent = FuzzAlignSpaceBetween + random.below(3);
+  }
+  style->alignItems = random.chance(40) ? FuzzAlignStretch : FuzzAlignStart + random.below(3);
+  style->alignSelf = random.chance(80) ? FuzzAlignAuto : FuzzAlignStart + random.below(4);
+  style->alignContent = random.chance(50) ? FuzzAlignStart : FuzzAlignCenter + random.below(5);
+  if (style->alignContent == FuzzAlignSpaceEvenly) {
+    style->alignContent = FuzzAlignStart;
+  }
+  style->absolute = !isRoot && random.chance(10);
+  style->displayNone = !isRoot && random.chance(3);
+
+  style->width = random.chance(50) ? NAN : random.pick(sizes);
+  style->height = random.chance(55) ? NAN : random.pick(sizes);
+  // min greater than max happens too, min wins in both engines.
+  style->minWidth = random.chance(15) ? random.pick(minSizes) : NAN;
+  style->minHeight = random.chance(15) ? random.pick(minSizes) : NAN;
+  style->maxWidth = random.chance(15) ? random.pick(maxSizes) : NAN;
+  style->maxHeight = random.chance(15) ? random.pick(maxSizes) : NAN;
+  style->flexGrow = random.chance(60) ? 0 : random.pick(grows);
+  style->flexShrink = random.pick(shrinks);
+  style->flexBasis = random.chance(70) ? NAN : random.pick(bases);
+
+  bool hasMargin = random.chance(30);
+  bool hasPadding = random.chance(30);
+  bool hasBorder = random.chance(15);
+  for (int i = 0; i < FUZZ_EDGES_COUNT; i++) {
+    style->margin[i] = hasMargin && random.chance(70) ? random.pick(edges) : NAN;
+    style->padding[i] = hasPadding && random.chance(70) ? random.pick(edges) : NAN;
+    style->border[i] = hasBorder && random.chance(70) ? random.pick(edges) : NAN;
+    style->position[i] = style->absolute && random.chance(50) ? random.pick(positions) : NAN;
+  }
+}
+
+// a tree of 1 to maxNodes nodes, at most maxDepth levels below root.
+static FuzzTree generateFuzzTree(uint64_t seed, uint32_t maxNodes, uint32_t maxDepth) {
+  static const float rootSizes[] = {100, 360, 1080};
+
+  FuzzRandom random(seed);
+  FuzzTree tree;
+  tree.seed = seed;
+  tree.width = random.chance(85) ? random.pick(rootSizes) : NAN;
+  tree.height = random.chance(30) ? random.pick(rootSizes) : NAN;
+  uint32_t count = 1 + random.below(maxNodes > 0 ? maxNodes : 1);
+
+  FuzzNode root;
+  generateFuzzStyle(random, true, &root.style);
+  root.parent = -1;
+  root.depth = 0;
+  root.textChars = 0;
+  tree.nodes.push_back(root);
+  // nodes are appended as the last child of a random container on the
+  // rightmost path, which keeps pre-order, deeper paths get more children.
+  std::vector<int32_t> path(1, 0);
+  while (tree.nodes.size() < count) {
+    size_t level = path.size() - 1 - random.below(std::min<uint32_t>(path.size(), 3));
+    path.resize(level + 1);
+    FuzzNode node;
+    generateFuzzStyle(random, false, &node.style);
+    node.parent = path.back();
+    node.depth = level + 1;
+    node.textChars = 0;
+    tree.nodes.push_back(node);
+    if (node.depth < maxDepth && random.chance(45)) {
+      path.push_back(tree.nodes.size() - 1);
+    }
+  }
+
+  // leaves have text at times, text nodes have no children.
+  std::vector<bool> hasChildren(tree.nodes.size(), false);
+  for (size_t i = 1; i < tree.nodes.size(); i++) {
+    hasChildren[tree.nodes[i].parent] = true;
+  }
+  for (size_t i = 1; i < tree.nodes.size(); i++) {
+    if (!hasChildren[i] && random.chance(40)) {
+      tree.nodes[i].textChars = 1 + random.below(120);
+    }
+  }
+  return tree;
+}
+
+// nodes of tree in engine E, in the order of tree.nodes, nodes[0] is root.
+template <class E>
+std::vector<typename E::Node> buildFuzzTree(const FuzzTree& tree) {
+  std::vector<typename E::Node> nodes;
+  nodes.reserve(tree.nodes.size());
+  for (size_t i = 0; i < tree.nodes.size(); i++) {
+    const FuzzNode& desc = tree.nodes[i];
+    typename E::Node node = E::newNode();
+    E::applyStyle(node, desc.style);
+    if (desc.textChars > 0) {
+      E::setText(node, desc.textChars);
+    }
+    if (desc.parent >= 0) {
+      E::insertChild(nodes[desc.parent], node);
+    }
+    nodes.push_back(node);
+  }
+  return nodes;
+}
+
+// nodes not laid out because they or an ancestor are display none.
+static std::vector<bool> fuzzHiddenNodes(const FuzzTree& tree) {
+  std::vector<bool> hidden(tree.nodes.size(), false);
+  for (size_t i = 0; i < tree.nodes.size(); i++) {
+    const FuzzNode& node = tree.nodes[i];
+    hidden[i] = node.style.displayNone || (node.parent >= 0 && hidden[node.parent]);
+  }
+  return hidden;
+}
+
+// one line of css-like text for a node, set properties only.
+static std::string describeFuzzNode(const FuzzNode& node) {
+  static const char* directions[] = {"row", "row-reverse", "column", "column-reverse"};
+  static const char* wraps[] = {"nowrap", "wrap", "wrap-reverse"};
+  static const char* aligns[] = {"auto",          "flex-start",   "center",       "flex-end",
+                                 "stretch",       "space-between", "space-around", "space-evenly"};
+  static const char* edgeNames[] = {"left", "top", "right", "bottom"};
+
+  const FuzzStyle& style = node.style;
+  std::string text;
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "flex-direction: %s; ", directions[style.direction]);
+  text += buffer;
+  if (style.wrap != FuzzWrapNone) {
+    snprintf(buffer, sizeof(buffer), "flex-wrap: %s; ", wraps[style.wrap]);
+    text += buffer;
+  }
+  snprintf(buffer, sizeof(buffer), "justify-content: %s; align-items: %s; ",
+           aligns[style.justifyContent], aligns[style.alignItems]);
+  text += buffer;
+  if (style.alignSelf != FuzzAlignAuto) {
+    snprintf(buffer, sizeof(buffer), "align-self: %s; ", aligns[style.alignSelf]);
+    text += buffer;
+  }
+  if (style.alignContent != FuzzAlignStart) {
+    snprintf(buffer, sizeof(buffer), "align-content: %s; ", aligns[style.alignContent]);
+    text += buffer;
+  }
+  if (style.absolute) {
+    text += "position: absolute; ";
+  }
+  if (style.displayNone) {
+    text += "display: none; ";
+  }
+  const char* sizeNames[] = {"width", "height", "min-width", "min-height", "max-width",
+                             "max-height", "flex-basis"};
+  const float sizeValues[] = {style.width,     style.height,    style.minWidth, style.minHeight,
+                              style.maxWidth, style.maxHeight, style.flexBasis};
+  for (int i = 0; i < 7; i++) {
+    if (!isnan(sizeValues[i])) {
+      snprintf(buffer, sizeof(buffer), "%s: %g; ", sizeNames[i], sizeValues[i]);
+      text += buffer;
+    }
+  }
+  snprintf(buffer, sizeof(buffer), "flex-grow: %g; flex-shrink: %g; ", style.flexGrow,
+           style.flexShrink);
+  text += buffer;
+  for (int i = 0; i < FUZZ_EDGES_COUNT; i++) {
+    const float values[] = {style.margin[i], style.padding[i], style.border[i],
+                            style.position[i]};
+    const char* prefixes[] = {"margin-", "padding-", "border-", ""};
+    for (int j = 0; j < 4; j++) {
+      if (!isnan(values[j])) {
+        snprintf(buffer, sizeof(buffer), "%s%s: %g; ", prefixes[j], edgeNames[i], values[j]);
+        text += buffer;
+      }
+    }
+  }
+  if (node.textChars > 0) {
+    snprintf(buffer, sizeof(buffer), "text: %u chars; ", node.textChars);
+    text += buffer;
+  }
+  return text;
+}
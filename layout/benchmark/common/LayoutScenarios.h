@@ -0,0 +1,316 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module holds layout scenarios shared by hippy and yoga benchmarks,
+ * so both engines are measured on the same trees. scenarios are written
+ * against an engine adapter E, which provides:
+ *   typedef ... Node;
+ *   static Node newNode();
+ *   static void insertChild(Node parent, Node child);  // append
+ *   static void freeRecursive(Node node);
+ *   static void setWidth/setHeight/setFlexGrow/setFlexShrink(Node, float);
+ *   static void setMargin/setPadding/setBorder(Node, float);  // all edges
+ *   static void setRow(Node);  static void setWrap(Node);
+ *   static void setAbsolute(Node);
+ *   static void setLeft/setTop/setRight/setBottom(Node, float);
+ *   static void setText(Node, uint32_t chars);  // measured by
+ *                                               // measureBenchmarkText
+ *   static void markDirty(Node);
+ *   static void layout(Node root, float width, float height);  // NAN for undefined
+ * LayoutBenchmark.h must be included ahead of this file.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include <vector>
+
+// text of chars characters, 7 wide and 20 high each, wrapped into lines of
+// width if it's defined.
+static inline void measureBenchmarkText(uint32_t chars,
+                                        float width,
+                                        bool widthDefined,
+                                        float* measuredWidth,
+                                        float* measuredHeight) {
+  gBenchmarkMeasureCount++;
+  float textWidth = chars * 7.0f;
+  if (!widthDefined || textWidth <= width) {
+    *measuredWidth = textWidth;
+    *measuredHeight = 20;
+    return;
+  }
+  uint32_t charsPerLine = width >= 7 ? static_cast<uint32_t>(width / 7) : 1;
+  uint32_t lines = (chars + charsPerLine - 1) / charsPerLine;
+  *measuredWidth = charsPerLine * 7.0f;
+  *measuredHeight = lines * 20.0f;
+}
+
+// 10 x 10 x 10 x 10 nested nodes, the leaves always have width & height,
+// the others have them only if hasStyleSize is true.
+template <class E>
+typename E::Node buildHugeNested(bool hasStyleSize) {
+  typename E::Node root = E::newNode();
+  std::vector<typename E::Node> level(1, root);
+  for (uint32_t depth = 0; depth < 4; depth++) {
+    std::vector<typename E::Node> next;
+    for (size_t i = 0; i < level.size(); i++) {
+      for (uint32_t j = 0; j < 10; j++) {
+        typename E::Node child = E::newNode();
+        if (depth % 2 == 1) {
+          E::setRow(child);
+        }
+        E::setFlexGrow(child, 1);
+        if (hasStyleSize || depth == 3) {
+          E::setWidth(child, 10);
+          E::setHeight(child, 10);
+        }
+        E::insertChild(level[i], child);
+        next.push_back(child);
+      }
+    }
+    level.swap(next);
+  }
+  return root;
+}
+
+// a chain of depth row containers, each holds two fixed leaves and the next
+// level growing between them.
+template <class E>
+typename E::Node buildDeepNesting(uint32_t depth) {
+  typename E::Node root = E::newNode();
+  typename E::Node container = root;
+  for (uint32_t i = 0; i < depth; i++) {
+    if (i % 2 == 0) {
+      E::setRow(container);
+    }
+    E::setPadding(container, 1);
+    typename E::Node start = E::newNode();
+    E::setWidth(start, 4);
+    E::setHeight(start, 4);
+    E::insertChild(container, start);
+    typename E::Node next = E::newNode();
+    E::setFlexGrow(next, 1);
+    E::insertChild(container, next);
+    typename E::Node end = E::newNode();
+    E::setWidth(end, 4);
+    E::setHeight(end, 4);
+    E::insertChild(container, end);
+    container = next;
+  }
+  E::setText(container, 20);
+  return root;
+}
+
+// row wrapped grid of count items with uneven heights and margins.
+template <class E>
+typename E::Node buildWrappedGrid(uint32_t count) {
+  typename E::Node root = E::newNode();
+  E::setRow(root);
+  E::setWrap(root);
+  for (uint32_t i = 0; i < count; i++) {
+    typename E::Node item = E::newNode();
+    E::setWidth(item, 100);
+    E::setHeight(item, 100 + i % 3 * 10);
+    E::setMargin(item, 4);
+    E::setFlexGrow(item, i % 4 == 0 ? 1 : 0);
+    E::insertChild(root, item);
+  }
+  return root;
+}
+
+// a feed of rows: avatar, then a column of title and body text.
+// texts are appended to texts if it's not null.
+template <class E>
+typename E::Node buildTextList(uint32_t rows, std::vector<typename E::Node>* texts) {
+  typename E::Node root = E::newNode();
+  for (uint32_t i = 0; i < rows; i++) {
+    typename E::Node row = E::newNode();
+    E::setRow(row);
+    E::setPadding(row, 8);
+    E::insertChild(root, row);
+    typename E::Node avatar = E::newNode();
+    E::setWidth(avatar, 40);
+    E::setHeight(avatar, 40);
+    E::setMargin(avatar, 4);
+    E::insertChild(row, avatar);
+    typename E::Node column = E::newNode();
+    E::setFlexGrow(column, 1);
+    E::setFlexShrink(column, 1);
+    E::insertChild(row, column);
+    typename E::Node title = E::newNode();
+    E::setText(title, 10 + i % 20);
+    E::insertChild(column, title);
+    typename E::Node body = E::newNode();
+    E::setText(body, 40 + (i * 37) % 200);
+    E::insertChild(column, body);
+    if (texts != nullptr) {
+      texts->push_back(title);
+      texts->push_back(body);
+    }
+  }
+  return root;
+}
+
+// count absolutely positioned cards, inset by left/top or right/bottom.
+template <class E>
+typename E::Node buildAbsoluteItems(uint32_t count) {
+  typename E::Node root = E::newNode();
+  for (uint32_t i = 0; i < count; i++) {
+    typename E::Node item = E::newNode();
+    E::setAbsolute(item);
+    if (i % 2 == 0) {
+      E::setLeft(item, i % 50 * 20.0f);
+      E::setTop(item, i / 50 * 40.0f);
+      E::setWidth(item, 100);
+      E::setHeight(item, 40);
+    } else {
+      E::setLeft(item, i % 10 * 8.0f);
+      E::setRight(item, i % 7 * 8.0f);
+      E::setBottom(item, i % 30 * 60.0f);
+    }
+    E::setRow(item);
+    E::setPadding(item, 2);
+    E::insertChild(root, item);
+    for (uint32_t j = 0; j < 2; j++) {
+      typename E::Node child = E::newNode();
+      E::setFlexGrow(child, 1);
+      E::setHeight(child, 16);
+      E::insertChild(item, child);
+    }
+  }
+  return root;
+}
+
+// rows of count nodes in total with a usual style mix: every node has a
+// size, half have margins, one in ten has a border, one in 25 is absolutely
+// positioned.
+template <class E>
+typename E::Node buildStyledNodes(uint32_t count) {
+  typename E::Node root = E::newNode();
+  typename E::Node row = root;
+  for (uint32_t i = 1; i < count; i++) {
+    typename E::Node node = E::newNode();
+    if (i % 100 == 1) {
+      E::setRow(node);
+      E::setPadding(node, 8);
+      E::insertChild(root, node);
+      row = node;
+      continue;
+    }
+    E::setWidth(node, 40);
+    E::setHeight(node, 20);
+    if (i % 2 == 0) {
+      E::setMargin(node, 4);
+    }
+    if (i % 10 == 0) {
+      E::setBorder(node, 1);
+    }
+    if (i % 25 == 0) {
+      E::setAbsolute(node);
+      E::setLeft(node, 10);
+      E::setTop(node, 10);
+    }
+    E::insertChild(row, node);
+  }
+  return root;
+}
+
+template <class E>
+void runLayoutScenarios(LayoutBenchmark& bench) {
+  const float screenWidth = 1080;
+  const float screenHeight = 1920;
+
+  bench.run("huge nested layout", [&](LayoutBenchmarkTimer& timer) {
+    typename E::Node root = buildHugeNested<E>(true);
+    timer.start();
+    E::layout(root, NAN, NAN);
+    timer.stop();
+    E::freeRecursive(root);
+  });
+
+  bench.run("huge nested layout, no style width & height", [&](LayoutBenchmarkTimer& timer) {
+    typename E::Node root = buildHugeNested<E>(false);
+    timer.start();
+    E::layout(root, NAN, NAN);
+    timer.stop();
+    E::freeRecursive(root);
+  });
+
+  bench.run("deep nesting, 20 levels", [&](LayoutBenchmarkTimer& timer) {
+    typename E::Node root = buildDeepNesting<E>(20);
+    timer.start();
+    E::layout(root, screenWidth, NAN);
+    timer.stop();
+    E::freeRecursive(root);
+  });
+
+  bench.run("wrapped grid, 10k items", [&](LayoutBenchmarkTimer& timer) {
+    typename E::Node root = buildWrappedGrid<E>(10000);
+    timer.start();
+    E::layout(root, screenWidth, NAN);
+    timer.stop();
+    E::freeRecursive(root);
+  });
+
+  bench.run("text list, 1k rows", [&](LayoutBenchmarkTimer& timer) {
+    typename E::Node root = buildTextList<E>(1000, nullptr);
+    timer.start();
+    E::layout(root, screenWidth, NAN);
+    timer.stop();
+    E::freeRecursive(root);
+  });
+
+  // the list is laid out once, then one text changes before each relayout.
+  std::vector<typename E::Node> texts;
+  typename E::Node list = buildTextList<E>(1000, &texts);
+  E::layout(list, screenWidth, NAN);
+  uint32_t round = 0;
+  bench.run("text list, 1k rows, relayout after one text dirtied",
+            [&](LayoutBenchmarkTimer& timer) {
+              round++;
+              E::markDirty(texts[(round * 7919) % texts.size()]);
+              timer.start();
+              E::layout(list, screenWidth, NAN);
+              timer.stop();
+            });
+  E::freeRecursive(list);
+
+  bench.run("absolute positioning, 1k items", [&](LayoutBenchmarkTimer& timer) {
+    typename E::Node root = buildAbsoluteItems<E>(1000);
+    timer.start();
+    E::layout(root, screenWidth, screenHeight);
+    timer.stop();
+    E::freeRecursive(root);
+  });
+
+  // heap bytes of nodes, their styles and children lists, no layout.
+  const uint32_t styledCount = 100000;
+  uint64_t styledBytes = 0;
+  bench.run("100k styled nodes build, memory", [&](LayoutBenchmarkTimer& timer) {
+    timer.start();
+    typename E::Node root = buildStyledNodes<E>(styledCount);
+    timer.stop();
+    styledBytes = timer.allocatedBytes;
+    E::freeRecursive(root);
+  });
+  if (styledBytes > 0) {
+    printf("%-56s %9.1lf bytes per node\n", "100k styled nodes build, memory",
+           static_cast<double>(styledBytes) / styledCount);
+  }
+}
@@ -0,0 +1,523 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* differential layout harness. random style trees of LayoutFuzzTrees.h are
+ * laid out by the hippy serial path (plain HPNode recursion, the reference),
+ * hippy parallel layout, and yoga if it's built in. frames of every node
+ * are compared with the reference and the layout time of every engine is
+ * recorded per tree:
+ *   layout_diff [--seed N] [--trees N] [--max-nodes N] [--max-depth N]
+ *               [--repetitions N] [--tolerance PX] [--cliff-ratio R]
+ *               [--corpus PATH] [--replay TREE_SEED]
+ * --corpus appends one json line per tree to PATH, so the corpus grows run
+ * after run with different seeds. a tree is slow (a performance cliff) if
+ * hippy takes cliff-ratio times of yoga, or of the median time per node of
+ * the run without yoga. trees are reported by their seeds, --replay prints
+ * one tree and the frames of all engines, it needs the same --max-nodes and
+ * --max-depth as the run that found it.
+ * hippy paths must agree with the reference exactly, the exit code is 1 if
+ * they don't. yoga differs in a few known behaviours, its divergences beyond
+ * tolerance are reported only.
+ */
+// harness headers define operator new and must be ahead of engine headers
+#include "LayoutBenchmark.h"
+#include "LayoutScenarios.h"
+#include "LayoutFuzzTrees.h"
+
+#if LAYOUT_DIFF_YOGA
+#include <Yoga.h>
+#endif
+#include "./Hippy.h"
+
+// hippy paths differ only in float summation order.
+#define DIFF_HIPPY_TOLERANCE 0.01f
+
+typedef struct {
+  float left;
+  float top;
+  float width;
+  float height;
+} DiffFrame;
+
+static HPSize _measureHippyText(HPNodeRef node,
+                                float width,
+                                MeasureMode widthMode,
+                                float height,
+                                MeasureMode heightMode,
+                                void* layoutContext) {
+  uint32_t chars = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(HPNodeGetContext(node)));
+  HPSize size;
+  measureBenchmarkText(chars, width, widthMode != MeasureModeUndefined, &size.width,
+                       &size.height);
+  return size;
+}
+
+struct HippyEngine {
+  typedef HPNodeRef Node;
+
+  static Node newNode() { return HPNodeNewWithConfig(config); }
+  static void insertChild(Node parent, Node child) {
+    HPNodeInsertChild(parent, child, HPNodeChildCount(parent));
+  }
+  static void freeRecursive(Node node) { HPNodeFreeRecursive(node); }
+  static void applyStyle(Node node, const FuzzStyle& style) {
+    static const FlexDirection directions[] = {FLexDirectionRow, FLexDirectionRowReverse,
+                                               FLexDirectionColumn, FLexDirectionColumnReverse};
+    static const FlexWrapMode wraps[] = {FlexNoWrap, FlexWrap, FlexWrapReverse};
+    static const FlexAlign aligns[] = {FlexAlignAuto,         FlexAlignStart,
+                                       FlexAlignCenter,       FlexAlignEnd,
+                                       FlexAlignStretch,      FlexAlignSpaceBetween,
+                                       FlexAlignSpaceAround,  FlexAlignSpaceEvenly};
+    static const CSSDirection edges[] = {CSSLeft, CSSTop, CSSRight, CSSBottom};
+
+    HPNodeStyleSetFlexDirection(node, directions[style.direction]);
+    HPNodeStyleSetFlexWrap(node, wraps[style.wrap]);
+    HPNodeStyleSetJustifyContent(node, aligns[style.justifyContent]);
+    HPNodeStyleSetAlignItems(node, aligns[style.alignItems]);
+    HPNodeStyleSetAlignSelf(node, aligns[style.alignSelf]);
+    HPNodeStyleSetAlignContent(node, aligns[style.alignContent]);
+    HPNodeStyleSetPositionType(node,
+                               style.absolute ? PositionTypeAbsolute : PositionTypeRelative);
+    HPNodeStyleSetDisplay(node, style.displayNone ? DisplayTypeNone : DisplayTypeFlex);
+    HPNodeStyleSetWidth(node, style.width);
+    HPNodeStyleSetHeight(node, style.height);
+    HPNodeStyleSetMinWidth(node, style.minWidth);
+    HPNodeStyleSetMinHeight(node, style.minHeight);
+    HPNodeStyleSetMaxWidth(node, style.maxWidth);
+    HPNodeStyleSetMaxHeight(node, style.maxHeight);
+    HPNodeStyleSetFlexGrow(node, style.flexGrow);
+    HPNodeStyleSetFlexShrink(node, style.flexShrink);
+    HPNodeStyleSetFlexBasis(node, style.flexBasis);
+    for (int i = 0; i < FUZZ_EDGES_COUNT; i++) {
+      if (!isnan(style.margin[i])) {
+        HPNodeStyleSetMargin(node, edges[i], style.margin[i]);
+      }
+      if (!isnan(style.padding[i])) {
+        HPNodeStyleSetPadding(node, edges[i], style.padding[i]);
+      }
+      if (!isnan(style.border[i])) {
+        HPNodeStyleSetBorder(node, edges[i], style.border[i]);
+      }
+      if (!isnan(style.position[i])) {
+        HPNodeStyleSetPosition(node, edges[i], style.position[i]);
+      }
+    }
+  }
+  static void setText(Node node, uint32_t chars) {
+    HPNodeSetContext(node, reinterpret_cast<void*>(static_cast<uintptr_t>(chars)));
+    HPNodeSetMeasureFunc(node, _measureHippyText);
+  }
+  static void layout(Node root, float width, float height) {
+    HPNodeDoLayout(root, width, height, DirectionLTR);
+  }
+  static void getFrame(Node node, DiffFrame* frame) {
+    frame->left = HPNodeLayoutGetLeft(node);
+    frame->top = HPNodeLayoutGetTop(node);
+    frame->width = HPNodeLayoutGetWidth(node);
+    frame->height = HPNodeLayoutGetHeight(node);
+  }
+
+  // config of nodes created by newNode, switched for each hippy path.
+  static HPConfigRef config;
+};
+
+HPConfigRef HippyEngine::config = nullptr;
+
+#if LAYOUT_DIFF_YOGA
+static YGSize _measureYogaText(YGNodeRef node,
+                               float width,
+                               YGMeasureMode widthMode,
+                               float height,
+                               YGMeasureMode heightMode) {
+  uint32_t chars = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(YGNodeGetContext(node)));
+  YGSize size;
+  measureBenchmarkText(chars, width, widthMode != YGMeasureModeUndefined, &size.width,
+                       &size.height);
+  return size;
+}
+
+struct YogaEngine {
+  typedef YGNodeRef Node;
+
+  static Node newNode() { return YGNodeNew(); }
+  static void insertChild(Node parent, Node child) {
+    YGNodeInsertChild(parent, child, YGNodeGetChildCount(parent));
+  }
+  static void freeRecursive(Node node) { YGNodeFreeRecursive(node); }
+  static void applyStyle(Node node, const FuzzStyle& style) {
+    static const YGFlexDirection directions[] = {YGFlexDirectionRow, YGFlexDirectionRowReverse,
+                                                 YGFlexDirectionColumn,
+                                                 YGFlexDirectionColumnReverse};
+    static const YGWrap wraps[] = {YGWrapNoWrap, YGWrapWrap, YGWrapWrapReverse};
+    static const YGJustify justifies[] = {YGJustifyFlexStart,    YGJustifyFlexStart,
+                                          YGJustifyCenter,       YGJustifyFlexEnd,
+                                          YGJustifyFlexStart,    YGJustifySpaceBetween,
+                                          YGJustifySpaceAround,  YGJustifySpaceEvenly};
+    static const YGAlign aligns[] = {YGAlignAuto,         YGAlignFlexStart,     YGAlignCenter,
+                                     YGAlignFlexEnd,      YGAlignStretch,       YGAlignSpaceBetween,
+                                     YGAlignSpaceAround,  YGAlignFlexStart};
+    static const YGEdge edges[] = {YGEdgeLeft, YGEdgeTop, YGEdgeRight, YGEdgeBottom};
+
+    YGNodeStyleSetFlexDirection(node, directions[style.direction]);
+    YGNodeStyleSetFlexWrap(node, wraps[style.wrap]);
+    YGNodeStyleSetJustifyContent(node, justifies[style.justifyContent]);
+    YGNodeStyleSetAlignItems(node, aligns[style.alignItems]);
+    YGNodeStyleSetAlignSelf(node, aligns[style.alignSelf]);
+    YGNodeStyleSetAlignContent(node, aligns[style.alignContent]);
+    YGNodeStyleSetPositionType(node,
+                               style.absolute ? YGPositionTypeAbsolute : YGPositionTypeRelative);
+    YGNodeStyleSetDisplay(node, style.displayNone ? YGDisplayNone : YGDisplayFlex);
+    YGNodeStyleSetWidth(node, style.width);
+    YGNodeStyleSetHeight(node, style.height);
+    YGNodeStyleSetMinWidth(node, style.minWidth);
+    YGNodeStyleSetMinHeight(node, style.minHeight);
+    YGNodeStyleSetMaxWidth(node, style.maxWidth);
+    YGNodeStyleSetMaxHeight(node, style.maxHeight);
+    YGNodeStyleSetFlexGrow(node, style.flexGrow);
+    YGNodeStyleSetFlexShrink(node, style.flexShrink);
+    if (isnan(style.flexBasis)) {
+      YGNodeStyleSetFlexBasisAuto(node);
+    } else {
+      YGNodeStyleSetFlexBasis(node, style.flexBasis);
+    }
+    for (int i = 0; i < FUZZ_EDGES_COUNT; i++) {
+      if (!isnan(style.margin[i])) {
+        YGNodeStyleSetMargin(node, edges[i], style.margin[i]);
+      }
+      if (!isnan(style.padding[i])) {
+        YGNodeStyleSetPadding(node, edges[i], style.padding[i]);
+      }
+      if (!isnan(style.border[i])) {
+        YGNodeStyleSetBorder(node, edges[i], style.border[i]);
+      }
+      if (!isnan(style.position[i])) {
+        YGNodeStyleSetPosition(node, edges[i], style.position[i]);
+      }
+    }
+  }
+  static void setText(Node node, uint32_t chars) {
+    YGNodeSetContext(node, reinterpret_cast<void*>(static_cast<uintptr_t>(chars)));
+    YGNodeSetMeasureFunc(node, _measureYogaText);
+  }
+  static void layout(Node root, float width, float height) {
+    YGNodeCalculateLayout(root, width, height, YGDirectionLTR);
+  }
+  static void getFrame(Node node, DiffFrame* frame) {
+    frame->left = YGNodeLayoutGetLeft(node);
+    frame->top = YGNodeLayoutGetTop(node);
+    frame->width = YGNodeLayoutGetWidth(node);
+    frame->height = YGNodeLayoutGetHeight(node);
+  }
+};
+#endif
+
+// layout fresh copies of tree repetitions times, return the best time.
+// frames and measure calls are of the first run.
+template <class E>
+static double runFuzzTree(const FuzzTree& tree,
+                          uint32_t repetitions,
+                          std::vector<DiffFrame>* frames,
+                          uint64_t* measures) {
+  double bestMs = 0;
+  for (uint32_t i = 0; i < repetitions; i++) {
+    std::vector<typename E::Node> nodes = buildFuzzTree<E>(tree);
+    LayoutBenchmarkTimer timer;
+    timer.start();
+    E::layout(nodes[0], tree.width, tree.height);
+    timer.stop();
+    if (i == 0) {
+      frames->resize(nodes.size());
+      for (size_t j = 0; j < nodes.size(); j++) {
+        E::getFrame(nodes[j], &(*frames)[j]);
+      }
+      *measures = timer.measures;
+      bestMs = timer.elapsedMs;
+    } else {
+      bestMs = std::min(bestMs, timer.elapsedMs);
+    }
+    E::freeRecursive(nodes[0]);
+  }
+  return bestMs;
+}
+
+typedef double (*DiffRunFunc)(const FuzzTree& tree,
+                              uint32_t repetitions,
+                              std::vector<DiffFrame>* frames,
+                              uint64_t* measures);
+
+typedef struct {
+  const char* name;
+  DiffRunFunc run;
+  // compared with tolerance option and reported only, see top of file.
+  bool isForeign;
+} DiffEngine;
+
+static HPConfigRef gSerialConfig = nullptr;
+static HPConfigRef gParallelConfig = nullptr;
+
+template <HPConfigRef* Config>
+static double runHippy(const FuzzTree& tree,
+                       uint32_t repetitions,
+                       std::vector<DiffFrame>* frames,
+                       uint64_t* measures) {
+  HippyEngine::config = *Config;
+  return runFuzzTree<HippyEngine>(tree, repetitions, frames, measures);
+}
+
+// the reference engine is the first one.
+static std::vector<DiffEngine> diffEngines() {
+  std::vector<DiffEngine> engines;
+  DiffEngine serial = {"hippy", runHippy<&gSerialConfig>, false};
+  engines.push_back(serial);
+  DiffEngine parallel = {"hippy parallel", runHippy<&gParallelConfig>, false};
+  engines.push_back(parallel);
+#if LAYOUT_DIFF_YOGA
+  DiffEngine yoga = {"yoga", runFuzzTree<YogaEngine>, true};
+  engines.push_back(yoga);
+#endif
+  return engines;
+}
+
+typedef struct {
+  double ms;
+  uint64_t measures;
+  // largest difference of a frame value, index of the first node beyond
+  // tolerance or -1.
+  float maxDiff;
+  int32_t divergedNode;
+} DiffEngineResult;
+
+typedef struct {
+  uint64_t seed;
+  uint32_t nodeCount;
+  std::vector<DiffEngineResult> engines;
+  bool cliff;
+} DiffTreeResult;
+
+static void compareFrames(const std::vector<DiffFrame>& reference,
+                          const std::vector<DiffFrame>& frames,
+                          const std::vector<bool>& hidden,
+                          float tolerance,
+                          DiffEngineResult* result) {
+  result->maxDiff = 0;
+  result->divergedNode = -1;
+  for (size_t i = 0; i < reference.size(); i++) {
+    if (hidden[i]) {
+      continue;
+    }
+    const float a[] = {reference[i].left, reference[i].top, reference[i].width,
+                       reference[i].height};
+    const float b[] = {frames[i].left, frames[i].top, frames[i].width, frames[i].height};
+    for (int j = 0; j < 4; j++) {
+      float diff = isnan(a[j]) != isnan(b[j]) ? INFINITY : isnan(a[j]) ? 0 : fabsf(a[j] - b[j]);
+      result->maxDiff = std::max(result->maxDiff, diff);
+      if (diff > tolerance && result->divergedNode < 0) {
+        result->divergedNode = static_cast<int32_t>(i);
+      }
+    }
+  }
+}
+
+static DiffTreeResult runDiffTree(const std::vector<DiffEngine>& engines,
+                                  const FuzzTree& tree,
+                                  uint32_t repetitions,
+                                  float tolerance,
+                                  std::vector<std::vector<DiffFrame> >* frames) {
+  DiffTreeResult result;
+  result.seed = tree.seed;
+  result.nodeCount = tree.nodes.size();
+  result.cliff = false;
+  frames->resize(engines.size());
+  std::vector<bool> hidden = fuzzHiddenNodes(tree);
+  for (size_t i = 0; i < engines.size(); i++) {
+    DiffEngineResult engine;
+    engine.ms = engines[i].run(tree, repetitions, &(*frames)[i], &engine.measures);
+    compareFrames((*frames)[0], (*frames)[i], hidden,
+                  engines[i].isForeign ? tolerance : DIFF_HIPPY_TOLERANCE, &engine);
+    result.engines.push_back(engine);
+  }
+  return result;
+}
+
+static void replayTree(const std::vector<DiffEngine>& engines,
+                       uint64_t seed,
+                       uint32_t maxNodes,
+                       uint32_t maxDepth,
+                       float tolerance) {
+  FuzzTree tree = generateFuzzTree(seed, maxNodes, maxDepth);
+  std::vector<std::vector<DiffFrame> > frames;
+  DiffTreeResult result = runDiffTree(engines, tree, 1, tolerance, &frames);
+  printf("tree %llu, %u nodes, available width %g height %g\n",
+         static_cast<unsigned long long>(seed), result.nodeCount, tree.width, tree.height);
+  for (size_t i = 0; i < tree.nodes.size(); i++) {
+    const FuzzNode& node = tree.nodes[i];
+    printf("%*s#%zu { %s}\n", node.depth * 2, "", i, describeFuzzNode(node).c_str());
+    for (size_t j = 0; j < engines.size(); j++) {
+      const DiffFrame& frame = frames[j][i];
+      printf("%*s  %-16s %9.2f %9.2f %9.2f %9.2f%s\n", node.depth * 2, "", engines[j].name,
+             frame.left, frame.top, frame.width, frame.height,
+             result.engines[j].divergedNode == static_cast<int32_t>(i) ? "  <- first diverged"
+                                                                       : "");
+    }
+  }
+}
+
+static void appendCorpus(FILE* file,
+                         const std::vector<DiffEngine>& engines,
+                         const DiffTreeResult& result,
+                         uint32_t maxNodes,
+                         uint32_t maxDepth) {
+  fprintf(file,
+          "{\"seed\": %llu, \"max_nodes\": %u, \"max_depth\": %u, \"nodes\": %u, "
+          "\"cliff\": %s, \"engines\": {",
+          static_cast<unsigned long long>(result.seed), maxNodes, maxDepth, result.nodeCount,
+          result.cliff ? "true" : "false");
+  for (size_t i = 0; i < engines.size(); i++) {
+    const DiffEngineResult& engine = result.engines[i];
+    fprintf(file,
+            "\"%s\": {\"ms\": %.6lf, \"measure_calls\": %llu, \"max_diff\": %.3f, "
+            "\"diverged_node\": %d}%s",
+            engines[i].name, engine.ms, static_cast<unsigned long long>(engine.measures),
+            isinf(engine.maxDiff) ? -1.0f : engine.maxDiff, engine.divergedNode,
+            i + 1 < engines.size() ? ", " : "");
+  }
+  fprintf(file, "}}\n");
+}
+
+int main(int argc, char const* argv[]) {
+  uint64_t seed = 1;
+  uint32_t trees = 1000;
+  uint32_t maxNodes = 200;
+  uint32_t maxDepth = 8;
+  uint32_t repetitions = 3;
+  float tolerance = 1.0f;
+  double cliffRatio = 4;
+  const char* corpusPath = nullptr;
+  bool replay = false;
+  uint64_t replaySeed = 0;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--seed") == 0) {
+      seed = strtoull(argv[i + 1], nullptr, 10);
+    } else if (strcmp(argv[i], "--trees") == 0) {
+      trees = std::max(atoi(argv[i + 1]), 1);
+    } else if (strcmp(argv[i], "--max-nodes") == 0) {
+      maxNodes = std::max(atoi(argv[i + 1]), 1);
+    } else if (strcmp(argv[i], "--max-depth") == 0) {
+      maxDepth = std::max(atoi(argv[i + 1]), 1);
+    } else if (strcmp(argv[i], "--repetitions") == 0) {
+      repetitions = std::max(atoi(argv[i + 1]), 1);
+    } else if (strcmp(argv[i], "--tolerance") == 0) {
+      tolerance = static_cast<float>(atof(argv[i + 1]));
+    } else if (strcmp(argv[i], "--cliff-ratio") == 0) {
+      cliffRatio = atof(argv[i + 1]);
+    } else if (strcmp(argv[i], "--corpus") == 0) {
+      corpusPath = argv[i + 1];
+    } else if (strcmp(argv[i], "--replay") == 0) {
+      replay = true;
+      replaySeed = strtoull(argv[i + 1], nullptr, 10);
+    }
+  }
+
+  gSerialConfig = new HPConfig();
+  gParallelConfig = new HPConfig();
+  gParallelConfig->SetParallelLayout(4);
+  std::vector<DiffEngine> engines = diffEngines();
+
+  int exitCode = 0;
+  if (replay) {
+    replayTree(engines, replaySeed, maxNodes, maxDepth, tolerance);
+  } else {
+    std::vector<DiffTreeResult> results;
+    std::vector<std::vector<DiffFrame> > frames;
+    std::vector<uint32_t> divergedTrees(engines.size(), 0);
+    std::vector<double> totalMs(engines.size(), 0);
+    for (uint32_t i = 0; i < trees; i++) {
+      FuzzTree tree = generateFuzzTree(fuzzTreeSeed(seed, i), maxNodes, maxDepth);
+      DiffTreeResult result = runDiffTree(engines, tree, repetitions, tolerance, &frames);
+      for (size_t j = 0; j < engines.size(); j++) {
+        totalMs[j] += result.engines[j].ms;
+        if (result.engines[j].divergedNode >= 0) {
+          divergedTrees[j]++;
+          printf("tree %llu: %s diverges from %s at node #%d, max difference %g\n",
+                 static_cast<unsigned long long>(result.seed), engines[j].name, engines[0].name,
+                 result.engines[j].divergedNode, result.engines[j].maxDiff);
+        }
+      }
+      results.push_back(result);
+    }
+
+    // time per node of the reference, its median is the baseline without
+    // a foreign engine. tiny trees are timer noise.
+    std::vector<double> perNode;
+    for (size_t i = 0; i < results.size(); i++) {
+      perNode.push_back(results[i].engines[0].ms / results[i].nodeCount);
+    }
+    std::sort(perNode.begin(), perNode.end());
+    double medianPerNode = perNode[perNode.size() / 2];
+    const double noiseMs = 0.05;
+    uint32_t cliffs = 0;
+    for (size_t i = 0; i < results.size(); i++) {
+      DiffTreeResult& result = results[i];
+      double ms = result.engines[0].ms;
+      if (ms < noiseMs) {
+        continue;
+      }
+      double baselineMs = medianPerNode * result.nodeCount;
+      if (engines.back().isForeign) {
+        baselineMs = result.engines.back().ms;
+      }
+      if (ms > baselineMs * cliffRatio) {
+        result.cliff = true;
+        cliffs++;
+        printf("tree %llu: %u nodes, %s takes %.4lf ms, %.1lfx of %s\n",
+               static_cast<unsigned long long>(result.seed), result.nodeCount, engines[0].name,
+               ms, ms / baselineMs,
+               engines.back().isForeign ? engines.back().name : "median time per node");
+      }
+    }
+
+    printf("%u trees of seed %llu, %u slow trees\n", trees, static_cast<unsigned long long>(seed),
+           cliffs);
+    for (size_t j = 0; j < engines.size(); j++) {
+      printf("%-16s total %10.3lf ms  diverged trees %u\n", engines[j].name, totalMs[j],
+             divergedTrees[j]);
+    }
+
+    if (corpusPath != nullptr) {
+      FILE* file = fopen(corpusPath, "a");
+      if (file != nullptr) {
+        for (size_t i = 0; i < results.size(); i++) {
+          appendCorpus(file, engines, results[i], maxNodes, maxDepth);
+        }
+        fclose(file);
+      } else {
+        fprintf(stderr, "can't open %s\n", corpusPath);
+        exitCode = 1;
+      }
+    }
+
+    for (size_t j = 1; j < engines.size(); j++) {
+      if (!engines[j].isForeign && divergedTrees[j] > 0) {
+        exitCode = 1;
+      }
+    }
+  }
+
+  HPConfigFree(gSerialConfig);
+  HPConfigFree(gParallelConfig);
+  return exitCode;
+}
@@ -0,0 +1,26 @@
+#! /bin/bash
+
+CMAKE=`which cmake`
+MAKE=`which make`
+
+BASH_SOURCE_DIR=$(cd `dirname "${BASH_SOURCE[0]}"` && pwd)
+BUILD_DIR="${BASH_SOURCE_DIR}"/../../out
+
+rm -rf "${BUILD_DIR}"/layoutdiff
+mkdir -p "${BUILD_DIR}"/layoutdiff "${BUILD_DIR}"/yogabenchmark
+cd "${BUILD_DIR}"/layoutdiff
+
+#cmake generate make file, yoga is shared with yoga benchmark,
+#set LAYOUT_DIFF_CMAKE_ARGS=-DLAYOUT_DIFF_WITH_YOGA=OFF to compare hippy paths only
+"${CMAKE}" ${LAYOUT_DIFF_CMAKE_ARGS} ../../benchmark/diff
+
+echo "Start build in directory: `pwd`"
+${MAKE}
+
+#run layout_diff
+DIFF_RUN_PATH="${BUILD_DIR}"/layoutdiff/layout_diff
+#a new seed each run, results of every tree are appended to the corpus,
+#extra arguments are passed to layout_diff
+if [ -x "${DIFF_RUN_PATH}" ];then
+${DIFF_RUN_PATH} --seed `date +%s` --corpus "${BUILD_DIR}"/layout_diff_corpus.jsonl "$@"
+fi
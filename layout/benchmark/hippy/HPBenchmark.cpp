@@ -19,215 +19,149 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-/* this benchmark refer facebook yoga , so it can compare with yoga.
+/* hippy layout benchmark, the shared scenarios run against
+ * layout/benchmark/yoga too, so the two engines can be compared directly.
+ * see LayoutBenchmark.h for options and json output.
  */
-#include <math.h>
-#include <stdint.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <time.h>
+// harness headers define operator new and must be ahead of Hippy.h
+#include "LayoutBenchmark.h"
+#include "LayoutScenarios.h"
 
 #include "./Hippy.h"
 
-#define NUM_REPETITIONS 1000
-
-#define HPBENCHMARKS(BLOCK)                \
-  int main(int argc, char const* argv[]) { \
-    clock_t __start;                       \
-    clock_t __endTimes[NUM_REPETITIONS];   \
-    { BLOCK }                              \
-    return 0;                              \
-  }
-
-#define HPBENCHMARK(NAME, BLOCK)                         \
-  __start = clock();                                     \
-  for (uint32_t __i = 0; __i < NUM_REPETITIONS; __i++) { \
-    {BLOCK} __endTimes[__i] = clock();                   \
-  }                                                      \
-  __printBenchmarkResult(NAME, __start, __endTimes);
+static HPSize _measureText(HPNodeRef node,
+                           float width,
+                           MeasureMode widthMode,
+                           float height,
+                           MeasureMode heightMode,
+                           void* layoutContext) {
+  uint32_t chars = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(HPNodeGetContext(node)));
+  HPSize size;
+  measureBenchmarkText(chars, width, widthMode != MeasureModeUndefined, &size.width,
+                       &size.height);
+  return size;
+}
 
-static int __compareDoubles(const void* a, const void* b) {
-  double arg1 = *(const double*)a;
-  double arg2 = *(const double*)b;
+struct HippyEngine {
+  typedef HPNodeRef Node;
 
-  if (arg1 < arg2) {
-    return -1;
+  static Node newNode() { return HPNodeNewWithConfig(config); }
+  static void insertChild(Node parent, Node child) {
+    HPNodeInsertChild(parent, child, HPNodeChildCount(parent));
   }
-
-  if (arg1 > arg2) {
-    return 1;
+  static void freeRecursive(Node node) { HPNodeFreeRecursive(node); }
+  static void setWidth(Node node, float value) { HPNodeStyleSetWidth(node, value); }
+  static void setHeight(Node node, float value) { HPNodeStyleSetHeight(node, value); }
+  static void setFlexGrow(Node node, float value) { HPNodeStyleSetFlexGrow(node, value); }
+  static void setFlexShrink(Node node, float value) { HPNodeStyleSetFlexShrink(node, value); }
+  static void setMargin(Node node, float value) { HPNodeStyleSetMargin(node, CSSAll, value); }
+  static void setPadding(Node node, float value) { HPNodeStyleSetPadding(node, CSSAll, value); }
+  static void setBorder(Node node, float value) { HPNodeStyleSetBorder(node, CSSAll, value); }
+  static void setRow(Node node) { HPNodeStyleSetFlexDirection(node, FLexDirectionRow); }
+  static void setWrap(Node node) { HPNodeStyleSetFlexWrap(node, FlexWrap); }
+  static void setAbsolute(Node node) { HPNodeStyleSetPositionType(node, PositionTypeAbsolute); }
+  static void setLeft(Node node, float value) { HPNodeStyleSetPosition(node, CSSLeft, value); }
+  static void setTop(Node node, float value) { HPNodeStyleSetPosition(node, CSSTop, value); }
+  static void setRight(Node node, float value) { HPNodeStyleSetPosition(node, CSSRight, value); }
+  static void setBottom(Node node, float value) { HPNodeStyleSetPosition(node, CSSBottom, value); }
+  static void setText(Node node, uint32_t chars) {
+    HPNodeSetContext(node, reinterpret_cast<void*>(static_cast<uintptr_t>(chars)));
+    HPNodeSetMeasureFunc(node, _measureText);
   }
-
-  return 0;
-}
-
-static void __printBenchmarkResult(char* name, clock_t start, clock_t* endTimes) {
-  double timesInMs[NUM_REPETITIONS];
-  double mean = 0;
-  clock_t lastEnd = start;
-  for (uint32_t i = 0; i < NUM_REPETITIONS; i++) {
-    timesInMs[i] = (endTimes[i] - lastEnd) / static_cast<double>(CLOCKS_PER_SEC) * 1000;
-    lastEnd = endTimes[i];
-    mean += timesInMs[i];
+  static void markDirty(Node node) { HPNodeMarkDirty(node); }
+  static void layout(Node root, float width, float height) {
+    HPNodeDoLayout(root, width, height, DirectionLTR);
   }
-  mean /= NUM_REPETITIONS;
 
-  qsort(timesInMs, NUM_REPETITIONS, sizeof(double), __compareDoubles);
-  double median = timesInMs[NUM_REPETITIONS / 2];
-
-  double variance = 0;
-  for (uint32_t i = 0; i < NUM_REPETITIONS; i++) {
-    variance += pow(timesInMs[i] - mean, 2);
+  // config of nodes created by newNode, switched by hippy only scenarios.
+  static HPConfigRef config;
+};
+
+HPConfigRef HippyEngine::config = nullptr;
+
+// build a tree of 10k nodes: root -> 100 children -> 99 grand children each.
+static HPNodeRef __buildTenThousandNodes(HPConfigRef config) {
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  for (uint32_t i = 0; i < 100; i++) {
+    const HPNodeRef child = HPNodeNewWithConfig(config);
+    HPNodeStyleSetFlexDirection(child, FLexDirectionRow);
+    HPNodeInsertChild(root, child, i);
+    for (uint32_t ii = 0; ii < 99; ii++) {
+      const HPNodeRef grandChild = HPNodeNewWithConfig(config);
+      HPNodeStyleSetWidth(grandChild, 10);
+      HPNodeStyleSetHeight(grandChild, 10);
+      HPNodeInsertChild(child, grandChild, ii);
+    }
   }
-  variance /= NUM_REPETITIONS;
-  double stddev = sqrt(variance);
-
-  printf("%s: median: %lf ms, stddev: %lf ms\n", name, median, stddev);
+  return root;
 }
 
-static HPSize _measure(HPNodeRef node,
-                       float width,
-                       MeasureMode widthMode,
-                       float height,
-                       MeasureMode heightMode,
-                       void* layoutContext) {
-  HPSize size = {widthMode == MeasureModeUndefined ? 10 : width,
-                 heightMode == MeasureModeUndefined ? 10 : width};
-  return size;
-}
-
-HPBENCHMARKS({
-  HPBENCHMARK("Stack with flex", {
-    const HPNodeRef root = HPNodeNew();
-    HPNodeStyleSetWidth(root, 100);
-    HPNodeStyleSetHeight(root, 100);
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const HPNodeRef child = HPNodeNew();
-      HPNodeSetMeasureFunc(child, _measure);
-      HPNodeStyleSetFlex(child, 1);
-      HPNodeInsertChild(root, child, 0);
-    }
-
+// layout a fresh tree built by build with nodes of config.
+template <class Build>
+static void __runWithConfig(LayoutBenchmark& bench,
+                            const char* name,
+                            HPConfigRef config,
+                            Build build) {
+  HippyEngine::config = config;
+  bench.run(name, [&](LayoutBenchmarkTimer& timer) {
+    const HPNodeRef root = build();
+    timer.start();
     HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED, DirectionLTR);
+    timer.stop();
     HPNodeFreeRecursive(root);
   });
+  HippyEngine::config = HPConfigGetDefault();
+}
 
-  HPBENCHMARK("Align stretch in undefined axis", {
-    const HPNodeRef root = HPNodeNew();
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const HPNodeRef child = HPNodeNew();
-      HPNodeStyleSetHeight(child, 20);
-      HPNodeSetMeasureFunc(child, _measure);
-      HPNodeInsertChild(root, child, 0);
-    }
-
-    HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED, DirectionLTR);
+int main(int argc, char const* argv[]) {
+  LayoutBenchmark bench("hippy", argc, argv);
+  HippyEngine::config = HPConfigGetDefault();
+  runLayoutScenarios<HippyEngine>(bench);
+
+  // hippy only scenarios.
+  HPConfigRef parallelConfig = new HPConfig();
+  parallelConfig->SetParallelLayout(4);
+  __runWithConfig(bench, "huge nested layout, parallel layout in 4 threads", parallelConfig,
+                  [] { return buildHugeNested<HippyEngine>(true); });
+  HPConfigFree(parallelConfig);
+
+  HPConfigRef heapConfig = new HPConfig();
+  bench.run("10k nodes build & free, heap allocation", [&](LayoutBenchmarkTimer& timer) {
+    timer.start();
+    const HPNodeRef root = __buildTenThousandNodes(heapConfig);
     HPNodeFreeRecursive(root);
+    timer.stop();
   });
+  HPConfigFree(heapConfig);
 
-  HPBENCHMARK("Nested flex", {
-    const HPNodeRef root = HPNodeNew();
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const HPNodeRef child = HPNodeNew();
-      HPNodeStyleSetFlex(child, 1);
-      HPNodeInsertChild(root, child, 0);
-
-      for (uint32_t ii = 0; ii < 10; ii++) {
-        const HPNodeRef grandChild = HPNodeNew();
-        HPNodeSetMeasureFunc(grandChild, _measure);
-        HPNodeStyleSetFlex(grandChild, 1);
-        HPNodeInsertChild(child, grandChild, 0);
-      }
-    }
-
-    HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED, DirectionLTR);
+  HPConfigRef poolConfig = new HPConfig();
+  poolConfig->SetUseNodePool(true);
+  bench.run("10k nodes build & free, node pool allocation", [&](LayoutBenchmarkTimer& timer) {
+    timer.start();
+    const HPNodeRef root = __buildTenThousandNodes(poolConfig);
     HPNodeFreeRecursive(root);
+    timer.stop();
   });
-
-  HPBENCHMARK("Huge nested layout", {
-    const HPNodeRef root = HPNodeNew();
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const HPNodeRef child = HPNodeNew();
-      HPNodeStyleSetFlexGrow(child, 1);
-      HPNodeStyleSetWidth(child, 10);
-      HPNodeStyleSetHeight(child, 10);
-      HPNodeInsertChild(root, child, 0);
-
-      for (uint32_t ii = 0; ii < 10; ii++) {
-        const HPNodeRef grandChild = HPNodeNew();
-        HPNodeStyleSetFlexDirection(grandChild, FLexDirectionRow);
-        HPNodeStyleSetFlexGrow(grandChild, 1);
-        HPNodeStyleSetWidth(grandChild, 10);
-        HPNodeStyleSetHeight(grandChild, 10);
-        HPNodeInsertChild(child, grandChild, 0);
-
-        for (uint32_t iii = 0; iii < 10; iii++) {
-          const HPNodeRef grandGrandChild = HPNodeNew();
-          HPNodeStyleSetFlexGrow(grandGrandChild, 1);
-          HPNodeStyleSetWidth(grandGrandChild, 10);
-          HPNodeStyleSetHeight(grandGrandChild, 10);
-          HPNodeInsertChild(grandChild, grandGrandChild, 0);
-
-          for (uint32_t iiii = 0; iiii < 10; iiii++) {
-            const HPNodeRef grandGrandGrandChild = HPNodeNew();
-            HPNodeStyleSetFlexDirection(grandGrandGrandChild, FLexDirectionRow);
-            HPNodeStyleSetFlexGrow(grandGrandGrandChild, 1);
-            HPNodeStyleSetWidth(grandGrandGrandChild, 10);
-            HPNodeStyleSetHeight(grandGrandGrandChild, 10);
-            HPNodeInsertChild(grandGrandChild, grandGrandGrandChild, 0);
-          }
-        }
-      }
+  HPConfigFree(poolConfig);
+
+  // every item is marked dirty, so all lines are collected again in each pass.
+  // flex lines come from the config's arena, the relayout is expected to do
+  // no heap allocation.
+  HPConfigRef gridConfig = new HPConfig();
+  HippyEngine::config = gridConfig;
+  const HPNodeRef grid = buildWrappedGrid<HippyEngine>(1000);
+  HippyEngine::config = HPConfigGetDefault();
+  HPNodeDoLayout(grid, 1080, VALUE_UNDEFINED, DirectionLTR);
+  bench.run("wrapped grid, 1k items, relayout all dirty", [&](LayoutBenchmarkTimer& timer) {
+    for (uint32_t j = 0; j < HPNodeChildCount(grid); j++) {
+      HPNodeMarkDirty(HPNodeGetChild(grid, j));
     }
-
-    HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED, DirectionLTR);
-    HPNodeFreeRecursive(root);
+    timer.start();
+    HPNodeDoLayout(grid, 1080, VALUE_UNDEFINED, DirectionLTR);
+    timer.stop();
   });
+  HPNodeFreeRecursive(grid);
+  HPConfigFree(gridConfig);
 
-  // added by ianwang(honwsn@gmail.com) ,for no style test that will cost more time then the
-  // previous test case.
-  HPBENCHMARK("Huge nested layout, no style width & height", {
-    const HPNodeRef root = HPNodeNew();
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const HPNodeRef child = HPNodeNew();
-      HPNodeStyleSetFlexGrow(child, 1);
-      //      HPNodeStyleSetWidth(child, 10);
-      //      HPNodeStyleSetHeight(child, 10);
-      HPNodeInsertChild(root, child, 0);
-
-      for (uint32_t ii = 0; ii < 10; ii++) {
-        const HPNodeRef grandChild = HPNodeNew();
-        HPNodeStyleSetFlexDirection(grandChild, FLexDirectionRow);
-        HPNodeStyleSetFlexGrow(grandChild, 1);
-        //        HPNodeStyleSetWidth(grandChild, 10);
-        //        HPNodeStyleSetHeight(grandChild, 10);
-        HPNodeInsertChild(child, grandChild, 0);
-
-        for (uint32_t iii = 0; iii < 10; iii++) {
-          const HPNodeRef grandGrandChild = HPNodeNew();
-          HPNodeStyleSetFlexGrow(grandGrandChild, 1);
-          //          HPNodeStyleSetWidth(grandGrandChild, 10);
-          //          HPNodeStyleSetHeight(grandGrandChild, 10);
-          HPNodeInsertChild(grandChild, grandGrandChild, 0);
-
-          for (uint32_t iiii = 0; iiii < 10; iiii++) {
-            const HPNodeRef grandGrandGrandChild = HPNodeNew();
-            HPNodeStyleSetFlexDirection(grandGrandGrandChild, FLexDirectionRow);
-            HPNodeStyleSetFlexGrow(grandGrandGrandChild, 1);
-            HPNodeStyleSetWidth(grandGrandGrandChild, 10);
-            HPNodeStyleSetHeight(grandGrandGrandChild, 10);
-            HPNodeInsertChild(grandGrandChild, grandGrandGrandChild, 0);
-          }
-        }
-      }
-    }
-
-    HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED, DirectionLTR);
-    HPNodeFreeRecursive(root);
-  });
-});
+  return bench.writeJson() ? 0 : 1;
+}
@@ -18,6 +18,7 @@ ${MAKE}
 
 #run hippy_layout_benchmark
 BENCHMARK_RUN_PATH="${BUILD_DIR}"/hpbenchmark/hippy_layout_benchmark
+#results are also written to json, extra arguments are passed to benchmark
 if [ -x "${BENCHMARK_RUN_PATH}" ];then
-${BENCHMARK_RUN_PATH}
+${BENCHMARK_RUN_PATH} --json "${BUILD_DIR}"/hpbenchmark/hippy_layout_benchmark.json "$@"
 fi
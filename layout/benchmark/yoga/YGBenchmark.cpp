@@ -4,211 +4,63 @@
  * This source code is licensed under the MIT license found in the LICENSE
  * file in the root directory of this source tree.
  */
-#include <Yoga.h>
-#include <math.h>
-#include <stdint.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <time.h>
-
-#define NUM_REPETITIONS 1000
+/* yoga layout benchmark, runs the scenarios shared with
+ * layout/benchmark/hippy, see LayoutBenchmark.h for options and json output.
+ */
+// harness headers define operator new and must be ahead of Yoga.h
+#include "LayoutBenchmark.h"
+#include "LayoutScenarios.h"
 
-#define YGBENCHMARKS(BLOCK)                \
-  int main(int argc, char const* argv[]) { \
-    clock_t __start;                       \
-    clock_t __endTimes[NUM_REPETITIONS];   \
-    { BLOCK }                              \
-    return 0;                              \
-  }
+#include <Yoga.h>
 
-#define YGBENCHMARK(NAME, BLOCK)                         \
-  __start = clock();                                     \
-  for (uint32_t __i = 0; __i < NUM_REPETITIONS; __i++) { \
-    {BLOCK} __endTimes[__i] = clock();                   \
-  }                                                      \
-  __printBenchmarkResult(NAME, __start, __endTimes);
+static YGSize _measureText(YGNodeRef node,
+                           float width,
+                           YGMeasureMode widthMode,
+                           float height,
+                           YGMeasureMode heightMode) {
+  uint32_t chars = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(YGNodeGetContext(node)));
+  YGSize size;
+  measureBenchmarkText(chars, width, widthMode != YGMeasureModeUndefined, &size.width,
+                       &size.height);
+  return size;
+}
 
-static int __compareDoubles(const void* a, const void* b) {
-  double arg1 = *(const double*)a;
-  double arg2 = *(const double*)b;
+struct YogaEngine {
+  typedef YGNodeRef Node;
 
-  if (arg1 < arg2) {
-    return -1;
+  static Node newNode() { return YGNodeNew(); }
+  static void insertChild(Node parent, Node child) {
+    YGNodeInsertChild(parent, child, YGNodeGetChildCount(parent));
   }
-
-  if (arg1 > arg2) {
-    return 1;
+  static void freeRecursive(Node node) { YGNodeFreeRecursive(node); }
+  static void setWidth(Node node, float value) { YGNodeStyleSetWidth(node, value); }
+  static void setHeight(Node node, float value) { YGNodeStyleSetHeight(node, value); }
+  static void setFlexGrow(Node node, float value) { YGNodeStyleSetFlexGrow(node, value); }
+  static void setFlexShrink(Node node, float value) { YGNodeStyleSetFlexShrink(node, value); }
+  static void setMargin(Node node, float value) { YGNodeStyleSetMargin(node, YGEdgeAll, value); }
+  static void setPadding(Node node, float value) { YGNodeStyleSetPadding(node, YGEdgeAll, value); }
+  static void setBorder(Node node, float value) { YGNodeStyleSetBorder(node, YGEdgeAll, value); }
+  static void setRow(Node node) { YGNodeStyleSetFlexDirection(node, YGFlexDirectionRow); }
+  static void setWrap(Node node) { YGNodeStyleSetFlexWrap(node, YGWrapWrap); }
+  static void setAbsolute(Node node) { YGNodeStyleSetPositionType(node, YGPositionTypeAbsolute); }
+  static void setLeft(Node node, float value) { YGNodeStyleSetPosition(node, YGEdgeLeft, value); }
+  static void setTop(Node node, float value) { YGNodeStyleSetPosition(node, YGEdgeTop, value); }
+  static void setRight(Node node, float value) { YGNodeStyleSetPosition(node, YGEdgeRight, value); }
+  static void setBottom(Node node, float value) {
+    YGNodeStyleSetPosition(node, YGEdgeBottom, value);
   }
-
-  return 0;
-}
-
-static void __printBenchmarkResult(char* name, clock_t start, clock_t* endTimes) {
-  double timesInMs[NUM_REPETITIONS];
-  double mean = 0;
-  clock_t lastEnd = start;
-  for (uint32_t i = 0; i < NUM_REPETITIONS; i++) {
-    timesInMs[i] = (endTimes[i] - lastEnd) / static_cast<double>(CLOCKS_PER_SEC) * 1000;
-    lastEnd = endTimes[i];
-    mean += timesInMs[i];
+  static void setText(Node node, uint32_t chars) {
+    YGNodeSetContext(node, reinterpret_cast<void*>(static_cast<uintptr_t>(chars)));
+    YGNodeSetMeasureFunc(node, _measureText);
   }
-  mean /= NUM_REPETITIONS;
-
-  qsort(timesInMs, NUM_REPETITIONS, sizeof(double), __compareDoubles);
-  double median = timesInMs[NUM_REPETITIONS / 2];
-
-  double variance = 0;
-  for (uint32_t i = 0; i < NUM_REPETITIONS; i++) {
-    variance += pow(timesInMs[i] - mean, 2);
+  static void markDirty(Node node) { YGNodeMarkDirty(node); }
+  static void layout(Node root, float width, float height) {
+    YGNodeCalculateLayout(root, width, height, YGDirectionLTR);
   }
-  variance /= NUM_REPETITIONS;
-  double stddev = sqrt(variance);
+};
 
-  printf("%s: median: %lf ms, stddev: %lf ms\n", name, median, stddev);
+int main(int argc, char const* argv[]) {
+  LayoutBenchmark bench("yoga", argc, argv);
+  runLayoutScenarios<YogaEngine>(bench);
+  return bench.writeJson() ? 0 : 1;
 }
-
-static YGSize _measure(YGNodeRef node,
-                       float width,
-                       YGMeasureMode widthMode,
-                       float height,
-                       YGMeasureMode heightMode) {
-  YGSize size = {widthMode == YGMeasureModeUndefined ? 10 : width,
-                 heightMode == YGMeasureModeUndefined ? 10 : width};
-  return size;
-}
-
-YGBENCHMARKS({
-  YGBENCHMARK("Stack with flex", {
-    const YGNodeRef root = YGNodeNew();
-    YGNodeStyleSetWidth(root, 100);
-    YGNodeStyleSetHeight(root, 100);
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const YGNodeRef child = YGNodeNew();
-      YGNodeSetMeasureFunc(child, _measure);
-      YGNodeStyleSetFlex(child, 1);
-      YGNodeInsertChild(root, child, 0);
-    }
-
-    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
-    YGNodeFreeRecursive(root);
-  });
-
-  YGBENCHMARK("Align stretch in undefined axis", {
-    const YGNodeRef root = YGNodeNew();
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const YGNodeRef child = YGNodeNew();
-      YGNodeStyleSetHeight(child, 20);
-      YGNodeSetMeasureFunc(child, _measure);
-      YGNodeInsertChild(root, child, 0);
-    }
-
-    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
-    YGNodeFreeRecursive(root);
-  });
-
-  YGBENCHMARK("Nested flex", {
-    const YGNodeRef root = YGNodeNew();
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const YGNodeRef child = YGNodeNew();
-      YGNodeStyleSetFlex(child, 1);
-      YGNodeInsertChild(root, child, 0);
-
-      for (uint32_t ii = 0; ii < 10; ii++) {
-        const YGNodeRef grandChild = YGNodeNew();
-        YGNodeSetMeasureFunc(grandChild, _measure);
-        YGNodeStyleSetFlex(grandChild, 1);
-        YGNodeInsertChild(child, grandChild, 0);
-      }
-    }
-
-    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
-    YGNodeFreeRecursive(root);
-  });
-
-  YGBENCHMARK("Huge nested layout", {
-    const YGNodeRef root = YGNodeNew();
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const YGNodeRef child = YGNodeNew();
-      YGNodeStyleSetFlexGrow(child, 1);
-      YGNodeStyleSetWidth(child, 10);
-      YGNodeStyleSetHeight(child, 10);
-      YGNodeInsertChild(root, child, 0);
-
-      for (uint32_t ii = 0; ii < 10; ii++) {
-        const YGNodeRef grandChild = YGNodeNew();
-        YGNodeStyleSetFlexDirection(grandChild, YGFlexDirectionRow);
-        YGNodeStyleSetFlexGrow(grandChild, 1);
-        YGNodeStyleSetWidth(grandChild, 10);
-        YGNodeStyleSetHeight(grandChild, 10);
-        YGNodeInsertChild(child, grandChild, 0);
-
-        for (uint32_t iii = 0; iii < 10; iii++) {
-          const YGNodeRef grandGrandChild = YGNodeNew();
-          YGNodeStyleSetFlexGrow(grandGrandChild, 1);
-          YGNodeStyleSetWidth(grandGrandChild, 10);
-          YGNodeStyleSetHeight(grandGrandChild, 10);
-          YGNodeInsertChild(grandChild, grandGrandChild, 0);
-
-          for (uint32_t iiii = 0; iiii < 10; iiii++) {
-            const YGNodeRef grandGrandGrandChild = YGNodeNew();
-            YGNodeStyleSetFlexDirection(grandGrandGrandChild, YGFlexDirectionRow);
-            YGNodeStyleSetFlexGrow(grandGrandGrandChild, 1);
-            YGNodeStyleSetWidth(grandGrandGrandChild, 10);
-            YGNodeStyleSetHeight(grandGrandGrandChild, 10);
-            YGNodeInsertChild(grandGrandChild, grandGrandGrandChild, 0);
-          }
-        }
-      }
-    }
-
-    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
-    YGNodeFreeRecursive(root);
-  });
-
-  // added by ianwang(honwsn@gmail.com) ,for no style test that will cost more time then the
-  // previous test case.
-  YGBENCHMARK("Huge nested layout, no style width & height", {
-    const YGNodeRef root = YGNodeNew();
-
-    for (uint32_t i = 0; i < 10; i++) {
-      const YGNodeRef child = YGNodeNew();
-      YGNodeStyleSetFlexGrow(child, 1);
-      //        YGNodeStyleSetWidth(child, 10);
-      //        YGNodeStyleSetHeight(child, 10);
-      YGNodeInsertChild(root, child, 0);
-
-      for (uint32_t ii = 0; ii < 10; ii++) {
-        const YGNodeRef grandChild = YGNodeNew();
-        YGNodeStyleSetFlexDirection(grandChild, YGFlexDirectionRow);
-        YGNodeStyleSetFlexGrow(grandChild, 1);
-        //          YGNodeStyleSetWidth(grandChild, 10);
-        //          YGNodeStyleSetHeight(grandChild, 10);
-        YGNodeInsertChild(child, grandChild, 0);
-
-        for (uint32_t iii = 0; iii < 10; iii++) {
-          const YGNodeRef grandGrandChild = YGNodeNew();
-          YGNodeStyleSetFlexGrow(grandGrandChild, 1);
-          //            YGNodeStyleSetWidth(grandGrandChild, 10);
-          //            YGNodeStyleSetHeight(grandGrandChild, 10);
-          YGNodeInsertChild(grandChild, grandGrandChild, 0);
-
-          for (uint32_t iiii = 0; iiii < 10; iiii++) {
-            const YGNodeRef grandGrandGrandChild = YGNodeNew();
-            YGNodeStyleSetFlexDirection(grandGrandGrandChild, YGFlexDirectionRow);
-            YGNodeStyleSetFlexGrow(grandGrandGrandChild, 1);
-            YGNodeStyleSetWidth(grandGrandGrandChild, 10);
-            YGNodeStyleSetHeight(grandGrandGrandChild, 10);
-            YGNodeInsertChild(grandGrandChild, grandGrandGrandChild, 0);
-          }
-        }
-      }
-    }
-
-    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
-    YGNodeFreeRecursive(root);
-  });
-});
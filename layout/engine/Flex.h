@@ -126,10 +126,11 @@ typedef struct {
   MeasureMode heightMeasureMode;
 } HPSizeMode;
 
-// following arrays mapping with axis's direction
-const CSSDirection axisStart[4] = {CSSLeft, CSSRight, CSSTop, CSSBottom};
-const CSSDirection axisEnd[4] = {CSSRight, CSSLeft, CSSBottom, CSSTop};
-const Dimension axisDim[4] = {DimWidth, DimWidth, DimHeight, DimHeight};
+// following arrays mapping with axis's direction,
+// static as this header is also included by objective-c files on ios.
+static const CSSDirection axisStart[4] = {CSSLeft, CSSRight, CSSTop, CSSBottom};
+static const CSSDirection axisEnd[4] = {CSSRight, CSSLeft, CSSBottom, CSSTop};
+static const Dimension axisDim[4] = {DimWidth, DimWidth, DimHeight, DimHeight};
 
 bool inline isRowDirection(FlexDirection dir) {
   return dir == FLexDirectionRow || dir == FLexDirectionRowReverse;
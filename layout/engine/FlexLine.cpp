@@ -23,6 +23,10 @@
 #include "HPUtil.h"
 
 FlexLine::FlexLine(HPNodeRef container) {
+  reset(container);
+}
+
+void FlexLine::reset(HPNodeRef container) {
   ASSERT(container != nullptr);
   flexContainer = container;
   sumHypotheticalMainSize = 0;
@@ -33,6 +37,7 @@ FlexLine::FlexLine(HPNodeRef container) {
   initialFreeSpace = 0;
   remainingFreeSpace = 0;
   containerMainInnerSize = 0;
+  items.clear();
 }
 
 /*
@@ -79,7 +84,7 @@ void FlexLine::FreezeInflexibleItems(FlexLayoutAction layoutAction) {
   FlexDirection mainAxis = flexContainer->style.flexDirection;
   FlexSign flexSign = Sign();
   remainingFreeSpace = containerMainInnerSize - sumHypotheticalMainSize;
-  std::vector<HPNodeRef> inFlexibleItems;
+  inFlexibleItems.clear();
   for (size_t i = 0; i < items.size(); i++) {
     HPNodeRef item = items[i];
     if (layoutAction == LayoutActionLayout) {
@@ -133,8 +138,8 @@ bool FlexLine::ResolveFlexibleLengths() {
   FlexDirection mainAxis = flexContainer->style.flexDirection;
   float usedFreeSpace = 0;
   float totalViolation = 0;
-  std::vector<HPNodeRef> minViolations;
-  std::vector<HPNodeRef> maxViolations;
+  minViolations.clear();
+  maxViolations.clear();
 
   FlexSign flexSign = Sign();
   float sumFlexFactors = (flexSign == PositiveFlexibility) ? totalFlexGrow : totalFlexShrink;
@@ -270,7 +275,7 @@ void FlexLine::alignItems() {
 
   // 2. Align the items along the main-axis per justify-content.
   float offset = flexContainer->getStartPaddingAndBorder(mainAxis);
-  HPStyle style = flexContainer->getStyle();
+  HPStyle& style = flexContainer->style;
   float space = 0;
   switch (style.justifyContent) {
     case FlexAlignStart:
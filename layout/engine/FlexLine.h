@@ -32,6 +32,8 @@ enum FlexSign {
 class FlexLine {
  public:
   explicit FlexLine(HPNodeRef container);
+  // clear line data for another container, see HPFlexLineArena.
+  void reset(HPNodeRef container);
   void addItem(HPNodeRef item);
   bool isEmpty();
   FlexSign Sign() const {
@@ -64,4 +66,10 @@ class FlexLine {
   // init in FreezeInflexibleItems...
   float initialFreeSpace;
   float remainingFreeSpace;
+
+ private:
+  // scratch lists of resolving flexible lengths, capacity kept on reuse.
+  std::vector<HPNodeRef> inFlexibleItems;
+  std::vector<HPNodeRef> minViolations;
+  std::vector<HPNodeRef> maxViolations;
 };
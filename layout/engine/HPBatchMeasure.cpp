@@ -0,0 +1,110 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPBatchMeasure.h"
+
+HPBatchMeasure::HPBatchMeasure(HPNodeRef root) {
+  this->root = root;
+}
+
+HPBatchMeasure::~HPBatchMeasure() {}
+
+static inline bool SizeIsSame(float size, float other) {
+  return (isUndefined(size) && isUndefined(other)) || size == other;
+}
+
+bool HPBatchMeasure::isSameRequest(const HPMeasureRequest& request,
+                                   float width,
+                                   MeasureMode widthMeasureMode,
+                                   float height,
+                                   MeasureMode heightMeasureMode) {
+  return request.widthMeasureMode == widthMeasureMode &&
+         request.heightMeasureMode == heightMeasureMode && SizeIsSame(request.width, width) &&
+         SizeIsSame(request.height, height);
+}
+
+bool HPBatchMeasure::getResult(HPNodeRef node,
+                               float width,
+                               MeasureMode widthMeasureMode,
+                               float height,
+                               MeasureMode heightMeasureMode,
+                               HPSize& resultSize) {
+  // nodes may be laid out in worker threads in parallel layout.
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = results.find(node);
+  if (it != results.end()) {
+    std::vector<HPMeasureRequest>& measured = it->second;
+    for (size_t i = 0; i < measured.size(); i++) {
+      if (isSameRequest(measured[i], width, widthMeasureMode, height, heightMeasureMode)) {
+        resultSize = measured[i].result;
+        return true;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < requests.size(); i++) {
+    if (requests[i].node == node &&
+        isSameRequest(requests[i], width, widthMeasureMode, height, heightMeasureMode)) {
+      return false;
+    }
+  }
+  HPMeasureRequest request;
+  request.node = node;
+  request.context = node->getContext();
+  request.width = width;
+  request.widthMeasureMode = widthMeasureMode;
+  request.height = height;
+  request.heightMeasureMode = heightMeasureMode;
+  request.result = HPSize{0, 0};
+  requests.push_back(request);
+  return false;
+}
+
+bool HPBatchMeasure::hasRequests() {
+  return !requests.empty();
+}
+
+uint32_t HPBatchMeasure::requestCount() {
+  return requests.size();
+}
+
+void HPBatchMeasure::measure(HPBatchMeasureFunc batchMeasureFunc, void* layoutContext) {
+  if (requests.empty()) {
+    return;
+  }
+  batchMeasureFunc(requests.data(), requests.size(), layoutContext);
+
+  for (size_t i = 0; i < requests.size(); i++) {
+    results[requests[i].node].push_back(requests[i]);
+    // last pass has laid out with the zero size already.
+    if (requests[i].result.width != 0 || requests[i].result.height != 0) {
+      invalidateLayoutCache(requests[i].node);
+    }
+  }
+  requests.clear();
+}
+
+// layout of the node and its ancestors used a zero size of the node,
+// clear their layout caches to redo layout with the measure result.
+void HPBatchMeasure::invalidateLayoutCache(HPNodeRef node) {
+  for (; node != nullptr; node = node->getParent()) {
+    node->layoutCache.clearCache();
+    if (node == root) {
+      break;
+    }
+  }
+}
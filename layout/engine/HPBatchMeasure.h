@@ -0,0 +1,77 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module collects measure requests of a layout pass for
+ * HPBatchMeasureFunc. a pass in batch measure mode doesn't call measure
+ * functions, content nodes not measured yet get a zero size and their
+ * requests are collected. after the pass all requests are measured in one
+ * batch call, layout caches of the requesting nodes and their ancestors are
+ * cleared, and the pass runs again with the results. it's repeated until a
+ * pass makes no new request.
+ * a pass again only lays out the paths from root to nodes measured to a
+ * non zero size, other subtrees hit their layout caches unless the new sizes
+ * change their constraints. a new round is needed only when a measured size
+ * changes the available size of another content node, e.g. nested rows
+ * that shrink a text and the content of next level beside each other.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "HPNode.h"
+
+// stop batching after this many rounds. in the worst case a layout makes
+// this many batch calls and one more pass than that, the last pass calls
+// measure functions of content nodes whose requests are still new.
+#define HP_MAX_BATCH_MEASURE_ROUNDS 8
+
+class HPBatchMeasure {
+ public:
+  explicit HPBatchMeasure(HPNodeRef root);
+  virtual ~HPBatchMeasure();
+  // measure result of the node in a former batch, or false and the request
+  // is added to next batch.
+  bool getResult(HPNodeRef node,
+                 float width,
+                 MeasureMode widthMeasureMode,
+                 float height,
+                 MeasureMode heightMeasureMode,
+                 HPSize& resultSize);
+  bool hasRequests();
+  uint32_t requestCount();
+  // call batchMeasureFunc for collected requests and invalidate layout
+  // caches of their nodes up to root.
+  void measure(HPBatchMeasureFunc batchMeasureFunc, void* layoutContext);
+
+ protected:
+  static bool isSameRequest(const HPMeasureRequest& request,
+                            float width,
+                            MeasureMode widthMeasureMode,
+                            float height,
+                            MeasureMode heightMeasureMode);
+  void invalidateLayoutCache(HPNodeRef node);
+
+ private:
+  HPNodeRef root;
+  std::mutex mutex;
+  std::vector<HPMeasureRequest> requests;
+  // node -> its measured requests
+  std::unordered_map<HPNodeRef, std::vector<HPMeasureRequest>> results;
+};
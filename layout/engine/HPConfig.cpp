@@ -21,10 +21,136 @@
 
 #include "HPConfig.h"
 
+#include "HPNodePool.h"
+#include "HPPixelGrid.h"
+#include "HPSharedMeasureCache.h"
+#include "HPThreadPool.h"
+#include "HPTrace.h"
+
+HPConfig::~HPConfig() {
+  delete nodePool;
+  nodePool = nullptr;
+  delete threadPool;
+  threadPool = nullptr;
+  delete sharedMeasureCache;
+  sharedMeasureCache = nullptr;
+  delete pixelGrid;
+  pixelGrid = nullptr;
+  delete tracer;
+  tracer = nullptr;
+}
+
+void HPConfig::CopySettings(HPConfig* other) {
+  SetScaleFactor(other->scaleFactor);
+  SetUseNodePool(other->useNodePool);
+  SetIncrementalLayout(other->incrementalLayout);
+  SetRetainDetachedLayout(other->retainDetachedLayout);
+  SetParallelLayout(other->threadPool != nullptr ? other->threadPool->threadCount() : 0,
+                    other->parallelTaskNodes);
+  SetMeasureCacheCapacity(other->measureCacheCapacity);
+  SetSharedMeasureCacheCapacity(
+      other->sharedMeasureCache != nullptr ? other->sharedMeasureCache->getCapacity() : 0);
+  if (other->tracer != nullptr && other->tracer->isEnabled()) {
+    GetTracer()->setEnabled(true);
+  }
+}
+
 void HPConfig::SetScaleFactor(float scaleFactor) {
     this->scaleFactor = scaleFactor;
 }
 
 float HPConfig::GetScaleFactor() {
     return this->scaleFactor;
-}
\ No newline at end of file
+}
+
+void HPConfig::SetUseNodePool(bool useNodePool) {
+  this->useNodePool = useNodePool;
+  if (useNodePool && nodePool == nullptr) {
+    nodePool = new HPNodePool();
+  } else if (!useNodePool && nodePool != nullptr && nodePool->liveCount() == 0) {
+    // pool can only be released when all its nodes have been freed,
+    // otherwise keep it, these nodes still give back memory to it.
+    delete nodePool;
+    nodePool = nullptr;
+  }
+}
+
+bool HPConfig::UseNodePool() {
+  return useNodePool;
+}
+
+HPNodePool* HPConfig::GetNodePool() {
+  return nodePool;
+}
+
+void HPConfig::SetIncrementalLayout(bool incrementalLayout) {
+  this->incrementalLayout = incrementalLayout;
+}
+
+bool HPConfig::UseIncrementalLayout() {
+  return incrementalLayout;
+}
+
+void HPConfig::SetRetainDetachedLayout(bool retainDetachedLayout) {
+  this->retainDetachedLayout = retainDetachedLayout;
+}
+
+bool HPConfig::RetainDetachedLayout() {
+  return retainDetachedLayout;
+}
+
+HPLayoutStats HPConfig::GetLayoutStats() {
+  HPLayoutStats stats = {visitCount, relayoutAloneCount, batchMeasureCount};
+  return stats;
+}
+
+void HPConfig::SetParallelLayout(uint32_t threadCount, uint32_t minTaskNodes) {
+  parallelTaskNodes = minTaskNodes > 0 ? minTaskNodes : 1;
+  if (threadPool != nullptr && threadPool->threadCount() == threadCount) {
+    return;
+  }
+  delete threadPool;
+  threadPool = threadCount > 0 ? new HPThreadPool(threadCount) : nullptr;
+}
+
+bool HPConfig::UseParallelLayout() {
+  return threadPool != nullptr;
+}
+
+HPThreadPool* HPConfig::GetThreadPool() {
+  return threadPool;
+}
+
+void HPConfig::SetMeasureCacheCapacity(uint32_t capacity) {
+  measureCacheCapacity = capacity > 0 ? capacity : 1;
+}
+
+uint32_t HPConfig::GetMeasureCacheCapacity() {
+  return measureCacheCapacity;
+}
+
+void HPConfig::SetSharedMeasureCacheCapacity(uint32_t capacity) {
+  if (sharedMeasureCache != nullptr && sharedMeasureCache->getCapacity() == capacity) {
+    return;
+  }
+  delete sharedMeasureCache;
+  sharedMeasureCache = capacity > 0 ? new HPSharedMeasureCache(capacity) : nullptr;
+}
+
+HPSharedMeasureCache* HPConfig::GetSharedMeasureCache() {
+  return sharedMeasureCache;
+}
+
+HPPixelGrid* HPConfig::GetPixelGrid() {
+  if (pixelGrid == nullptr) {
+    pixelGrid = new HPPixelGrid();
+  }
+  return pixelGrid;
+}
+
+HPTracer* HPConfig::GetTracer() {
+  if (tracer == nullptr) {
+    tracer = new HPTracer();
+  }
+  return tracer;
+}
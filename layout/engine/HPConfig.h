@@ -21,13 +21,98 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <atomic>
+
+#include "HPLayoutCache.h"
+
+class HPNodePool;
+class HPThreadPool;
+class HPSharedMeasureCache;
+class HPBatchMeasure;
+class HPPixelGrid;
+class HPTracer;
+
+// in parallel layout, an item is laid out in a worker thread only when its
+// subtree has this many nodes by default, smaller ones cost less than a
+// dispatch.
+#define HP_MIN_PARALLEL_TASK_NODES 64
+
+typedef struct {
+  // layoutImpl calls in last layout pass, include the ones hit layout cache.
+  uint32_t visitCount;
+  // dirty nodes relayout alone without their parents in last pass,
+  // see HPNode::relayoutAlone
+  uint32_t relayoutAloneCount;
+  // HPBatchMeasureFunc calls in last pass, see HPBatchMeasure.h
+  uint32_t batchMeasureCount;
+} HPLayoutStats;
+
 class HPConfig {
  public:
+  virtual ~HPConfig();
+  // take settings of other, not its scratch state or content of its pools
+  // and caches.
+  void CopySettings(HPConfig* other);
   void SetScaleFactor(float scaleFactor);
   float GetScaleFactor();
+  // nodes created by HPNodeNewWithConfig after this call are allocated
+  // from the config's node pool. free all pooled nodes before HPConfigFree.
+  void SetUseNodePool(bool useNodePool);
+  bool UseNodePool();
+  HPNodePool* GetNodePool();
+  // dirty state stops at the parent of a changed node. in next pass dirty
+  // nodes are relayout alone with the inputs of last pass, and their
+  // ancestors only up to the first one whose size stays the same.
+  void SetIncrementalLayout(bool incrementalLayout);
+  bool UseIncrementalLayout();
+  // children removed from nodes of this config keep their layout results
+  // and cache, a subtree inserted again with the same styles is not laid out
+  // again if it gets the same constraints, e.g. recycled list cells.
+  void SetRetainDetachedLayout(bool retainDetachedLayout);
+  bool RetainDetachedLayout();
+  // statistics of last layout pass of trees using this config.
+  HPLayoutStats GetLayoutStats();
+  // layout independent subtrees of at least minTaskNodes nodes in
+  // threadCount worker threads, 0 to disable. measure functions must be safe
+  // to call from any thread in this mode.
+  void SetParallelLayout(uint32_t threadCount,
+                         uint32_t minTaskNodes = HP_MIN_PARALLEL_TASK_NODES);
+  bool UseParallelLayout();
+  HPThreadPool* GetThreadPool();
+  // count of measure results kept in each node's layout cache,
+  // applied to nodes created or set with this config afterwards.
+  void SetMeasureCacheCapacity(uint32_t capacity);
+  uint32_t GetMeasureCacheCapacity();
+  // measure results shared by nodes with same content hash,
+  // see HPNodeSetMeasureContentHash. capacity 0 to disable.
+  void SetSharedMeasureCacheCapacity(uint32_t capacity);
+  HPSharedMeasureCache* GetSharedMeasureCache();
+  // scratch arrays of pixel grid rounding after a layout pass.
+  HPPixelGrid* GetPixelGrid();
+  // runtime tracing of layout passes, created on first call and off until
+  // it's enabled, see HPTrace.h.
+  HPTracer* GetTracer();
 
  public:
   float scaleFactor = 1.0f;
+  bool useNodePool = false;
+  HPNodePool* nodePool = nullptr;
+  bool incrementalLayout = false;
+  bool retainDetachedLayout = false;
+  // counters of HPLayoutStats, updated from worker threads in parallel layout.
+  std::atomic<uint32_t> visitCount{0};
+  std::atomic<uint32_t> relayoutAloneCount{0};
+  std::atomic<uint32_t> batchMeasureCount{0};
+  HPThreadPool* threadPool = nullptr;
+  uint32_t parallelTaskNodes = HP_MIN_PARALLEL_TASK_NODES;
+  uint32_t measureCacheCapacity = MAX_MEASURES_COUNT;
+  HPSharedMeasureCache* sharedMeasureCache = nullptr;
+  // requests of current pass in batch measure mode, null in other time.
+  HPBatchMeasure* batchMeasure = nullptr;
+  HPPixelGrid* pixelGrid = nullptr;
+  HPTracer* tracer = nullptr;
 };
 
 typedef HPConfig *HPConfigRef;
\ No newline at end of file
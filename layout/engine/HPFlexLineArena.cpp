@@ -0,0 +1,79 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPFlexLineArena.h"
+
+#include "FlexLine.h"
+#include "HPUtil.h"
+
+HPFlexLineArena::HPFlexLineArena() : usedLines(0), depth(0) {}
+
+HPFlexLineArena::~HPFlexLineArena() {
+  for (size_t i = 0; i < lines.size(); i++) {
+    delete lines[i];
+  }
+  lines.clear();
+  for (size_t i = 0; i < frames.size(); i++) {
+    delete frames[i];
+  }
+  frames.clear();
+}
+
+HPFlexLineArena* HPFlexLineArena::current() {
+  static thread_local HPFlexLineArena arena;
+  return &arena;
+}
+
+std::vector<FlexLine*>& HPFlexLineArena::pushFrame() {
+  if (depth == frames.size()) {
+    frames.push_back(new std::vector<FlexLine*>());
+    frameMarks.push_back(0);
+  }
+  frameMarks[depth] = usedLines;
+  std::vector<FlexLine*>& frame = *frames[depth];
+  frame.clear();
+  depth++;
+  return frame;
+}
+
+FlexLine* HPFlexLineArena::newLine(HPNodeRef container) {
+  ASSERT(depth > 0);
+  FlexLine* line;
+  if (usedLines < lines.size()) {
+    line = lines[usedLines];
+    line->reset(container);
+  } else {
+    line = new FlexLine(container);
+    lines.push_back(line);
+  }
+  usedLines++;
+  return line;
+}
+
+void HPFlexLineArena::popFrame() {
+  ASSERT(depth > 0);
+  depth--;
+  usedLines = frameMarks[depth];
+}
+
+uint32_t HPFlexLineArena::lineCapacity() {
+  return lines.size();
+}
+
+uint32_t HPFlexLineArena::frameDepth() {
+  return depth;
+}
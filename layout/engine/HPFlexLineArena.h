@@ -0,0 +1,62 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module is a scratch arena for flex lines of layout passes.
+ * layoutImpl of a container takes a frame from the arena for its lines and
+ * gives it back before return, nested layouts of its items take frames above
+ * it, so frames are used in stack order. FlexLine objects, their item lists
+ * and frame vectors are kept for later passes, so laying out a tree again
+ * doesn't allocate lines. one arena serves one thread, trees of all configs
+ * laid out on the thread share it, see HPFlexLineArena::current.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+class FlexLine;
+class HPNode;
+typedef HPNode* HPNodeRef;
+
+class HPFlexLineArena {
+ public:
+  HPFlexLineArena();
+  virtual ~HPFlexLineArena();
+  // arena of calling thread, created on first call and freed with the thread.
+  static HPFlexLineArena* current();
+  // start a frame, return the empty line list of it.
+  std::vector<FlexLine*>& pushFrame();
+  // a reset line owned by current frame, caller adds it to the line list.
+  FlexLine* newLine(HPNodeRef container);
+  // give back lines of current frame.
+  void popFrame();
+  // count of FlexLine objects created by this arena.
+  uint32_t lineCapacity();
+  uint32_t frameDepth();
+
+ private:
+  std::vector<FlexLine*> lines;
+  // lines in [0, usedLines) are used by frames.
+  uint32_t usedLines;
+  // pointers keep frame vectors in place when frames grows.
+  std::vector<std::vector<FlexLine*>*> frames;
+  // usedLines when frame was pushed.
+  std::vector<uint32_t> frameMarks;
+  uint32_t depth;
+};
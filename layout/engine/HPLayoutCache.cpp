@@ -25,10 +25,48 @@
 #endif
 
 HPLayoutCache::HPLayoutCache() {
+  cachedMeasures = inlineMeasures;
+  capacity = MAX_MEASURES_COUNT;
+  useStamp = 0;
+  resetStats();
   initCache();
 }
 
-HPLayoutCache::~HPLayoutCache() {}
+HPLayoutCache::~HPLayoutCache() {
+  if (cachedMeasures != inlineMeasures) {
+    delete[] cachedMeasures;
+  }
+}
+
+void HPLayoutCache::setCapacity(uint32_t capacity) {
+  if (capacity == 0) {
+    capacity = 1;
+  }
+  if (capacity == this->capacity) {
+    return;
+  }
+  if (cachedMeasures != inlineMeasures) {
+    delete[] cachedMeasures;
+  }
+  cachedMeasures =
+      capacity > MAX_MEASURES_COUNT ? new MeasureResult[capacity] : inlineMeasures;
+  this->capacity = capacity;
+  initCache();
+}
+
+uint32_t HPLayoutCache::getCapacity() {
+  return capacity;
+}
+
+HPMeasureCacheStats HPLayoutCache::getStats() {
+  return stats;
+}
+
+void HPLayoutCache::resetStats() {
+  stats.hits = 0;
+  stats.misses = 0;
+  stats.evictions = 0;
+}
 
 void HPLayoutCache::cacheResult(HPSize availableSize,
                                 HPSize resultSize,
@@ -41,12 +79,26 @@ void HPLayoutCache::cacheResult(HPSize availableSize,
     cachedLayout.resultSize = resultSize;
     cachedLayout.layoutAction = layoutAction;
   } else {
-    cachedMeasures[nextMeasureIndex].availableSize = availableSize;
-    cachedMeasures[nextMeasureIndex].widthMeasureMode = measureMode.widthMeasureMode;
-    cachedMeasures[nextMeasureIndex].heightMeasureMode = measureMode.heightMeasureMode;
-    cachedMeasures[nextMeasureIndex].resultSize = resultSize;
-    cachedMeasures[nextMeasureIndex].layoutAction = layoutAction;
-    nextMeasureIndex = (nextMeasureIndex + 1) % MAX_MEASURES_COUNT;
+    uint32_t index = measureCount;
+    if (measureCount < capacity) {
+      measureCount++;
+    } else {
+      // full, replace the least recently used one.
+      index = 0;
+      for (uint32_t i = 1; i < measureCount; i++) {
+        if (cachedMeasures[i].lastUsed < cachedMeasures[index].lastUsed) {
+          index = i;
+        }
+      }
+      stats.evictions++;
+    }
+    MeasureResult& cacheMeasure = cachedMeasures[index];
+    cacheMeasure.availableSize = availableSize;
+    cacheMeasure.widthMeasureMode = measureMode.widthMeasureMode;
+    cacheMeasure.heightMeasureMode = measureMode.heightMeasureMode;
+    cacheMeasure.resultSize = resultSize;
+    cacheMeasure.layoutAction = layoutAction;
+    cacheMeasure.lastUsed = ++useStamp;
   }
 }
 
@@ -77,11 +129,7 @@ MeasureResult* HPLayoutCache::useMeasureCacheIfPossible(HPSize availableSize,
                                                         HPSizeMode measureMode,
                                                         FlexLayoutAction layoutAction,
                                                         bool isMeasureNode) {
-  if (nextMeasureIndex <= 0) {
-    return nullptr;
-  }
-
-  for (uint32_t i = 0; i < nextMeasureIndex; i++) {
+  for (uint32_t i = 0; i < measureCount; i++) {
     MeasureResult& cacheMeasure = cachedMeasures[i];
     if (layoutAction != cacheMeasure.layoutAction && !isMeasureNode) {
       continue;
@@ -137,6 +185,7 @@ MeasureResult* HPLayoutCache::useMeasureCacheIfPossible(HPSize availableSize,
 #ifdef __DEBUG__
       HPLogd("cache: action:%d\n", cacheMeasure.layoutAction);
 #endif
+      cacheMeasure.lastUsed = ++useStamp;
       return &cacheMeasure;
     }
   }
@@ -167,19 +216,52 @@ MeasureResult* HPLayoutCache::getCachedMeasureResult(HPSize availableSize,
                                                      HPSizeMode measureMode,
                                                      FlexLayoutAction layoutAction,
                                                      bool isMeasureNode) {
+  MeasureResult* result = nullptr;
   if (isMeasureNode) {
-    MeasureResult* result = useLayoutCacheIfPossible(availableSize, measureMode);
-    if (result != nullptr) {
-      return result;
+    result = useLayoutCacheIfPossible(availableSize, measureMode);
+    if (result == nullptr) {
+      result = useMeasureCacheIfPossible(availableSize, measureMode, layoutAction, isMeasureNode);
     }
-    return useMeasureCacheIfPossible(availableSize, measureMode, layoutAction, isMeasureNode);
   } else if (layoutAction == LayoutActionLayout) {
-    return useLayoutCacheIfPossible(availableSize, measureMode);
+    result = useLayoutCacheIfPossible(availableSize, measureMode);
   } else {
-    return useMeasureCacheIfPossible(availableSize, measureMode, layoutAction, isMeasureNode);
+    result = useMeasureCacheIfPossible(availableSize, measureMode, layoutAction, isMeasureNode);
   }
 
-  return nullptr;
+  if (result != nullptr) {
+    stats.hits++;
+  } else {
+    stats.misses++;
+  }
+  return result;
+}
+
+uint32_t HPLayoutCache::getEntries(MeasureResult* layout,
+                                   MeasureResult* measures,
+                                   uint32_t maxCount) {
+  *layout = cachedLayout;
+  uint32_t count = measureCount < maxCount ? measureCount : maxCount;
+  for (uint32_t i = 0; i < count; i++) {
+    measures[i] = cachedMeasures[i];
+  }
+  return count;
+}
+
+void HPLayoutCache::setEntries(const MeasureResult& layout,
+                               const MeasureResult* measures,
+                               uint32_t count) {
+  initCache();
+  cachedLayout = layout;
+  if (count > capacity) {
+    count = capacity;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    cachedMeasures[i] = measures[i];
+    if (measures[i].lastUsed > useStamp) {
+      useStamp = measures[i].lastUsed;
+    }
+  }
+  measureCount = count;
 }
 
 MeasureResult* HPLayoutCache::getCachedLayout() {
@@ -191,13 +273,14 @@ void HPLayoutCache::initCache() {
   cachedLayout.resultSize = {VALUE_UNDEFINED, VALUE_UNDEFINED};
   cachedLayout.widthMeasureMode = MeasureModeUndefined;
   cachedLayout.heightMeasureMode = MeasureModeUndefined;
-  for (uint32_t i = 0; i < MAX_MEASURES_COUNT; i++) {
+  for (uint32_t i = 0; i < capacity; i++) {
     cachedMeasures[i].availableSize = {VALUE_UNDEFINED, VALUE_UNDEFINED};
     cachedMeasures[i].resultSize = {VALUE_UNDEFINED, VALUE_UNDEFINED};
     cachedMeasures[i].widthMeasureMode = MeasureModeUndefined;
     cachedMeasures[i].heightMeasureMode = MeasureModeUndefined;
+    cachedMeasures[i].lastUsed = 0;
   }
-  nextMeasureIndex = 0;
+  measureCount = 0;
 }
 
 void HPLayoutCache::clearCache() {
@@ -27,8 +27,21 @@ typedef struct {
   MeasureMode widthMeasureMode;
   MeasureMode heightMeasureMode;
   FlexLayoutAction layoutAction;
+  // stamp of last time this entry cached or hit, least recently used one
+  // is replaced when measure cache is full.
+  uint32_t lastUsed;
 } MeasureResult;
 
+// counters of layout cache lookups, see HPNodeGetMeasureCacheStats
+typedef struct {
+  uint32_t hits;
+  uint32_t misses;
+  // measure results replaced because measure cache is full.
+  uint32_t evictions;
+} HPMeasureCacheStats;
+
+// measure entries kept in HPLayoutCache itself,
+// larger capacity is allocated from heap.
 #define MAX_MEASURES_COUNT 6
 
 class HPLayoutCache {
@@ -45,6 +58,14 @@ class HPLayoutCache {
                                         bool isMeasureNode);
   MeasureResult* getCachedLayout();
   void clearCache();
+  void setCapacity(uint32_t capacity);
+  uint32_t getCapacity();
+  HPMeasureCacheStats getStats();
+  void resetStats();
+  // copy cached results out and back, see HPLayoutSnapshot.
+  // return count of measure results copied, at most maxCount.
+  uint32_t getEntries(MeasureResult* layout, MeasureResult* measures, uint32_t maxCount);
+  void setEntries(const MeasureResult& layout, const MeasureResult* measures, uint32_t count);
 
  protected:
   void initCache();
@@ -56,7 +77,15 @@ class HPLayoutCache {
                                            bool isMeasureNode);
 
  private:
+  HPLayoutCache(const HPLayoutCache&);
+  HPLayoutCache& operator=(const HPLayoutCache&);
+
   MeasureResult cachedLayout;
-  MeasureResult cachedMeasures[MAX_MEASURES_COUNT];
-  uint32_t nextMeasureIndex;
+  MeasureResult inlineMeasures[MAX_MEASURES_COUNT];
+  // inlineMeasures or heap array if capacity > MAX_MEASURES_COUNT
+  MeasureResult* cachedMeasures;
+  uint32_t capacity;
+  uint32_t measureCount;
+  uint32_t useStamp;
+  HPMeasureCacheStats stats;
 };
@@ -0,0 +1,129 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPLayoutExport.h"
+
+#include <string.h>
+
+#include "HPNode.h"
+
+#define HP_EXPORT_BASE_WORDS 5
+#define HP_EXPORT_EDGE_WORDS 4
+
+typedef struct {
+  uint32_t exportFlags;
+  HPLayoutExportIdFunc idFunc;
+  void* context;
+  uint32_t* words;
+  uint32_t capacity;
+  uint32_t recordSize;
+  uint32_t recordCount;
+} HPLayoutExportContext;
+
+uint32_t HPLayoutExportRecordSize(uint32_t exportFlags) {
+  uint32_t size = HP_EXPORT_BASE_WORDS;
+  if (exportFlags & HP_EXPORT_MARGIN) {
+    size += HP_EXPORT_EDGE_WORDS;
+  }
+  if (exportFlags & HP_EXPORT_PADDING) {
+    size += HP_EXPORT_EDGE_WORDS;
+  }
+  if (exportFlags & HP_EXPORT_BORDER) {
+    size += HP_EXPORT_EDGE_WORDS;
+  }
+  return size;
+}
+
+static inline uint32_t* WriteFloat(uint32_t* word, float value) {
+  memcpy(word, &value, sizeof(float));
+  return word + 1;
+}
+
+static inline uint32_t* WriteEdges(uint32_t* word, const float edges[4]) {
+  memcpy(word, edges, sizeof(float) * HP_EXPORT_EDGE_WORDS);
+  return word + HP_EXPORT_EDGE_WORDS;
+}
+
+static void ExportLayoutRecursive(HPNodeRef node, HPLayoutExportContext& ctx) {
+  if (!node->hasNewLayout()) {
+    return;
+  }
+  int32_t id = ctx.idFunc(node, ctx.context);
+  if (id < 0) {
+    return;
+  }
+
+  uint32_t index = ctx.recordCount++;
+  if (index < ctx.capacity) {
+    uint32_t* word = ctx.words + index * ctx.recordSize;
+    memcpy(word++, &id, sizeof(int32_t));
+    word = WriteFloat(word, node->result.position[CSSLeft]);
+    word = WriteFloat(word, node->result.position[CSSTop]);
+    word = WriteFloat(word, node->result.dim[DimWidth]);
+    word = WriteFloat(word, node->result.dim[DimHeight]);
+    // margin, padding and border of HPLayout are in CSSLeft, CSSTop,
+    // CSSRight, CSSBottom order.
+    if (ctx.exportFlags & HP_EXPORT_MARGIN) {
+      word = WriteEdges(word, node->result.margin);
+    }
+    if (ctx.exportFlags & HP_EXPORT_PADDING) {
+      word = WriteEdges(word, node->result.padding);
+    }
+    if (ctx.exportFlags & HP_EXPORT_BORDER) {
+      word = WriteEdges(word, node->result.border);
+    }
+  }
+
+  for (size_t i = 0; i < node->childCount(); i++) {
+    ExportLayoutRecursive(node->getChild(i), ctx);
+  }
+}
+
+static void MarkLayoutSeenRecursive(HPNodeRef node, HPLayoutExportContext& ctx) {
+  if (!node->hasNewLayout() || ctx.idFunc(node, ctx.context) < 0) {
+    return;
+  }
+  node->setHasNewLayout(false);
+  for (size_t i = 0; i < node->childCount(); i++) {
+    MarkLayoutSeenRecursive(node->getChild(i), ctx);
+  }
+}
+
+uint32_t HPNodeExportLayout(HPNodeRef root,
+                            uint32_t exportFlags,
+                            HPLayoutExportIdFunc idFunc,
+                            void* context,
+                            void* buffer,
+                            uint32_t bufferSize) {
+  if (root == nullptr || idFunc == nullptr) {
+    return 0;
+  }
+  HPLayoutExportContext ctx;
+  ctx.exportFlags = exportFlags;
+  ctx.idFunc = idFunc;
+  ctx.context = context;
+  ctx.words = reinterpret_cast<uint32_t*>(buffer);
+  ctx.recordSize = HPLayoutExportRecordSize(exportFlags);
+  ctx.capacity = buffer == nullptr ? 0 : bufferSize / (ctx.recordSize * sizeof(uint32_t));
+  ctx.recordCount = 0;
+  ExportLayoutRecursive(root, ctx);
+
+  if (ctx.recordCount <= ctx.capacity) {
+    MarkLayoutSeenRecursive(root, ctx);
+  }
+  return ctx.recordCount;
+}
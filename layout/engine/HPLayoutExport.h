@@ -0,0 +1,55 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module writes layout results of a tree into one caller owned buffer,
+ * so a platform bridge copies a block of memory instead of setting fields
+ * of its node objects one by one. only nodes with new layout are written,
+ * subtree of a node without new layout is skipped as its layout is unchanged.
+ *
+ * a record is HPLayoutExportRecordSize(exportFlags) 4-byte words:
+ *   int32 id, float left, top, width, height,
+ *   then float left, top, right, bottom of margin, padding and border,
+ *   for each of them requested by exportFlags in this order.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class HPNode;
+typedef HPNode* HPNodeRef;
+
+#define HP_EXPORT_MARGIN 0x1
+#define HP_EXPORT_PADDING 0x2
+#define HP_EXPORT_BORDER 0x4
+
+// id written in the node's record, negative to skip the node and its subtree.
+typedef int32_t (*HPLayoutExportIdFunc)(HPNodeRef node, void* context);
+
+// count of 4-byte words of a record.
+uint32_t HPLayoutExportRecordSize(uint32_t exportFlags);
+
+// write records of nodes with new layout under root into buffer of
+// bufferSize bytes and return the count of records needed.
+// if they all fit, the written nodes are marked as layout seen,
+// otherwise nothing is marked and the caller may retry with a larger buffer.
+uint32_t HPNodeExportLayout(HPNodeRef root,
+                            uint32_t exportFlags,
+                            HPLayoutExportIdFunc idFunc,
+                            void* context,
+                            void* buffer,
+                            uint32_t bufferSize);
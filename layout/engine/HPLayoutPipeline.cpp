@@ -0,0 +1,218 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPLayoutPipeline.h"
+
+#include "Hippy.h"
+
+HPLayoutPipeline::HPLayoutPipeline(HPNodeRef pendingRoot, HPConfigRef config)
+    : pendingRoot(pendingRoot) {
+  // scratch state of a config is used by its layout passes, so the layout
+  // tree doesn't share the config of the pending tree.
+  this->config = new HPConfig();
+  this->config->CopySettings(config != nullptr ? config : pendingRoot->GetConfig());
+  worker = std::thread(&HPLayoutPipeline::run, this);
+}
+
+HPLayoutPipeline::~HPLayoutPipeline() {
+  {
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    stopped = true;
+  }
+  requested.notify_one();
+  worker.join();
+  freeDetached();
+  if (root != nullptr) {
+    freeLayoutNode(root);
+  }
+  HPConfigFree(config);
+}
+
+void HPLayoutPipeline::commit(float parentWidth,
+                              float parentHeight,
+                              HPDirection direction,
+                              void* layoutContext) {
+  {
+    // waits for the pass of last commit if it's running.
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    root = syncNode(pendingRoot);
+    freeDetached();
+    // nothing changed since last pass, its layout stays.
+    if (!layoutRequested && !root->isDirty && !root->hasDirtyDescendant &&
+        FloatIsEqual(this->parentWidth, parentWidth) &&
+        FloatIsEqual(this->parentHeight, parentHeight) && this->direction == direction &&
+        this->layoutContext == layoutContext) {
+      return;
+    }
+    this->parentWidth = parentWidth;
+    this->parentHeight = parentHeight;
+    this->direction = direction;
+    this->layoutContext = layoutContext;
+    layoutRequested = true;
+  }
+  requested.notify_one();
+}
+
+uint32_t HPLayoutPipeline::takeResults(std::vector<HPPublishedLayout>& results) {
+  results.clear();
+  std::lock_guard<std::mutex> lock(resultsMutex);
+  results.swap(published);
+  return publishedPasses;
+}
+
+void HPLayoutPipeline::waitIdle() {
+  std::unique_lock<std::mutex> lock(layoutMutex);
+  finished.wait(lock, [this] { return !layoutRequested; });
+}
+
+void HPLayoutPipeline::setPublishedFunc(HPLayoutPublishedFunc func, void* userData) {
+  std::lock_guard<std::mutex> lock(layoutMutex);
+  publishedFunc = func;
+  publishedUserData = userData;
+}
+
+HPNodeRef HPLayoutPipeline::layoutRoot() {
+  return root;
+}
+
+HPConfigRef HPLayoutPipeline::layoutConfig() {
+  return config;
+}
+
+// copy pending node to its layout tree node, only dirty paths are visited.
+HPNodeRef HPLayoutPipeline::syncNode(HPNodeRef pending) {
+  HPNodeRef node = pending->modeState != nullptr ? pending->modeState->shadow : nullptr;
+  bool created = node == nullptr;
+  if (created) {
+    node = HPNodeNewWithConfig(config);
+    node->getModeState()->origin = pending;
+    pending->getModeState()->shadow = node;
+  } else if (!pending->isDirty && !pending->hasDirtyDescendant) {
+    return node;
+  }
+
+  if (created || pending->isDirty) {
+    node->setStyle(pending->style);
+    node->measure = pending->measure;
+    node->measureContentHash = pending->measureContentHash;
+    node->modeState->hasViewport = pending->modeState->hasViewport;
+    node->modeState->viewport = pending->modeState->viewport;
+    node->context = pending->context;
+    node->markAsDirty();
+  }
+
+  bool childrenChanged = pending->children.size() != node->children.size();
+  for (size_t i = 0; i < pending->children.size(); i++) {
+    HPNodeRef child = syncNode(pending->children[i]);
+    if (!childrenChanged && node->children[i] != child) {
+      childrenChanged = true;
+    }
+  }
+
+  if (childrenChanged) {
+    for (size_t i = 0; i < node->children.size(); i++) {
+      HPNodeRef child = node->children[i];
+      // a child moved to a parent synced before is not ours any more.
+      if (child->parent == node) {
+        child->setParent(nullptr);
+        detached.push_back(child);
+      }
+    }
+    node->children.clear();
+    for (size_t i = 0; i < pending->children.size(); i++) {
+      HPNodeRef child = pending->children[i]->modeState->shadow;
+      node->children.push_back(child);
+      child->setParent(node);
+    }
+    node->markAsDirty();
+  }
+
+  pending->setDirty(false);
+  pending->hasDirtyDescendant = false;
+  return node;
+}
+
+// free removed subtrees, except nodes inserted elsewhere in the same commit.
+void HPLayoutPipeline::freeDetached() {
+  for (size_t i = 0; i < detached.size(); i++) {
+    if (detached[i]->parent == nullptr) {
+      freeLayoutNode(detached[i]);
+    }
+  }
+  detached.clear();
+}
+
+void HPLayoutPipeline::freeLayoutNode(HPNodeRef node) {
+  for (size_t i = 0; i < node->children.size(); i++) {
+    HPNodeRef child = node->children[i];
+    if (child->parent == node) {
+      child->setParent(nullptr);
+      freeLayoutNode(child);
+    }
+  }
+  node->children.clear();
+  HPNodeFree(node);
+}
+
+// records of nodes with new layout, subtree of a node without new layout
+// is skipped as its layout is unchanged.
+void HPLayoutPipeline::publish(HPNodeRef node) {
+  if (!node->hasNewLayout()) {
+    return;
+  }
+  HPPublishedLayout record;
+  record.context = node->context;
+  record.left = HPNodeLayoutGetLeft(node);
+  record.top = HPNodeLayoutGetTop(node);
+  record.width = HPNodeLayoutGetWidth(node);
+  record.height = HPNodeLayoutGetHeight(node);
+  passResults.push_back(record);
+  node->setHasNewLayout(false);
+  for (size_t i = 0; i < node->children.size(); i++) {
+    publish(node->children[i]);
+  }
+}
+
+void HPLayoutPipeline::run() {
+  std::unique_lock<std::mutex> lock(layoutMutex);
+  while (true) {
+    requested.wait(lock, [this] { return stopped || layoutRequested; });
+    if (stopped) {
+      return;
+    }
+
+    HPNodeDoLayout(root, parentWidth, parentHeight, direction, layoutContext);
+    passResults.clear();
+    publish(root);
+    {
+      std::lock_guard<std::mutex> resultsLock(resultsMutex);
+      published.insert(published.end(), passResults.begin(), passResults.end());
+      publishedPasses++;
+    }
+
+    layoutRequested = false;
+    finished.notify_all();
+    HPLayoutPublishedFunc func = publishedFunc;
+    void* userData = publishedUserData;
+    if (func != nullptr) {
+      // not locked, so the function may commit or wait.
+      lock.unlock();
+      func(userData);
+      lock.lock();
+    }
+  }
+}
@@ -0,0 +1,111 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module lays out a node tree in a background thread with double
+ * buffered trees. style setters keep writing the pending tree in the dom
+ * thread, commit() copies its changed parts into a layout tree owned by the
+ * pipeline and starts a pass on the worker thread, and the layout of each
+ * pass is published in one step for the render thread to take. so layout of
+ * frame N+1 overlaps with rendering of frame N. commit() only waits if the
+ * worker is still laying out the last commit. measure functions of the
+ * pending nodes are called in the worker thread.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "HPNode.h"
+
+// layout of one node published by a pass, position is relative to parent.
+typedef struct HPPublishedLayout {
+  // context of the pending node, see HPNode::setContext
+  void* context;
+  float left;
+  float top;
+  float width;
+  float height;
+} HPPublishedLayout;
+
+// called in the worker thread after a pass is published, the pipeline is not
+// locked so it may commit, but waitIdle() there waits for the worker itself.
+typedef void (*HPLayoutPublishedFunc)(void* userData);
+
+class HPLayoutPipeline {
+ public:
+  // layout tree nodes are created with a config of the pipeline, which
+  // copies settings of config, or of pendingRoot's config if null.
+  explicit HPLayoutPipeline(HPNodeRef pendingRoot, HPConfigRef config = nullptr);
+  virtual ~HPLayoutPipeline();
+  // copy changes of pending tree to the layout tree and lay it out in
+  // background, pending nodes are not dirty after it. no pass is started
+  // if neither the tree nor the arguments changed since the last one.
+  void commit(float parentWidth,
+              float parentHeight,
+              HPDirection direction = DirectionLTR,
+              void* layoutContext = nullptr);
+  // move layout published since last call into results,
+  // return the count of published passes so far.
+  uint32_t takeResults(std::vector<HPPublishedLayout>& results);
+  // block until the last commit is laid out and published.
+  void waitIdle();
+  void setPublishedFunc(HPLayoutPublishedFunc func, void* userData);
+  // layout tree, only safe to read between waitIdle() and next commit().
+  HPNodeRef layoutRoot();
+  // config of layout tree, for its stats and trace.
+  HPConfigRef layoutConfig();
+
+ protected:
+  HPNodeRef syncNode(HPNodeRef pending);
+  void freeDetached();
+  void freeLayoutNode(HPNodeRef node);
+  void publish(HPNodeRef node);
+  void run();
+
+ private:
+  HPNodeRef pendingRoot;
+  HPConfigRef config;
+  HPNodeRef root = nullptr;
+  // layout tree nodes removed from their parent in commit()
+  std::vector<HPNodeRef> detached;
+
+  // guards the layout tree and the request below, held by a pass.
+  std::mutex layoutMutex;
+  std::condition_variable requested;
+  std::condition_variable finished;
+  bool layoutRequested = false;
+  bool stopped = false;
+  float parentWidth = VALUE_UNDEFINED;
+  float parentHeight = VALUE_UNDEFINED;
+  HPDirection direction = DirectionLTR;
+  void* layoutContext = nullptr;
+  HPLayoutPublishedFunc publishedFunc = nullptr;
+  void* publishedUserData = nullptr;
+  // written by a pass before it is published.
+  std::vector<HPPublishedLayout> passResults;
+
+  std::mutex resultsMutex;
+  std::vector<HPPublishedLayout> published;
+  uint32_t publishedPasses = 0;
+
+  std::thread worker;
+};
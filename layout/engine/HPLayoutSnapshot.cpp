@@ -0,0 +1,278 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPLayoutSnapshot.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "Hippy.h"
+
+static void saveNode(HPNodeRef node, HPSnapshotNode* record) {
+  memset(record, 0, sizeof(HPSnapshotNode));
+  record->childCount = node->children.size();
+  if (node->measure != nullptr) {
+    record->flags |= HP_SNAPSHOT_NODE_MEASURE;
+  }
+  if (node->inInitailState) {
+    record->flags |= HP_SNAPSHOT_NODE_INITIAL;
+  }
+  if (node->isDirty) {
+    record->flags |= HP_SNAPSHOT_NODE_DIRTY;
+  }
+  record->measureContentHash = node->measureContentHash;
+
+  HPStyle& style = node->style;
+  record->nodeType = style.nodeType;
+  record->direction = style.direction;
+  record->flexDirection = style.flexDirection;
+  record->justifyContent = style.justifyContent;
+  record->alignContent = style.alignContent;
+  record->alignItems = style.alignItems;
+  record->alignSelf = style.alignSelf;
+  record->flexWrap = style.flexWrap;
+  record->positionType = style.positionType;
+  record->displayType = style.displayType;
+  record->overflowType = style.overflowType;
+  record->flexBasis = style.flexBasis;
+  record->flexGrow = style.flexGrow;
+  record->flexShrink = style.flexShrink;
+  record->flex = style.flex;
+  record->margin = *style.margin;
+  record->padding = *style.padding;
+  if (style.border != nullptr) {
+    record->flags |= HP_SNAPSHOT_NODE_BORDER;
+    record->border = *style.border;
+  }
+  if (style.position != nullptr) {
+    record->flags |= HP_SNAPSHOT_NODE_POSITION;
+    record->position = *style.position;
+  }
+  memcpy(record->dim, style.dim, sizeof(style.dim));
+  memcpy(record->minDim, style.minDim, sizeof(style.minDim));
+  memcpy(record->maxDim, style.maxDim, sizeof(style.maxDim));
+  record->itemSpace = style.itemSpace;
+  record->lineSpace = style.lineSpace;
+
+  record->result = node->result;
+  record->measureCount = node->layoutCache.getEntries(&record->cachedLayout,
+                                                      record->cachedMeasures,
+                                                      MAX_MEASURES_COUNT);
+}
+
+static void collectNodes(HPNodeRef node, std::vector<HPNodeRef>& nodes) {
+  nodes.push_back(node);
+  for (size_t i = 0; i < node->children.size(); i++) {
+    collectNodes(node->children[i], nodes);
+  }
+}
+
+uint32_t HPNodeSaveSnapshot(HPNodeRef root, void* buffer, uint32_t bufferSize) {
+  if (root == nullptr) {
+    return 0;
+  }
+  std::vector<HPNodeRef> nodes;
+  collectNodes(root, nodes);
+  uint32_t size = sizeof(HPSnapshotHeader) + nodes.size() * sizeof(HPSnapshotNode);
+  if (buffer == nullptr || bufferSize < size) {
+    return size;
+  }
+
+  HPSnapshotHeader* header = reinterpret_cast<HPSnapshotHeader*>(buffer);
+  header->magic = HP_SNAPSHOT_MAGIC;
+  header->version = HP_SNAPSHOT_VERSION;
+  header->nodeCount = nodes.size();
+  header->nodeSize = sizeof(HPSnapshotNode);
+  HPSnapshotNode* records = reinterpret_cast<HPSnapshotNode*>(header + 1);
+  for (size_t i = 0; i < nodes.size(); i++) {
+    saveNode(nodes[i], &records[i]);
+  }
+  return size;
+}
+
+static bool recordIsValid(const HPSnapshotNode& record) {
+  return record.nodeType <= NodeTypeText && record.direction <= DirectionRTL &&
+         record.flexDirection <= FLexDirectionColumnReverse &&
+         record.justifyContent <= FlexAlignSpaceEvenly &&
+         record.alignContent <= FlexAlignSpaceEvenly &&
+         record.alignItems <= FlexAlignSpaceEvenly && record.alignSelf <= FlexAlignSpaceEvenly &&
+         record.flexWrap <= FlexWrapReverse && record.positionType <= PositionTypeAbsolute &&
+         record.displayType <= DisplayTypeNone && record.overflowType <= OverflowScroll &&
+         record.measureCount <= MAX_MEASURES_COUNT;
+}
+
+// records must be a complete pre-order tree: every record but the last
+// one leaves some subtree unfinished.
+static bool snapshotIsValid(const void* buffer, uint32_t bufferSize) {
+  if (buffer == nullptr || bufferSize < sizeof(HPSnapshotHeader)) {
+    return false;
+  }
+  const HPSnapshotHeader* header = reinterpret_cast<const HPSnapshotHeader*>(buffer);
+  if (header->magic != HP_SNAPSHOT_MAGIC || header->version != HP_SNAPSHOT_VERSION ||
+      header->nodeSize != sizeof(HPSnapshotNode) || header->nodeCount == 0 ||
+      header->nodeCount > (bufferSize - sizeof(HPSnapshotHeader)) / sizeof(HPSnapshotNode)) {
+    return false;
+  }
+
+  const HPSnapshotNode* records = reinterpret_cast<const HPSnapshotNode*>(header + 1);
+  uint64_t pending = 1;
+  for (uint32_t i = 0; i < header->nodeCount; i++) {
+    if (pending == 0 || !recordIsValid(records[i])) {
+      return false;
+    }
+    pending = pending - 1 + records[i].childCount;
+  }
+  return pending == 0;
+}
+
+static void loadNode(HPNodeRef node, const HPSnapshotNode& record, HPMeasureFunc measure) {
+  HPStyle& style = node->style;
+  style.nodeType = static_cast<NodeType>(record.nodeType);
+  style.direction = static_cast<HPDirection>(record.direction);
+  style.flexDirection = static_cast<FlexDirection>(record.flexDirection);
+  style.justifyContent = static_cast<FlexAlign>(record.justifyContent);
+  style.alignContent = static_cast<FlexAlign>(record.alignContent);
+  style.alignItems = static_cast<FlexAlign>(record.alignItems);
+  style.alignSelf = static_cast<FlexAlign>(record.alignSelf);
+  style.flexWrap = static_cast<FlexWrapMode>(record.flexWrap);
+  style.positionType = static_cast<PositionType>(record.positionType);
+  style.displayType = static_cast<DisplayType>(record.displayType);
+  style.overflowType = static_cast<OverflowType>(record.overflowType);
+  style.flexBasis = record.flexBasis;
+  style.flexGrow = record.flexGrow;
+  style.flexShrink = record.flexShrink;
+  style.flex = record.flex;
+  HPStyle::assignEdges(style.margin, &record.margin);
+  HPStyle::assignEdges(style.padding, &record.padding);
+  if (record.flags & HP_SNAPSHOT_NODE_BORDER) {
+    HPStyle::assignEdges(style.border, &record.border);
+  }
+  if (record.flags & HP_SNAPSHOT_NODE_POSITION) {
+    HPStyle::assignEdges(style.position, &record.position);
+  }
+  memcpy(style.dim, record.dim, sizeof(style.dim));
+  memcpy(style.minDim, record.minDim, sizeof(style.minDim));
+  memcpy(style.maxDim, record.maxDim, sizeof(style.maxDim));
+  style.itemSpace = record.itemSpace;
+  style.lineSpace = record.lineSpace;
+
+  node->result = record.result;
+  node->layoutCache.setEntries(record.cachedLayout, record.cachedMeasures, record.measureCount);
+  node->measureContentHash = record.measureContentHash;
+  if (record.flags & HP_SNAPSHOT_NODE_MEASURE) {
+    node->measure = measure;
+  }
+  node->inInitailState = (record.flags & HP_SNAPSHOT_NODE_INITIAL) != 0;
+  node->isDirty = (record.flags & HP_SNAPSHOT_NODE_DIRTY) != 0;
+  // the platform views of loaded nodes are new, they need the layout.
+  node->_hasNewLayout = true;
+}
+
+HPNodeRef HPNodeLoadSnapshot(const void* buffer,
+                             uint32_t bufferSize,
+                             HPConfigRef config,
+                             HPMeasureFunc measure,
+                             HPSnapshotNodeFunc nodeFunc,
+                             void* userData) {
+  if (!snapshotIsValid(buffer, bufferSize)) {
+    return nullptr;
+  }
+  const HPSnapshotHeader* header = reinterpret_cast<const HPSnapshotHeader*>(buffer);
+  const HPSnapshotNode* records = reinterpret_cast<const HPSnapshotNode*>(header + 1);
+
+  std::vector<HPNodeRef> nodes(header->nodeCount);
+  // parents whose children are not all loaded, and the count left.
+  std::vector<HPNodeRef> parents;
+  std::vector<uint32_t> childrenLeft;
+  for (uint32_t i = 0; i < header->nodeCount; i++) {
+    HPNodeRef node = HPNodeNewWithConfig(config);
+    loadNode(node, records[i], measure);
+    nodes[i] = node;
+    if (!parents.empty()) {
+      HPNodeRef parent = parents.back();
+      node->setParent(parent);
+      node->indexInParent = parent->children.size();
+      parent->children.push_back(node);
+      if (--childrenLeft.back() == 0) {
+        parents.pop_back();
+        childrenLeft.pop_back();
+      }
+    }
+    if (records[i].childCount > 0) {
+      node->children.reserve(records[i].childCount);
+      parents.push_back(node);
+      childrenLeft.push_back(records[i].childCount);
+    }
+  }
+
+  if (nodeFunc != nullptr) {
+    for (uint32_t i = 0; i < header->nodeCount; i++) {
+      nodeFunc(nodes[i], i, userData);
+    }
+  }
+  return nodes[0];
+}
+
+bool HPNodeSaveSnapshotFile(HPNodeRef root, const char* path) {
+  if (root == nullptr || path == nullptr) {
+    return false;
+  }
+  uint32_t size = HPNodeSaveSnapshot(root, nullptr, 0);
+  std::vector<char> buffer(size);
+  HPNodeSaveSnapshot(root, buffer.data(), size);
+
+  FILE* file = fopen(path, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool written = fwrite(buffer.data(), 1, size, file) == size;
+  return fclose(file) == 0 && written;
+}
+
+HPNodeRef HPNodeLoadSnapshotFile(const char* path,
+                                 HPConfigRef config,
+                                 HPMeasureFunc measure,
+                                 HPSnapshotNodeFunc nodeFunc,
+                                 void* userData) {
+  if (path == nullptr) {
+    return nullptr;
+  }
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0 || info.st_size > UINT32_MAX) {
+    close(fd);
+    return nullptr;
+  }
+  uint32_t size = info.st_size;
+  void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  HPNodeRef root = HPNodeLoadSnapshot(data, size, config, measure, nodeFunc, userData);
+  munmap(data, size);
+  return root;
+}
@@ -0,0 +1,124 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module saves a laid out node subtree into a binary snapshot and
+ * restores it later, so a screen with the same static skeleton on every
+ * launch gets its layout back without a full layout pass. styles, layout
+ * results and layout cache are saved, loaded nodes are clean, so the next
+ * layout with the same size only lays out nodes marked dirty after loading,
+ * e.g. text nodes whose content differs from the saved one.
+ * measure functions, contexts and viewports are not saved.
+ *
+ * a snapshot is only valid for the engine build that wrote it, layout
+ * structs are stored as they are in memory, in native byte order:
+ *   HPSnapshotHeader
+ *   nodeCount times HPSnapshotNode, in depth first pre-order
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "HPNode.h"
+
+// "HPSN"
+#define HP_SNAPSHOT_MAGIC 0x4E535048
+#define HP_SNAPSHOT_VERSION 1
+
+// HPSnapshotNode::flags
+#define HP_SNAPSHOT_NODE_MEASURE 0x1
+#define HP_SNAPSHOT_NODE_BORDER 0x2
+#define HP_SNAPSHOT_NODE_POSITION 0x4
+#define HP_SNAPSHOT_NODE_INITIAL 0x8
+#define HP_SNAPSHOT_NODE_DIRTY 0x10
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t nodeCount;
+  // sizeof(HPSnapshotNode) of the writer
+  uint32_t nodeSize;
+} HPSnapshotHeader;
+
+typedef struct {
+  uint32_t childCount;
+  uint32_t flags;
+  uint64_t measureContentHash;
+
+  // HPStyle, enums are stored as bytes
+  uint8_t nodeType;
+  uint8_t direction;
+  uint8_t flexDirection;
+  uint8_t justifyContent;
+  uint8_t alignContent;
+  uint8_t alignItems;
+  uint8_t alignSelf;
+  uint8_t flexWrap;
+  uint8_t positionType;
+  uint8_t displayType;
+  uint8_t overflowType;
+  uint8_t reserved;
+  float flexBasis;
+  float flexGrow;
+  float flexShrink;
+  float flex;
+  HPEdges margin;
+  HPEdges padding;
+  // valid if HP_SNAPSHOT_NODE_BORDER or HP_SNAPSHOT_NODE_POSITION is set
+  HPEdges border;
+  HPEdges position;
+  float dim[2];
+  float minDim[2];
+  float maxDim[2];
+  float itemSpace;
+  float lineSpace;
+
+  HPLayout result;
+  MeasureResult cachedLayout;
+  uint32_t measureCount;
+  MeasureResult cachedMeasures[MAX_MEASURES_COUNT];
+} HPSnapshotNode;
+
+// called for each loaded node in pre-order after the whole tree is built,
+// index is the node's position in the snapshot. set the node's context here,
+// and mark it dirty if its content differs from the saved one, e.g. its
+// saved measureContentHash is not the hash of its current content.
+typedef void (*HPSnapshotNodeFunc)(HPNodeRef node, uint32_t index, void* userData);
+
+// write snapshot of root and its descendants into buffer of bufferSize
+// bytes and return the bytes needed, nothing is written if it doesn't fit.
+uint32_t HPNodeSaveSnapshot(HPNodeRef root, void* buffer, uint32_t bufferSize);
+
+// create the saved subtree with config, from config's node pool if it's
+// enabled. measure is set to nodes saved with a measure function without
+// making them dirty. return null if the snapshot is malformed or written
+// by another engine build.
+HPNodeRef HPNodeLoadSnapshot(const void* buffer,
+                             uint32_t bufferSize,
+                             HPConfigRef config,
+                             HPMeasureFunc measure,
+                             HPSnapshotNodeFunc nodeFunc,
+                             void* userData);
+
+// same as above with a snapshot file, the file is mapped into memory while
+// loading instead of being read into a copy.
+bool HPNodeSaveSnapshotFile(HPNodeRef root, const char* path);
+HPNodeRef HPNodeLoadSnapshotFile(const char* path,
+                                 HPConfigRef config,
+                                 HPMeasureFunc measure,
+                                 HPSnapshotNodeFunc nodeFunc,
+                                 void* userData);
@@ -22,6 +22,22 @@
 #include <algorithm>
 #include <string>
 
+#include "HPBatchMeasure.h"
+#include "HPPixelGrid.h"
+#include "HPTrace.h"
+
+// layout of an item in worker thread, items of these tasks have their own
+// subtree and definite size, so they don't depend on each other.
+struct HPItemLayoutTask {
+  HPNodeRef item;
+  // item's style dims used in this layout, recovered after layout.
+  float styleDim[2];
+  float parentWidth;
+  float parentHeight;
+  HPDirection direction;
+  void* layoutContext;
+};
+
 // the layout progress refers
 // https://www.w3.org/TR/css-flexbox-1/#layout-algorithm
 
@@ -66,6 +82,9 @@ HPNode::HPNode(HPConfigRef config) {
   measure = nullptr;
   dirtiedFunc = nullptr;
   _config = config;
+  if (config != nullptr) {
+    layoutCache.setCapacity(config->GetMeasureCacheCapacity());
+  }
 
   initLayoutResult();
   inInitailState = true;
@@ -87,14 +106,25 @@ HPNode::~HPNode() {
   }
 
   children.clear();
+
+  if (modeState != nullptr) {
+    if (modeState->shadow != nullptr) {
+      modeState->shadow->modeState->origin = nullptr;
+    }
+    if (modeState->origin != nullptr) {
+      modeState->origin->modeState->shadow = nullptr;
+    }
+    delete modeState;
+    modeState = nullptr;
+  }
 }
 
 void HPNode::initLayoutResult() {
-#ifdef LAYOUT_TIME_ANALYZE
-  fetchCount = 0;
-#endif
   isFrozen = false;
   isDirty = true;
+  relayoutAlone = false;
+  hasDirtyDescendant = false;
+  clearLayoutInputs();
   _hasNewLayout = false;
   result.dim[DimWidth] = 0;
   result.dim[DimHeight] = 0;
@@ -151,6 +181,7 @@ HPStyle HPNode::getStyle() {
 
 void HPNode::setStyle(const HPStyle& st) {
   style = st;
+  invalidateSubtreeStyleHash();
   // TODO(ianwang): layout if needed???
 }
 
@@ -182,7 +213,10 @@ void HPNode::addChild(HPNodeRef item) {
   if (item == nullptr) {
     return;
   }
-  item->setParent(this);
+  // a child being its own ancestor makes a cycle.
+  ASSERT(!isSelfOrAncestor(item));
+  attachChild(item);
+  item->indexInParent = children.size();
   children.push_back(item);
   markAsDirty();
 }
@@ -192,8 +226,10 @@ bool HPNode::insertChild(HPNodeRef item, uint32_t index) {
   if (item == nullptr || measure != nullptr) {
     return false;
   }
-  item->setParent(this);
+  ASSERT(!isSelfOrAncestor(item));
+  attachChild(item);
   children.insert(children.begin() + index, item);
+  renumberChildren(index);
   markAsDirty();
   return true;
 }
@@ -206,15 +242,11 @@ HPNodeRef HPNode::getChild(uint32_t index) {
 }
 
 bool HPNode::removeChild(HPNodeRef child) {
-  std::vector<HPNodeRef>::iterator p = std::find(children.begin(), children.end(), child);
-  if (p != children.end()) {
-    children.erase(p);
-    child->setParent(nullptr);
-    child->resetLayoutRecursive(false);
-    markAsDirty();
-    return true;
+  int32_t index = indexOfChild(child);
+  if (index < 0) {
+    return false;
   }
-  return false;
+  return removeChild(static_cast<uint32_t>(index));
 }
 
 bool HPNode::removeChild(uint32_t index) {
@@ -223,10 +255,186 @@ bool HPNode::removeChild(uint32_t index) {
   }
   HPNodeRef child = getChild(index);
   if (child != nullptr) {
-    child->setParent(nullptr);
-    child->resetLayoutRecursive(false);
+    detachChild(child);
   }
   children.erase(children.begin() + index);
+  renumberChildren(index);
+  markAsDirty();
+  return true;
+}
+
+// a removed child keeps its layout results and cache in retained layout
+// mode, they are used again if it's inserted with the same styles.
+void HPNode::detachChild(HPNodeRef child) {
+  child->setParent(nullptr);
+  if (_config != nullptr && _config->RetainDetachedLayout() && !child->inInitailState) {
+    uint64_t hash = child->subtreeStyleHash();
+    child->getModeState()->hasRetainedLayout = true;
+    child->modeState->retainedStyleHash = hash;
+  } else {
+    if (child->modeState != nullptr) {
+      child->modeState->hasRetainedLayout = false;
+    }
+    child->resetLayoutRecursive(false);
+  }
+}
+
+// style changes by setters have cleared the caches of the changed nodes,
+// the hash catches styles set while child is detached. the layout cache is
+// keyed by constraints from new parent, it's hit only if they are the same
+// as the cached ones, then the subtree is not visited by the pass.
+void HPNode::attachChild(HPNodeRef child) {
+  child->setParent(this);
+  if (child->modeState == nullptr || !child->modeState->hasRetainedLayout) {
+    return;
+  }
+  child->modeState->hasRetainedLayout = false;
+  if (child->subtreeStyleHash() == child->modeState->retainedStyleHash) {
+    child->setHasNewLayoutRecursive();
+  } else {
+    child->resetLayoutRecursive(false);
+  }
+}
+
+uint64_t HPNode::subtreeStyleHash() {
+  if (modeState != nullptr && modeState->hasSubtreeStyleHash) {
+    return modeState->cachedSubtreeStyleHash;
+  }
+  uint64_t hash = style.hash();
+  for (size_t i = 0; i < children.size(); i++) {
+    hash = (hash ^ children[i]->subtreeStyleHash()) * 1099511628211ULL;
+  }
+  getModeState()->cachedSubtreeStyleHash = hash;
+  modeState->hasSubtreeStyleHash = true;
+  return hash;
+}
+
+void HPNode::invalidateSubtreeStyleHash() {
+  for (HPNodeRef node = this;
+       node != nullptr && node->modeState != nullptr && node->modeState->hasSubtreeStyleHash;
+       node = node->parent) {
+    node->modeState->hasSubtreeStyleHash = false;
+  }
+}
+
+// results of a retained subtree are new to its new parent.
+void HPNode::setHasNewLayoutRecursive() {
+  setHasNewLayout(true);
+  for (size_t i = 0; i < children.size(); i++) {
+    children[i]->setHasNewLayoutRecursive();
+  }
+}
+
+int32_t HPNode::indexOfChild(HPNodeRef child) {
+  if (child == nullptr || child->parent != this) {
+    return -1;
+  }
+  uint32_t index = child->indexInParent;
+  if (index < children.size() && children[index] == child) {
+    return index;
+  }
+  // children changed without this class, the cached index is stale.
+  renumberChildren(0);
+  index = child->indexInParent;
+  if (index < children.size() && children[index] == child) {
+    return index;
+  }
+  return -1;
+}
+
+bool HPNode::isSelfOrAncestor(HPNodeRef node) {
+  for (HPNodeRef item = this; item != nullptr; item = item->parent) {
+    if (item == node) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void HPNode::renumberChildren(size_t from) {
+  for (size_t i = from; i < children.size(); i++) {
+    children[i]->indexInParent = i;
+  }
+}
+
+bool HPNode::applyChildMoves(const HPChildMove* moves, uint32_t count) {
+  if (count == 0) {
+    return true;
+  }
+
+  // check all moves before changing anything.
+  std::vector<bool> moved(children.size(), false);
+  std::vector<HPNodeRef> inserted;
+  uint32_t removedCount = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    HPNodeRef child = moves[i].child;
+    if (child == nullptr) {
+      return false;
+    }
+    int32_t from = indexOfChild(child);
+    if (from >= 0) {
+      if (moved[from]) {
+        return false;
+      }
+      moved[from] = true;
+      if (moves[i].toIndex < 0) {
+        removedCount++;
+      }
+    } else if (moves[i].toIndex < 0 || isSelfOrAncestor(child)) {
+      // inserting an ancestor makes a cycle.
+      return false;
+    } else {
+      inserted.push_back(child);
+    }
+  }
+  std::sort(inserted.begin(), inserted.end());
+  if (std::adjacent_find(inserted.begin(), inserted.end()) != inserted.end()) {
+    return false;
+  }
+  const size_t newCount = children.size() - removedCount + inserted.size();
+  // measure node cannot have child.
+  if (measure != nullptr && newCount > 0) {
+    return false;
+  }
+  std::vector<HPNodeRef> newChildren(newCount, nullptr);
+  for (uint32_t i = 0; i < count; i++) {
+    int32_t toIndex = moves[i].toIndex;
+    if (toIndex < 0) {
+      continue;
+    }
+    if (static_cast<size_t>(toIndex) >= newCount || newChildren[toIndex] != nullptr) {
+      return false;
+    }
+    newChildren[toIndex] = moves[i].child;
+  }
+
+  size_t slot = 0;
+  for (size_t i = 0; i < children.size(); i++) {
+    if (moved[i]) {
+      continue;
+    }
+    while (newChildren[slot] != nullptr) {
+      slot++;
+    }
+    newChildren[slot++] = children[i];
+  }
+  if (newChildren == children) {
+    return true;
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    HPNodeRef child = moves[i].child;
+    if (moves[i].toIndex < 0) {
+      detachChild(child);
+    } else if (child->parent != this) {
+      if (child->parent != nullptr) {
+        child->parent->removeChild(child);
+      }
+      attachChild(child);
+    }
+  }
+  children.swap(newChildren);
+  renumberChildren(0);
   markAsDirty();
   return true;
 }
@@ -244,14 +452,164 @@ void HPNode::setDisplayType(DisplayType displayType) {
 }
 
 void HPNode::markAsDirty() {
-  if (!isDirty) {
+  // node's own style or children changed, its parent lays it out in another
+  // way even if it has been relayoutAlone. node skipped by windowed layout
+  // stays dirty, its parent needs to know the estimated size changed.
+  invalidateSubtreeStyleHash();
+  if (!isDirty || relayoutAlone || outOfViewport) {
+    relayoutAlone = false;
     setDirty(true);
     if (parent) {
-      parent->markAsDirty();
+      parent->markAsDirtyByChild();
     }
   }
 }
 
+void HPNode::markAsDirtyByChild() {
+  if (isDirty) {
+    return;
+  }
+  setDirty(true);
+  if (parent == nullptr) {
+    return;
+  }
+  if (_config != nullptr && _config->UseIncrementalLayout() && !inInitailState) {
+    // size of this node may stay the same with its new content, ancestors
+    // keep their layout until it's relayout alone in next pass.
+    relayoutAlone = true;
+    parent->markHasDirtyDescendant();
+  } else {
+    parent->markAsDirtyByChild();
+  }
+}
+
+void HPNode::markHasDirtyDescendant() {
+  // a dirty node is laid out again anyway, its ancestors are marked before.
+  for (HPNodeRef node = this; node != nullptr && !node->isDirty && !node->hasDirtyDescendant;
+       node = node->parent) {
+    node->hasDirtyDescendant = true;
+  }
+}
+
+// relayout dirty descendants alone with the calls their parents made in
+// last passes, from the deepest one up. a node whose results stay the same
+// stops there, otherwise its parent is relayout too. return true if all
+// children of this node give the same results, so its layout cache holds.
+bool HPNode::updateDirtyDescendants(void* layoutContext) {
+  hasDirtyDescendant = false;
+  bool unchanged = true;
+  for (size_t i = 0; i < children.size(); i++) {
+    HPNodeRef item = children[i];
+    if (item->outOfViewport) {
+      // not laid out by this node in last pass.
+      continue;
+    }
+    if (!item->isDirty && item->hasDirtyDescendant &&
+        !item->updateDirtyDescendants(layoutContext)) {
+      item->isDirty = true;
+      item->clearLayoutCache();
+    }
+    if (item->isDirty && !item->relayoutWithLayoutInputs(layoutContext)) {
+      unchanged = false;
+    }
+  }
+  // let rounding and layout result transfer go down to relayout nodes.
+  setHasNewLayout(true);
+  return unchanged;
+}
+
+// replay calls of parent kept in layoutInputs, the last layout one at the
+// end as its result is the one parent placed. return false if this node
+// gives some call a different result, or can't be relayout alone.
+bool HPNode::relayoutWithLayoutInputs(void* layoutContext) {
+  if (modeState == nullptr || modeState->layoutInputs.empty() ||
+      modeState->layoutInputsOverflow) {
+    return false;
+  }
+  // layoutImpl below may update the inputs, they are read by index.
+  std::vector<HPLayoutInput>& layoutInputs = modeState->layoutInputs;
+  int32_t lastLayoutInput = modeState->lastLayoutInput;
+  if (_config != nullptr) {
+    _config->relayoutAloneCount++;
+  }
+  bool unchanged = true;
+  size_t count = layoutInputs.size();
+  size_t first = lastLayoutInput < 0 ? 0 : lastLayoutInput + 1;
+  for (size_t n = 0; n < count; n++) {
+    // layoutImpl updates the result of this input in place.
+    HPLayoutInput input = layoutInputs[(first + n) % count];
+    float oldWidth = style.dim[DimWidth];
+    float oldHeight = style.dim[DimHeight];
+    style.setDim(DimWidth, input.styleWidth);
+    style.setDim(DimHeight, input.styleHeight);
+    layoutImpl(input.parentWidth, input.parentHeight, input.direction, input.layoutAction,
+               layoutContext);
+    style.setDim(DimWidth, oldWidth);
+    style.setDim(DimHeight, oldHeight);
+
+    bool widthUnchanged = FloatIsEqual(result.dim[DimWidth], input.resultSize.width);
+    bool heightUnchanged = FloatIsEqual(result.dim[DimHeight], input.resultSize.height);
+    switch (input.layoutAction) {
+      case LayoutActionMeasureWidth:
+        unchanged = unchanged && widthUnchanged;
+        break;
+      case LayoutActionMeasureHeight:
+        unchanged = unchanged && heightUnchanged;
+        break;
+      default:
+        unchanged = unchanged && widthUnchanged && heightUnchanged &&
+                    result.hadOverflow == input.hadOverflow;
+        break;
+    }
+  }
+  return unchanged;
+}
+
+void HPNode::recordLayoutInput(const HPLayoutInput& input) {
+  HPNodeModeState* state = getModeState();
+  std::vector<HPLayoutInput>& layoutInputs = state->layoutInputs;
+  size_t index = 0;
+  for (; index < layoutInputs.size(); index++) {
+    HPLayoutInput& item = layoutInputs[index];
+    if (item.layoutAction == input.layoutAction && item.direction == input.direction &&
+        FloatIsEqual(item.parentWidth, input.parentWidth) &&
+        FloatIsEqual(item.parentHeight, input.parentHeight) &&
+        FloatIsEqual(item.styleWidth, input.styleWidth) &&
+        FloatIsEqual(item.styleHeight, input.styleHeight)) {
+      item = input;
+      break;
+    }
+  }
+  if (index == layoutInputs.size()) {
+    if (layoutInputs.size() == HP_MAX_LAYOUT_INPUTS) {
+      state->layoutInputsOverflow = true;
+      return;
+    }
+    layoutInputs.push_back(input);
+  }
+  if (input.layoutAction == LayoutActionLayout) {
+    state->lastLayoutInput = index;
+  }
+}
+
+void HPNode::clearLayoutInputs() {
+  if (modeState == nullptr) {
+    return;
+  }
+  modeState->layoutInputs.clear();
+  modeState->lastLayoutInput = -1;
+  modeState->layoutInputsOverflow = false;
+}
+
+// results of children are only kept for the results of this node.
+void HPNode::clearLayoutCache() {
+  layoutCache.clearCache();
+  hasDirtyDescendant = false;
+  for (size_t i = 0; i < children.size(); i++) {
+    children[i]->clearLayoutInputs();
+  }
+}
+
 void HPNode::setHasNewLayout(bool hasNewLayoutOrNot) {
   _hasNewLayout = hasNewLayoutOrNot;
 }
@@ -265,6 +623,9 @@ void HPNode::setDirty(bool dirtyOrNot) {
     return;
   }
   isDirty = dirtyOrNot;
+  if (!isDirty) {
+    relayoutAlone = false;
+  }
   if (isDirty) {
     // reset layout direction to initial state
     // need to calculated again
@@ -272,7 +633,7 @@ void HPNode::setDirty(bool dirtyOrNot) {
     // if is dirty, reset frozen.
     isFrozen = false;
     // if is dirty, layout cache muse be in clear state.
-    layoutCache.clearCache();
+    clearLayoutCache();
     if (dirtiedFunc != nullptr) {
       dirtiedFunc(this);
     }
@@ -284,6 +645,11 @@ void HPNode::setDirtiedFunc(HPDirtiedFunc _dirtiedFunc) {
 }
 
 void HPNode::setContext(void* _context) {
+  // a pending node of HPLayoutPipeline is synced only when dirty, and its
+  // measure function may read the context too.
+  if (modeState != nullptr && modeState->shadow != nullptr && context != _context) {
+    markAsDirty();
+  }
   context = _context;
 }
 
@@ -499,12 +865,86 @@ FlexAlign HPNode::getNodeAlign(HPNodeRef item) {
 
 void HPNode::SetConfig(HPConfigRef config) {
   _config = config;
+  if (config != nullptr) {
+    layoutCache.setCapacity(config->GetMeasureCacheCapacity());
+  }
 }
 
 HPConfigRef HPNode::GetConfig() {
   return _config;
 };
 
+HPNodeModeState* HPNode::getModeState() {
+  if (modeState == nullptr) {
+    modeState = new HPNodeModeState();
+  }
+  return modeState;
+}
+
+void HPNode::setViewport(const HPViewport& newViewport) {
+  HPNodeModeState* state = getModeState();
+  const HPViewport& viewport = state->viewport;
+  bool rangeChanged = !state->hasViewport || !FloatIsEqual(viewport.size, newViewport.size) ||
+                      !FloatIsEqual(viewport.margin, newViewport.margin) ||
+                      !FloatIsEqual(viewport.estimatedItemSize, newViewport.estimatedItemSize);
+  state->hasViewport = true;
+  state->viewport = newViewport;
+  // scrolling within laid out items needs no layout.
+  if (rangeChanged || hasSkippedItemInViewport()) {
+    markAsDirty();
+  }
+}
+
+void HPNode::clearViewport() {
+  if (modeState == nullptr || !modeState->hasViewport) {
+    return;
+  }
+  modeState->hasViewport = false;
+  for (size_t i = 0; i < children.size(); i++) {
+    if (children[i]->outOfViewport) {
+      markAsDirty();
+      return;
+    }
+  }
+}
+
+bool HPNode::useViewportLayout() {
+  return modeState != nullptr && modeState->hasViewport && style.isOverflowScroll() &&
+         style.flexWrap == FlexNoWrap;
+}
+
+// whether some item skipped in last pass is in viewport range now,
+// judged by its position and size of last pass.
+bool HPNode::hasSkippedItemInViewport() {
+  FlexDirection mainAxis = style.flexDirection;
+  const HPViewport& viewport = modeState->viewport;
+  float rangeStart = viewport.offset - viewport.margin;
+  float rangeEnd = viewport.offset + viewport.size + viewport.margin;
+  for (size_t i = 0; i < children.size(); i++) {
+    HPNodeRef item = children[i];
+    if (!item->outOfViewport) {
+      continue;
+    }
+    float itemStart = item->getLayoutStartPosition(mainAxis);
+    if (itemStart + item->getLayoutDim(mainAxis) >= rangeStart && itemStart <= rangeEnd) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// main size of an item that is not laid out in windowed layout.
+float HPNode::estimateItemMainSize(HPNodeRef item) {
+  FlexDirection mainAxis = style.flexDirection;
+  if (isDefined(item->style.dim[axisDim[mainAxis]])) {
+    return item->style.dim[axisDim[mainAxis]];
+  }
+  if (!item->inInitailState) {
+    return item->getLayoutDim(mainAxis);
+  }
+  return modeState->viewport.estimatedItemSize;
+}
+
 float HPNode::boundAxis(FlexDirection axis, float value) {
   float min = style.minDim[axisDim[axis]];
   float max = style.maxDim[axisDim[axis]];
@@ -551,24 +991,27 @@ void HPNode::resolveStyleValues() {
   result.border[axisEnd[crossAxis]] = style.getEndBorder(crossAxis);
 }
 
-#ifdef LAYOUT_TIME_ANALYZE
-static int layoutCount = 0;
-static int layoutCacheCount = 0;
-static int measureCount = 0;
-static int measureCacheCount = 0;
-#endif
-
 void HPNode::layout(float parentWidth,
                     float parentHeight,
                     HPConfigRef config,
                     HPDirection parentDirection,
-                    void* layoutContext) {
-#ifdef LAYOUT_TIME_ANALYZE
-  layoutCount = 0;
-  layoutCacheCount = 0;
-  measureCount = 0;
-  measureCacheCount = 0;
-#endif
+                    void* layoutContext,
+                    HPBatchMeasureFunc batchMeasureFunc) {
+  HPTracer* tracer = config->tracer != nullptr && config->tracer->isEnabled() ? config->tracer
+                                                                             : nullptr;
+  uint64_t traceStart = 0;
+  if (tracer != nullptr) {
+    tracer->beginPass();
+    traceStart = tracer->now();
+  }
+  config->visitCount = 0;
+  config->relayoutAloneCount = 0;
+  config->batchMeasureCount = 0;
+  HPBatchMeasure* batch = nullptr;
+  if (batchMeasureFunc != nullptr) {
+    batch = new HPBatchMeasure(this);
+    config->batchMeasure = batch;
+  }
   if (isUndefined(style.flexBasis) && !isUndefined(style.dim[axisDim[style.flexDirection]])) {
     style.flexBasis = style.dim[axisDim[style.flexDirection]];
   }
@@ -589,6 +1032,26 @@ void HPNode::layout(float parentWidth,
     styleHeightReset = true;
   }
   layoutImpl(parentWidth, parentHeight, parentDirection, LayoutActionLayout, layoutContext);
+  if (batch != nullptr) {
+    // measure content nodes requested by last pass and layout again,
+    // a pass may make new requests as sizes of content nodes changed.
+    uint32_t rounds = 0;
+    while (batch->hasRequests()) {
+      if (++rounds == HP_MAX_BATCH_MEASURE_ROUNDS) {
+        config->batchMeasure = nullptr;
+      }
+      uint64_t measureStart = tracer != nullptr ? tracer->now() : 0;
+      uint32_t requestCount = batch->requestCount();
+      batch->measure(batchMeasureFunc, layoutContext);
+      if (tracer != nullptr) {
+        tracer->addMeasure("batchMeasure", measureStart, requestCount);
+      }
+      config->batchMeasureCount++;
+      layoutImpl(parentWidth, parentHeight, parentDirection, LayoutActionLayout, layoutContext);
+    }
+    config->batchMeasure = nullptr;
+    delete batch;
+  }
   if (styleWidthReset) {
     style.setDim(DimWidth, VALUE_UNDEFINED);
   }
@@ -606,23 +1069,34 @@ void HPNode::layout(float parentWidth,
 
   // node 's layout is complete
   // convert its and its descendants position and size to a integer value.
-#ifndef ANDROID
-  convertLayoutResult(0.0f, 0.0f, config->GetScaleFactor());  // layout result convert has been taken in
-                                    // java . 3.8.2018. ianwang..
+#if HP_ROUND_LAYOUT_RESULT
+  // layout result convert has been taken in java . 3.8.2018. ianwang..
+  config->GetPixelGrid()->round(this, config->GetScaleFactor());
 #endif
 
-#ifdef LAYOUT_TIME_ANALYZE
-  HPLog(LogLevelDebug, "HippyLayoutTime layout: count %d cache %d, measure: count %d cache %d",
-        layoutCount, layoutCacheCount, measureCount, measureCacheCount);
-#endif
+  if (tracer != nullptr) {
+    tracer->endPass(traceStart);
+  }
 }
 
 // 3.Determine the flex base size and hypothetical main size of each item
 void HPNode::calculateItemsFlexBasis(HPSize availableSize, void* layoutContext) {
   FlexDirection mainAxis = style.flexDirection;
   std::vector<HPNodeRef>& items = children;
+  // windowed layout: items are placed one after another from main start,
+  // the ones out of viewport range are sized without layout.
+  bool windowed = useViewportLayout();
+  float rangeStart = 0;
+  float rangeEnd = 0;
+  if (windowed) {
+    const HPViewport& viewport = modeState->viewport;
+    rangeStart = viewport.offset - viewport.margin;
+    rangeEnd = viewport.offset + viewport.size + viewport.margin;
+  }
+  float itemOffset = getStartPaddingAndBorder(mainAxis);
   for (size_t i = 0; i < items.size(); i++) {
     HPNodeRef item = items[i];
+    item->outOfViewport = false;
     // for display none item, reset its and its descendants layout result.
     if (item->style.displayType == DisplayTypeNone) {
       item->resetLayoutRecursive();
@@ -635,10 +1109,20 @@ void HPNode::calculateItemsFlexBasis(HPSize availableSize, void* layoutContext)
     if (item->style.positionType == PositionTypeAbsolute) {
       continue;
     }
+    if (windowed) {
+      float itemStart = itemOffset + item->getStartMargin(mainAxis);
+      float estimatedSize = estimateItemMainSize(item);
+      item->outOfViewport = itemStart + estimatedSize < rangeStart || itemStart > rangeEnd;
+      if (item->outOfViewport) {
+        item->result.flexBaseSize = estimatedSize;
+      }
+    }
     // 3.Determine the flex base size and hypothetical main size of each item:
     // 3.1 If the item has a definite used flex basis, that's the flex base
     // size.
-    if (isDefined(item->style.getFlexBasis()) && isDefined(style.dim[axisDim[mainAxis]])) {
+    if (item->outOfViewport) {
+      // sized above
+    } else if (isDefined(item->style.getFlexBasis()) && isDefined(style.dim[axisDim[mainAxis]])) {
       item->result.flexBaseSize = item->style.getFlexBasis();
     } else if (isDefined(item->style.dim[axisDim[mainAxis]])) {
       // flex-basis:auto:
@@ -669,10 +1153,13 @@ void HPNode::calculateItemsFlexBasis(HPSize availableSize, void* layoutContext)
     item->result.hypotheticalMainAxisSize = item->boundAxis(mainAxis, item->result.flexBaseSize);
     item->result.hypotheticalMainAxisMarginBoxSize =
         item->result.hypotheticalMainAxisSize + item->getMargin(mainAxis);
+    itemOffset += item->result.hypotheticalMainAxisMarginBoxSize;
   }
 }
 
-bool HPNode::collectFlexLines(std::vector<FlexLine*>& flexLines, HPSize availableSize) {
+bool HPNode::collectFlexLines(HPFlexLineArena* arena,
+                              std::vector<FlexLine*>& flexLines,
+                              HPSize availableSize) {
   std::vector<HPNodeRef>& items = children;
   bool sumHypotheticalMainSizeOverflow = false;
   float availableWidth =
@@ -700,7 +1187,7 @@ bool HPNode::collectFlexLines(std::vector<FlexLine*>& flexLines, HPSize availabl
     }
 
     if (line == nullptr) {
-      line = new FlexLine(this);
+      line = arena->newLine(this);
     }
 
     float leftSpace = availableWidth - (line->sumHypotheticalMainSize +
@@ -747,6 +1234,49 @@ void HPNode::cacheLayoutOrMeasureResult(HPSize availableSize,
   }
 }
 
+// get content size from shared measure cache, batch measure results,
+// or the measure function in order.
+HPSize HPNode::measureContent(float availableWidth,
+                              MeasureMode widthMeasureMode,
+                              float availableHeight,
+                              MeasureMode heightMeasureMode,
+                              void* layoutContext) {
+  HPSize dim = {0, 0};
+  HPSharedMeasureCache* sharedCache = nullptr;
+  if (measureContentHash != 0 && _config != nullptr) {
+    sharedCache = _config->GetSharedMeasureCache();
+  }
+  const void* measureId = reinterpret_cast<const void*>(measure);
+  HPSize contentSize = {availableWidth, availableHeight};
+  HPSizeMode contentMeasureMode = {widthMeasureMode, heightMeasureMode};
+  if (sharedCache != nullptr &&
+      sharedCache->get(measureContentHash, measureId, contentSize, contentMeasureMode, dim)) {
+    return dim;
+  }
+
+  HPBatchMeasure* batch = _config != nullptr ? _config->batchMeasure : nullptr;
+  if (batch != nullptr) {
+    if (!batch->getResult(this, availableWidth, widthMeasureMode, availableHeight,
+                          heightMeasureMode, dim)) {
+      // placeholder until the request is measured, don't share it.
+      return dim;
+    }
+  } else {
+    HPTracer* tracer = _config != nullptr ? _config->tracer : nullptr;
+    bool tracing = tracer != nullptr && tracer->isEnabled();
+    uint64_t measureStart = tracing ? tracer->now() : 0;
+    dim = measure(this, availableWidth, widthMeasureMode, availableHeight, heightMeasureMode,
+                  layoutContext);
+    if (tracing) {
+      tracer->addMeasure("measure", measureStart, 1);
+    }
+  }
+  if (sharedCache != nullptr) {
+    sharedCache->put(measureContentHash, measureId, contentSize, contentMeasureMode, dim);
+  }
+  return dim;
+}
+
 /*
  * availableWidth/availableHeight  has subtract its margin and padding.
  */
@@ -775,8 +1305,8 @@ void HPNode::layoutSingleNode(float availableWidth,
       dim.width = availableWidth;
       dim.height = availableHeight;
     } else if (measure != nullptr && needMeasure) {
-      dim = measure(this, availableWidth, widthMeasureMode, availableHeight, heightMeasureMode,
-                    layoutContext);
+      dim = measureContent(availableWidth, widthMeasureMode, availableHeight, heightMeasureMode,
+                           layoutContext);
     }
 
     result.dim[DimWidth] =
@@ -795,24 +1325,49 @@ void HPNode::layoutSingleNode(float availableWidth,
   cacheLayoutOrMeasureResult(availableSize, measureMode, layoutAction);
 }
 
-// reference: https://www.w3.org/TR/css-flexbox-1/#layout-algorithm
 void HPNode::layoutImpl(float parentWidth,
                         float parentHeight,
                         HPDirection parentDirection,
                         FlexLayoutAction layoutAction,
                         void* layoutContext) {
-#ifdef LAYOUT_TIME_ANALYZE
-  if (layoutAction == LayoutActionLayout) {
-    layoutCount++;
-  } else {
-    measureCount++;
+  if (parent == nullptr || _config == nullptr || !_config->UseIncrementalLayout()) {
+    flexLayout(parentWidth, parentHeight, parentDirection, layoutAction, layoutContext);
+    return;
+  }
+  // keep the call of parent to relayout this node alone, see relayoutAlone.
+  HPLayoutInput input;
+  input.parentWidth = parentWidth;
+  input.parentHeight = parentHeight;
+  input.styleWidth = style.dim[DimWidth];
+  input.styleHeight = style.dim[DimHeight];
+  input.direction = parentDirection;
+  input.layoutAction = layoutAction;
+  flexLayout(parentWidth, parentHeight, parentDirection, layoutAction, layoutContext);
+  input.resultSize.width = result.dim[DimWidth];
+  input.resultSize.height = result.dim[DimHeight];
+  input.hadOverflow = result.hadOverflow;
+  recordLayoutInput(input);
+}
+
+// reference: https://www.w3.org/TR/css-flexbox-1/#layout-algorithm
+void HPNode::flexLayout(float parentWidth,
+                        float parentHeight,
+                        HPDirection parentDirection,
+                        FlexLayoutAction layoutAction,
+                        void* layoutContext) {
+  HPTracer* tracer = nullptr;
+  if (_config != nullptr) {
+    _config->visitCount++;
+    if (_config->tracer != nullptr && _config->tracer->isEnabled()) {
+      tracer = _config->tracer;
+      tracer->countLayout(this, layoutAction);
+    }
   }
-#endif
 
   HPDirection direction = resolveDirection(parentDirection);
   if (getLayoutDirection() != direction) {
     setLayoutDirection(direction);
-    layoutCache.clearCache();
+    clearLayoutCache();
     resolveStyleValues();
   }
 
@@ -840,15 +1395,15 @@ void HPNode::layoutImpl(float parentWidth,
   // layoutMeasuredWidth  layoutMeasuredHeight used in
   // "Determine the flex base size and hypothetical main size of each item"
   if (layoutAction == LayoutActionMeasureWidth && isDefined(nodeWidth)) {
-#ifdef LAYOUT_TIME_ANALYZE
-    measureCacheCount++;
-#endif
+    if (tracer != nullptr) {
+      tracer->countCacheHit(layoutAction);
+    }
     result.dim[DimWidth] = nodeWidth;
     return;
   } else if (layoutAction == LayoutActionMeasureHeight && isDefined(nodeHeight)) {
-#ifdef LAYOUT_TIME_ANALYZE
-    measureCacheCount++;
-#endif
+    if (tracer != nullptr) {
+      tracer->countCacheHit(layoutAction);
+    }
     result.dim[DimHeight] = nodeHeight;
     return;
   }
@@ -931,20 +1486,30 @@ void HPNode::layoutImpl(float parentWidth,
   HPSizeMode measureMode = {widthMeasureMode, heightMeasureMode};
   MeasureResult* cacheResult = layoutCache.getCachedMeasureResult(availableSize, measureMode,
                                                                   layoutAction, measure != nullptr);
+  if (hasDirtyDescendant) {
+    // results were cached before some descendants changed. a hit holds if
+    // they give their calls the same results as before, otherwise this
+    // node is laid out again and its other cached results may be stale.
+    if (cacheResult == nullptr || !updateDirtyDescendants(layoutContext)) {
+      isDirty = true;
+      clearLayoutCache();
+      cacheResult = nullptr;
+    }
+  }
   if (cacheResult != nullptr) {
     // set Result....
     switch (layoutAction) {
       case LayoutActionMeasureWidth:
-#ifdef LAYOUT_TIME_ANALYZE
-        measureCacheCount++;
-#endif
+        if (tracer != nullptr) {
+          tracer->countCacheHit(layoutAction);
+        }
         ASSERT(isDefined(cacheResult->resultSize.width));
         result.dim[DimWidth] = cacheResult->resultSize.width;
         break;
       case LayoutActionMeasureHeight:
-#ifdef LAYOUT_TIME_ANALYZE
-        measureCacheCount++;
-#endif
+        if (tracer != nullptr) {
+          tracer->countCacheHit(layoutAction);
+        }
         ASSERT(isDefined(cacheResult->resultSize.height));
         result.dim[DimHeight] = cacheResult->resultSize.height;
         break;
@@ -962,9 +1527,15 @@ void HPNode::layoutImpl(float parentWidth,
           result.dim[DimHeight] = cacheResult->resultSize.height;
           cacheLayoutOrMeasureResult(availableSize, measureMode, layoutAction);
         } else {
-#ifdef LAYOUT_TIME_ANALYZE
-          layoutCacheCount++;
-#endif
+          if (tracer != nullptr) {
+            tracer->countCacheHit(layoutAction);
+          }
+          if (measure != nullptr) {
+            // a measure call in another size after the cached layout may
+            // have changed result, e.g. passes of batch measure mode.
+            result.dim[DimWidth] = cacheResult->resultSize.width;
+            result.dim[DimHeight] = cacheResult->resultSize.height;
+          }
           // do nothing..
           // layoutCache.cachedLayout object is last layout result.
           // used to determine need layout or not.
@@ -995,8 +1566,11 @@ void HPNode::layoutImpl(float parentWidth,
   calculateItemsFlexBasis(availableSize, layoutContext);
   // 9.3. Main Size Determination
   // 5. Collect flex items into flex lines:
-  std::vector<FlexLine*> flexLines;
-  bool sumHypotheticalMainSizeOverflow = collectFlexLines(flexLines, availableSize);
+  // lines are taken from the scratch arena of this thread, reused across
+  // passes.
+  HPFlexLineArena* arena = HPFlexLineArena::current();
+  std::vector<FlexLine*>& flexLines = arena->pushFrame();
+  bool sumHypotheticalMainSizeOverflow = collectFlexLines(arena, flexLines, availableSize);
 
   // get max line's  main size
   float maxSumItemsMainSize = 0;
@@ -1048,11 +1622,8 @@ void HPNode::layoutImpl(float parentWidth,
       (layoutAction == LayoutActionMeasureHeight && isColumnDirection(mainAxis))) {
     // cache layout result & state...
     cacheLayoutOrMeasureResult(availableSize, measureMode, layoutAction);
-    // free flexLines, allocate in collectFlexLines.
-    // TODO(ianwang): opt.
-    for (size_t i = 0; i < flexLines.size(); i++) {
-      delete flexLines[i];
-    }
+    // give back flexLines, taken in collectFlexLines.
+    arena->popFrame();
     return;
   }
 
@@ -1092,10 +1663,8 @@ void HPNode::layoutImpl(float parentWidth,
     // cache layout result & state...
     cacheLayoutOrMeasureResult(availableSize, measureMode, layoutAction);
 
-    // free flexLines, allocate in collectFlexLines.
-    for (size_t i = 0; i < flexLines.size(); i++) {
-      delete flexLines[i];
-    }
+    // give back flexLines, taken in collectFlexLines.
+    arena->popFrame();
     return;
   }
 
@@ -1107,10 +1676,8 @@ void HPNode::layoutImpl(float parentWidth,
   // then it will be determined in step 15 of crossAxisAlignment
   crossAxisAlignment(flexLines);
 
-  // free flexLines, allocate in collectFlexLines.
-  for (size_t i = 0; i < flexLines.size(); i++) {
-    delete flexLines[i];
-  }
+  // give back flexLines, taken in collectFlexLines.
+  arena->popFrame();
 
   // cache layout result & state...
   cacheLayoutOrMeasureResult(availableSize, measureMode, layoutAction);
@@ -1128,9 +1695,38 @@ float HPNode::determineCrossAxisSize(std::vector<FlexLine*>& flexLines,
   FlexDirection mainAxis = style.flexDirection;
   FlexDirection crossAxis = resolveCrossAxis();
   float sumLinesCrossSize = 0;
+  HPThreadPool* pool = nullptr;
+  if (layoutAction == LayoutActionLayout && _config != nullptr) {
+    pool = _config->GetThreadPool();
+  }
+  std::vector<HPItemLayoutTask> tasks;
   for (size_t i = 0; i < flexLines.size(); i++) {
     FlexLine* line = flexLines[i];
     float maxItemCrossSize = 0;
+    // in parallel layout, items with definite cross size are laid out in
+    // worker threads first, their main axis size has been determined.
+    tasks.clear();
+    if (pool != nullptr) {
+      for (size_t j = 0; j < line->items.size(); j++) {
+        HPNodeRef item = line->items[j];
+        HPItemLayoutTask task;
+        task.styleDim[axisDim[mainAxis]] = item->getLayoutDim(mainAxis);
+        task.styleDim[axisDim[crossAxis]] = item->style.getDim(crossAxis);
+        uint32_t budget = _config->parallelTaskNodes;
+        if (isDefined(task.styleDim[axisDim[crossAxis]]) && !item->outOfViewport &&
+            hasEnoughNodesForTask(item, budget)) {
+          task.item = item;
+          task.parentWidth = availableSize.width;
+          task.parentHeight = availableSize.height;
+          task.direction = getLayoutDirection();
+          task.layoutContext = layoutContext;
+          tasks.push_back(task);
+        }
+      }
+      runItemLayoutTasks(tasks, pool);
+    }
+
+    size_t nextTask = 0;
     for (size_t j = 0; j < line->items.size(); j++) {
       HPNodeRef item = line->items[j];
       // item's main axis size has been determined.
@@ -1142,19 +1738,29 @@ float HPNode::determineCrossAxisSize(std::vector<FlexLine*>& flexLines,
       // happen. 7.Determine the hypothetical cross size of each item by
       // performing layout with the used main size and the available space,
       // treating auto as fit-content.
-      FlexLayoutAction oldLayoutAction = layoutAction;
-      if (getNodeAlign(item) == FlexAlignStretch && item->style.isDimensionAuto(crossAxis) &&
-          !item->style.hasAutoMargin(crossAxis) && layoutAction == LayoutActionLayout) {
-        // Delay layout for stretch item, do layout later in step 11.
-        layoutAction =
-            axisDim[crossAxis] == DimWidth ? LayoutActionMeasureWidth : LayoutActionMeasureHeight;
+      if (nextTask < tasks.size() && tasks[nextTask].item == item) {
+        // has been laid out in parallel.
+        nextTask++;
+      } else if (item->outOfViewport) {
+        // skipped by windowed layout, keep cross size of last pass.
+        if (isDefined(item->style.getDim(crossAxis))) {
+          item->setLayoutDim(crossAxis, item->boundAxis(crossAxis, item->style.getDim(crossAxis)));
+        }
+      } else {
+        FlexLayoutAction oldLayoutAction = layoutAction;
+        if (getNodeAlign(item) == FlexAlignStretch && item->style.isDimensionAuto(crossAxis) &&
+            !item->style.hasAutoMargin(crossAxis) && layoutAction == LayoutActionLayout) {
+          // Delay layout for stretch item, do layout later in step 11.
+          layoutAction =
+              axisDim[crossAxis] == DimWidth ? LayoutActionMeasureWidth : LayoutActionMeasureHeight;
+        }
+        float oldMainDim = item->style.getDim(mainAxis);
+        item->style.setDim(mainAxis, item->getLayoutDim(mainAxis));
+        item->layoutImpl(availableSize.width, availableSize.height, getLayoutDirection(),
+                         layoutAction, layoutContext);
+        item->style.setDim(mainAxis, oldMainDim);
+        layoutAction = oldLayoutAction;
       }
-      float oldMainDim = item->style.getDim(mainAxis);
-      item->style.setDim(mainAxis, item->getLayoutDim(mainAxis));
-      item->layoutImpl(availableSize.width, availableSize.height, getLayoutDirection(),
-                       layoutAction, layoutContext);
-      item->style.setDim(mainAxis, oldMainDim);
-      layoutAction = oldLayoutAction;
       // if child item had overflow , then transfer this state to its parent.
       // see HippyTest_HadOverflowTests.spacing_overflow_in_nested_nodes in
       // ./tests/HPHadOverflowTest.cpp
@@ -1227,6 +1833,9 @@ float HPNode::determineCrossAxisSize(std::vector<FlexLine*>& flexLines,
           !item->style.hasAutoMargin(crossAxis)) {
         item->result.dim[axisDim[crossAxis]] =
             item->boundAxis(crossAxis, line->lineCrossSize - item->getMargin(crossAxis));
+        if (item->outOfViewport) {
+          continue;
+        }
         // If the flex item has align-self: stretch, redo layout for its
         // contents, treating this used size as its definite cross size so that
         // percentage-sized children can be resolved.
@@ -1429,6 +2038,39 @@ void HPNode::layoutFixedItems(HPSizeMode measureMode, void* layoutContext) {
   FlexDirection mainAxis = resolveMainAxis();
   FlexDirection crossAxis = resolveCrossAxis();
   std::vector<HPNodeRef>& items = children;
+  float parentWidth = getLayoutDim(FLexDirectionRow) - getPaddingAndBorder(FLexDirectionRow);
+  float parentHeight =
+      getLayoutDim(FLexDirectionColumn) - getPaddingAndBorder(FLexDirectionColumn);
+
+  // in parallel layout, absolute items with definite size (or all insets set)
+  // are laid out in worker threads first.
+  std::vector<HPItemLayoutTask> tasks;
+  HPThreadPool* pool = _config != nullptr ? _config->GetThreadPool() : nullptr;
+  if (pool != nullptr) {
+    for (size_t i = 0; i < items.size(); i++) {
+      HPNodeRef item = items[i];
+      uint32_t budget = _config->parallelTaskNodes;
+      if (item->style.displayType == DisplayTypeNone ||
+          item->style.positionType != PositionTypeAbsolute ||
+          !hasEnoughNodesForTask(item, budget)) {
+        continue;
+      }
+      HPItemLayoutTask task;
+      task.styleDim[DimWidth] = getFixedItemStyleDim(item, FLexDirectionRow);
+      task.styleDim[DimHeight] = getFixedItemStyleDim(item, FLexDirectionColumn);
+      if (isDefined(task.styleDim[DimWidth]) && isDefined(task.styleDim[DimHeight])) {
+        task.item = item;
+        task.parentWidth = parentWidth;
+        task.parentHeight = parentHeight;
+        task.direction = getLayoutDirection();
+        task.layoutContext = layoutContext;
+        tasks.push_back(task);
+      }
+    }
+    runItemLayoutTasks(tasks, pool);
+  }
+
+  size_t nextTask = 0;
   for (size_t i = 0; i < items.size(); i++) {
     HPNodeRef item = items[i];
     // for display none item, reset its layout result.
@@ -1440,35 +2082,21 @@ void HPNode::layoutFixedItems(HPSizeMode measureMode, void* layoutContext) {
       continue;
     }
 
-    float parentWidth = getLayoutDim(FLexDirectionRow) - getPaddingAndBorder(FLexDirectionRow);
-    float parentHeight =
-        getLayoutDim(FLexDirectionColumn) - getPaddingAndBorder(FLexDirectionColumn);
-
-    float itemOldStyleDimMainAxis = item->style.getDim(mainAxis);
-    float itemOldStyleDimCrossAxis = item->style.getDim(crossAxis);
-
-    if (isUndefined(itemOldStyleDimMainAxis) && isDefined(item->style.getStartPosition(mainAxis)) &&
-        isDefined(item->style.getEndPosition(mainAxis))) {
-      item->style.setDim(mainAxis,
-                         (getLayoutDim(mainAxis) - style.getStartBorder(mainAxis) -
-                          style.getEndBorder(mainAxis) - item->style.getStartPosition(mainAxis) -
-                          item->style.getEndPosition(mainAxis) - item->getMargin(mainAxis)));
-    }
-
-    if (isUndefined(itemOldStyleDimCrossAxis) &&
-        isDefined(item->style.getStartPosition(crossAxis)) &&
-        isDefined(item->style.getEndPosition(crossAxis))) {
-      item->style.setDim(crossAxis,
-                         (getLayoutDim(crossAxis) - style.getStartBorder(crossAxis) -
-                          style.getEndBorder(crossAxis) - item->style.getStartPosition(crossAxis) -
-                          item->style.getEndPosition(crossAxis) - item->getMargin(crossAxis)));
+    if (nextTask < tasks.size() && tasks[nextTask].item == item) {
+      // has been laid out in parallel.
+      nextTask++;
+    } else {
+      float itemOldStyleDimMainAxis = item->style.getDim(mainAxis);
+      float itemOldStyleDimCrossAxis = item->style.getDim(crossAxis);
+      item->style.setDim(mainAxis, getFixedItemStyleDim(item, mainAxis));
+      item->style.setDim(crossAxis, getFixedItemStyleDim(item, crossAxis));
+
+      item->layoutImpl(parentWidth, parentHeight, getLayoutDirection(), LayoutActionLayout,
+                       layoutContext);
+      // recover item's previous style value
+      item->style.setDim(mainAxis, itemOldStyleDimMainAxis);
+      item->style.setDim(crossAxis, itemOldStyleDimCrossAxis);
     }
-
-    item->layoutImpl(parentWidth, parentHeight, getLayoutDirection(), LayoutActionLayout,
-                     layoutContext);
-    // recover item's previous style value
-    item->style.setDim(mainAxis, itemOldStyleDimMainAxis);
-    item->style.setDim(crossAxis, itemOldStyleDimCrossAxis);
     // after layout, calculate fix item 's postion
     // 1) for main axis
     calculateFixedItemPosition(item, mainAxis);
@@ -1477,6 +2105,58 @@ void HPNode::layoutFixedItems(HPSizeMode measureMode, void* layoutContext) {
   }
 }
 
+// style dim of absolute item in the axis, decided by its insets if not set.
+float HPNode::getFixedItemStyleDim(HPNodeRef item, FlexDirection axis) {
+  float dim = item->style.getDim(axis);
+  if (isUndefined(dim) && isDefined(item->style.getStartPosition(axis)) &&
+      isDefined(item->style.getEndPosition(axis))) {
+    dim = getLayoutDim(axis) - style.getStartBorder(axis) - style.getEndBorder(axis) -
+          item->style.getStartPosition(axis) - item->style.getEndPosition(axis) -
+          item->getMargin(axis);
+  }
+  return dim;
+}
+
+// count nodes of item's subtree down from budget, stop when it runs out.
+bool HPNode::hasEnoughNodesForTask(HPNodeRef item, uint32_t& budget) {
+  if (--budget == 0) {
+    return true;
+  }
+  for (size_t i = 0; i < item->children.size(); i++) {
+    if (hasEnoughNodesForTask(item->children[i], budget)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void HPNode::runItemLayoutTask(void* arg) {
+  HPItemLayoutTask* task = reinterpret_cast<HPItemLayoutTask*>(arg);
+  HPNodeRef item = task->item;
+  float oldWidth = item->style.getDim(DimWidth);
+  float oldHeight = item->style.getDim(DimHeight);
+  item->style.setDim(DimWidth, task->styleDim[DimWidth]);
+  item->style.setDim(DimHeight, task->styleDim[DimHeight]);
+  item->layoutImpl(task->parentWidth, task->parentHeight, task->direction, LayoutActionLayout,
+                   task->layoutContext);
+  item->style.setDim(DimWidth, oldWidth);
+  item->style.setDim(DimHeight, oldHeight);
+}
+
+void HPNode::runItemLayoutTasks(std::vector<HPItemLayoutTask>& tasks, HPThreadPool* pool) {
+  if (tasks.empty()) {
+    return;
+  }
+  // tasks vector is not changed until all tasks done, current thread takes
+  // the first one.
+  HPTaskGroup group;
+  for (size_t i = 1; i < tasks.size(); i++) {
+    pool->dispatch(&group, runItemLayoutTask, &tasks[i]);
+  }
+  runItemLayoutTask(&tasks[0]);
+  pool->wait(&group);
+}
+
 // when item's layout complete, update fixed item's position on Specified axis
 // called in layoutFixedItems
 // should be called twice, one for main axis ,one for cross axis
@@ -1516,44 +2196,3 @@ void HPNode::calculateFixedItemPosition(HPNodeRef item, FlexDirection axis) {
         axis, getLayoutDim(axis) - item->getLayoutStartPosition(axis) - item->getLayoutDim(axis));
   }
 }
-
-// convert position and dimension values to integer value..
-// absLeft, absTop is mainly think about the influence of parent's Fraction
-// offset for example: if parent's Fraction offset is 0.3 and current child
-// offset is 0.4 then the child's absolute offset  is 0.7. if use roundf ,
-// roundf(0.7) == 1 so we need absLeft, absTop  parameter
-void HPNode::convertLayoutResult(float absLeft, float absTop, float scaleFactor) {
-  if (!hasNewLayout()) {
-    return;
-  }
-  const float left = result.position[CSSLeft];
-  const float top = result.position[CSSTop];
-  const float width = result.dim[DimWidth];
-  const float height = result.dim[DimHeight];
-
-  absLeft += left;
-  absTop += top;
-  bool isTextNode = style.nodeType == NodeTypeText;
-  result.position[CSSLeft] = HPRoundValueToPixelGrid(left, scaleFactor, false, isTextNode);
-  result.position[CSSTop] = HPRoundValueToPixelGrid(top, scaleFactor, false, isTextNode);
-
-  const bool hasFractionalWidth =
-      !FloatIsEqual(fmodf(width, 1.0), 0) && !FloatIsEqual(fmodf(width, 1.0), 1.0);
-  const bool hasFractionalHeight =
-      !FloatIsEqual(fmodf(height, 1.0), 0) && !FloatIsEqual(fmodf(height, 1.0), 1.0);
-
-  const float absRight = absLeft + width;
-  const float absBottom = absTop + height;
-  result.dim[DimWidth] = HPRoundValueToPixelGrid(absRight, scaleFactor,(isTextNode && hasFractionalWidth),
-                                                 (isTextNode && !hasFractionalWidth)) -
-                         HPRoundValueToPixelGrid(absLeft, scaleFactor, false, isTextNode);
-
-  result.dim[DimHeight] = HPRoundValueToPixelGrid(absBottom, scaleFactor, (isTextNode && hasFractionalHeight),
-                                                  (isTextNode && !hasFractionalHeight)) -
-                          HPRoundValueToPixelGrid(absTop, scaleFactor, false, isTextNode);
-  std::vector<HPNodeRef>& items = children;
-  for (size_t i = 0; i < items.size(); i++) {
-    HPNodeRef item = items[i];
-    item->convertLayoutResult(absLeft, absTop, scaleFactor);
-  }
-}
@@ -19,17 +19,24 @@
 
 #include <vector>
 
+// include std thread headers, must be ahead of HPUtil.h which redefines nullptr.
+#include "HPSharedMeasureCache.h"
+#include "HPThreadPool.h"
+
 #include "Flex.h"
 #include "FlexLine.h"
 #include "HPLayoutCache.h"
 #include "HPStyle.h"
 #include "HPUtil.h"
 #include "HPConfig.h"
+#include "HPFlexLineArena.h"
+#include "HPNodePool.h"
 
 HPConfigRef HPConfigGetDefault();
 
 class HPNode;
 typedef HPNode *HPNodeRef;
+struct HPItemLayoutTask;
 typedef HPSize (*HPMeasureFunc)(HPNodeRef node,
                                 float width,
                                 MeasureMode widthMeasureMode,
@@ -38,6 +45,85 @@ typedef HPSize (*HPMeasureFunc)(HPNodeRef node,
                                 void *layoutContext);
 typedef void (*HPDirtiedFunc)(HPNodeRef node);
 
+// a measure call of content node collected in batch measure mode.
+typedef struct HPMeasureRequest {
+  HPNodeRef node;
+  // node's context, see HPNode::setContext
+  void *context;
+  float width;
+  MeasureMode widthMeasureMode;
+  float height;
+  MeasureMode heightMeasureMode;
+  // written by HPBatchMeasureFunc
+  HPSize result;
+} HPMeasureRequest;
+// measure all requests of a pass in one call, see HPBatchMeasure.h
+typedef void (*HPBatchMeasureFunc)(HPMeasureRequest *requests,
+                                   uint32_t count,
+                                   void *layoutContext);
+
+// windowed layout range of a scroll container, see HPNode::setViewport.
+typedef struct HPViewport {
+  // scroll offset from container's main start edge and visible size,
+  // both along container's main axis.
+  float offset;
+  float size;
+  // extra range laid out before and after the visible one.
+  float margin;
+  // main size of items never laid out and without definite main size.
+  float estimatedItemSize;
+} HPViewport;
+
+// a child's index after HPNode::applyChildMoves, negative to remove it.
+// a node not yet a child is inserted.
+typedef struct HPChildMove {
+  HPNodeRef child;
+  int32_t toIndex;
+} HPChildMove;
+
+// a layoutImpl call of parent and its result, kept in incremental layout
+// to relayout the node alone with the same calls, see HPNode::relayoutAlone.
+typedef struct HPLayoutInput {
+  float parentWidth;
+  float parentHeight;
+  // style width and height during the call, parent may set them.
+  float styleWidth;
+  float styleHeight;
+  HPDirection direction;
+  FlexLayoutAction layoutAction;
+  HPSize resultSize;
+  bool hadOverflow;
+} HPLayoutInput;
+
+// layoutImpl calls of parent kept by a node, more calls than this
+// make it relayout with its parent.
+#define HP_MAX_LAYOUT_INPUTS 16
+
+// state of the layout modes a node takes part in, allocated on first use by
+// HPNode::getModeState, so nodes laid out in the default mode don't carry it.
+typedef struct HPNodeModeState {
+  // incremental layout: calls of parent since its layout cache is cleared,
+  // index of the last layout one, and whether some calls were dropped.
+  std::vector<HPLayoutInput> layoutInputs;
+  int32_t lastLayoutInput = -1;
+  bool layoutInputsOverflow = false;
+  // windowed layout of scroll container, valid if hasViewport is true.
+  bool hasViewport = false;
+  HPViewport viewport = HPViewport();
+  // detached with its layout kept, see HPConfig::SetRetainDetachedLayout,
+  // and style hash of its subtree when it's detached.
+  bool hasRetainedLayout = false;
+  uint64_t retainedStyleHash = 0;
+  // cached subtreeStyleHash, invalidated up to the root by style and
+  // children changes, so an invalid node has no valid ancestor.
+  bool hasSubtreeStyleHash = false;
+  uint64_t cachedSubtreeStyleHash = 0;
+  // double buffered layout, see HPLayoutPipeline: the copy of this pending
+  // node in the layout tree, and the pending node a layout tree node copies.
+  HPNodeRef shadow = nullptr;
+  HPNodeRef origin = nullptr;
+} HPNodeModeState;
+
 class HPNode {
  public:
   HPNode() : HPNode{HPConfigGetDefault()} {}
@@ -52,16 +138,26 @@ class HPNode {
   void setParent(HPNodeRef _parent);
   HPNodeRef getParent();
   void addChild(HPNodeRef item);
+  // insertChild and removeChild shift and renumber the children after the
+  // index, they are O(1) only at the end.
   bool insertChild(HPNodeRef item, uint32_t index);
   HPNodeRef getChild(uint32_t index);
   bool removeChild(HPNodeRef child);
   bool removeChild(uint32_t index);
+  // index of child, -1 if it's not a child of this node.
+  int32_t indexOfChild(HPNodeRef child);
+  // remove, move and insert children in one linear pass, the moved and
+  // inserted ones are at their toIndex after it and the others keep their
+  // order. this node is marked dirty once. return false and change nothing
+  // if a move is invalid.
+  bool applyChildMoves(const HPChildMove* moves, uint32_t count);
   uint32_t childCount();
 
   void setDisplayType(DisplayType displayType);
   void setHasNewLayout(bool hasNewLayoutOrNot);
   bool hasNewLayout();
   void markAsDirty();
+  void markAsDirtyByChild();
   void setDirty(bool dirtyOrNot);
   void setDirtiedFunc(HPDirtiedFunc _dirtiedFunc);
 
@@ -99,7 +195,8 @@ class HPNode {
               float parentHeight,
               HPConfigRef config,
               HPDirection parentDirection = DirectionLTR,
-              void *layoutContext = nullptr);
+              void *layoutContext = nullptr,
+              HPBatchMeasureFunc batchMeasureFunc = nullptr);
   float getMainAxisDim();
   float getLayoutDim(FlexDirection axis);
   bool isLayoutDimDefined(FlexDirection axis);
@@ -109,6 +206,14 @@ class HPNode {
   FlexAlign getNodeAlign(HPNodeRef item);
   void SetConfig(HPConfigRef config);
   HPConfigRef GetConfig();
+  // modeState, allocated if this node has none yet.
+  HPNodeModeState* getModeState();
+  // lay out only items in viewport range of this scroll container, the
+  // others keep main size of last pass or an estimated one. marks node dirty
+  // if items skipped in last pass come into the range.
+  void setViewport(const HPViewport &newViewport);
+  void clearViewport();
+  bool useViewportLayout();
 
  protected:
   HPDirection resolveDirection(HPDirection parentDirection);
@@ -117,6 +222,11 @@ class HPNode {
   void cacheLayoutOrMeasureResult(HPSize availableSize,
                                   HPSizeMode measureMode,
                                   FlexLayoutAction layoutAction);
+  HPSize measureContent(float availableWidth,
+                        MeasureMode widthMeasureMode,
+                        float availableHeight,
+                        MeasureMode heightMeasureMode,
+                        void *layoutContext);
   void layoutSingleNode(float availableWidth,
                         MeasureMode widthMeasureMode,
                         float availableHeight,
@@ -128,8 +238,15 @@ class HPNode {
                   HPDirection parentDirection,
                   FlexLayoutAction layoutAction,
                   void *layoutContext = nullptr);
+  void flexLayout(float parentWidth,
+                  float parentHeight,
+                  HPDirection parentDirection,
+                  FlexLayoutAction layoutAction,
+                  void *layoutContext);
   void calculateItemsFlexBasis(HPSize availableSize, void *layoutContext);
-  bool collectFlexLines(std::vector<FlexLine *> &flexLines, HPSize availableSize);
+  bool collectFlexLines(HPFlexLineArena *arena,
+                        std::vector<FlexLine *> &flexLines,
+                        HPSize availableSize);
   void determineItemsMainAxisSize(std::vector<FlexLine *> &flexLines,
                                   FlexLayoutAction layoutAction);
   float determineCrossAxisSize(std::vector<FlexLine *> &flexLines,
@@ -141,8 +258,28 @@ class HPNode {
 
   void layoutFixedItems(HPSizeMode measureMode, void *layoutContext);
   void calculateFixedItemPosition(HPNodeRef item, FlexDirection axis);
+  float getFixedItemStyleDim(HPNodeRef item, FlexDirection axis);
+
+  static bool hasEnoughNodesForTask(HPNodeRef item, uint32_t &budget);
+  static void runItemLayoutTask(void *arg);
+  static void runItemLayoutTasks(std::vector<HPItemLayoutTask> &tasks, HPThreadPool *pool);
 
-  void convertLayoutResult(float absLeft, float absTop, float scaleFactor);
+  bool hasSkippedItemInViewport();
+  float estimateItemMainSize(HPNodeRef item);
+
+  void markHasDirtyDescendant();
+  void attachChild(HPNodeRef child);
+  void detachChild(HPNodeRef child);
+  uint64_t subtreeStyleHash();
+  void invalidateSubtreeStyleHash();
+  void setHasNewLayoutRecursive();
+  void renumberChildren(size_t from);
+  bool isSelfOrAncestor(HPNodeRef node);
+  bool updateDirtyDescendants(void *layoutContext);
+  bool relayoutWithLayoutInputs(void *layoutContext);
+  void recordLayoutInput(const HPLayoutInput &input);
+  void clearLayoutInputs();
+  void clearLayoutCache();
 
  public:
   HPStyle style;
@@ -152,9 +289,17 @@ class HPNode {
   std::vector<HPNodeRef> children;
   HPNodeRef parent;
   HPMeasureFunc measure;
+  // nodes with same non zero hash share measure results in HPConfig.
+  uint64_t measureContentHash = 0;
 
   bool isFrozen;
   bool isDirty;
+  // incremental layout: this node is dirty but its parent is not, it's
+  // relayout alone with layoutInputs and its parent only if its size changes.
+  bool relayoutAlone = false;
+  // incremental layout: some descendant is dirty, layout cache of this
+  // node is checked against it before use, see updateDirtyDescendants.
+  bool hasDirtyDescendant = false;
   bool _hasNewLayout;
   HPDirtiedFunc dirtiedFunc;
 
@@ -163,8 +308,14 @@ class HPNode {
   // layout result is in initial state or not
   bool inInitailState;
   HPConfigRef _config = nullptr;
-
-#ifdef LAYOUT_TIME_ANALYZE
-  int fetchCount;
-#endif
+  // pool that this node's memory comes from, null if allocated by new.
+  HPNodePool* nodePool = nullptr;
+  // out of parent's viewport range in last pass, this node's subtree
+  // was not laid out, its size is estimated or from an earlier pass.
+  bool outOfViewport = false;
+  // index in parent's children, kept by child list operations of this class,
+  // checked before use as children may be changed directly.
+  uint32_t indexInParent = 0;
+  // null until this node takes part in some layout mode, see HPNodeModeState.
+  HPNodeModeState* modeState = nullptr;
 };
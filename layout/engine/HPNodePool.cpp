@@ -0,0 +1,83 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPNodePool.h"
+
+#include "HPNode.h"
+
+HPNodePool::HPNodePool(uint32_t nodesPerBlock) {
+  // each slot can hold a HPNode or a free list link,
+  // and keep HPNode's alignment in the block.
+  size_t size = sizeof(HPNode) > sizeof(FreeSlot) ? sizeof(HPNode) : sizeof(FreeSlot);
+  size_t align = alignof(HPNode);
+  slotSize = (size + align - 1) / align * align;
+  this->nodesPerBlock = nodesPerBlock > 0 ? nodesPerBlock : HP_NODE_POOL_BLOCK_SIZE;
+  freeList = nullptr;
+  usedInLastBlock = 0;
+  liveSlots = 0;
+}
+
+HPNodePool::~HPNodePool() {
+  // nodes allocated from this pool must be freed before.
+  ASSERT(liveSlots == 0);
+  for (size_t i = 0; i < blocks.size(); i++) {
+    delete[] blocks[i];
+  }
+  blocks.clear();
+  freeList = nullptr;
+}
+
+void HPNodePool::allocateBlock() {
+  // new char[] is aligned for any fundamental type, so is for HPNode.
+  blocks.push_back(new char[slotSize * nodesPerBlock]);
+  usedInLastBlock = 0;
+}
+
+void* HPNodePool::allocate() {
+  void* slot = nullptr;
+  if (freeList != nullptr) {
+    slot = freeList;
+    freeList = freeList->next;
+  } else {
+    if (blocks.empty() || usedInLastBlock == nodesPerBlock) {
+      allocateBlock();
+    }
+    slot = blocks.back() + slotSize * usedInLastBlock;
+    usedInLastBlock++;
+  }
+  liveSlots++;
+  return slot;
+}
+
+void HPNodePool::deallocate(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  ASSERT(liveSlots > 0);
+  FreeSlot* slot = reinterpret_cast<FreeSlot*>(ptr);
+  slot->next = freeList;
+  freeList = slot;
+  liveSlots--;
+}
+
+uint32_t HPNodePool::liveCount() {
+  return liveSlots;
+}
+
+uint32_t HPNodePool::blockCount() {
+  return blocks.size();
+}
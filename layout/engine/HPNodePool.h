@@ -0,0 +1,61 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module is a fixed size slab allocator for HPNode.
+ * HPNode memory is carved out from big blocks and recycled by a free list,
+ * so creating and freeing nodes in list screens do not hit malloc.
+ * It's not thread safe, the nodes of one pool must be created and freed
+ * in the same thread, as the layout tree is.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#define HP_NODE_POOL_BLOCK_SIZE 256
+
+class HPNodePool {
+ public:
+  explicit HPNodePool(uint32_t nodesPerBlock = HP_NODE_POOL_BLOCK_SIZE);
+  virtual ~HPNodePool();
+  // return memory that can hold one HPNode, use placement new on it.
+  void* allocate();
+  // give back memory of a destructed HPNode.
+  void deallocate(void* ptr);
+  // count of slots allocated and not deallocated.
+  uint32_t liveCount();
+  uint32_t blockCount();
+
+ protected:
+  void allocateBlock();
+
+ private:
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+
+  std::vector<char*> blocks;
+  FreeSlot* freeList;
+  size_t slotSize;
+  uint32_t nodesPerBlock;
+  // slots already used in the last block
+  uint32_t usedInLastBlock;
+  uint32_t liveSlots;
+};
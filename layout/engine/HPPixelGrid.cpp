@@ -0,0 +1,124 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPPixelGrid.h"
+
+#include <math.h>
+
+#include "HPSimd.h"
+#include "HPNode.h"
+
+#define HP_PIXEL_GRID_VALUES_PER_NODE 6
+
+void HPRoundValuesToPixelGrid(float* values,
+                              const uint32_t* forceCeil,
+                              const uint32_t* forceFloor,
+                              uint32_t count,
+                              float scaleFactor) {
+  uint32_t i = 0;
+#if HP_SIMD
+  // branches of HPRoundValueToPixelGrid as lane masks:
+  // value * scale - fraction, plus 1 unless the fraction is ~0 or floored.
+  const HPFloat4 scale = HPFloat4Splat(scaleFactor);
+  const HPFloat4 zero = HPFloat4Splat(0.0f);
+  const HPFloat4 one = HPFloat4Splat(1.0f);
+  const HPFloat4 half = HPFloat4Splat(0.5f);
+  const HPFloat4 epsilon = HPFloat4Splat(0.0001f);
+  for (; i + 4 <= count; i += 4) {
+    HPFloat4 scaleValue = HPFloat4Mul(HPFloat4Load(values + i), scale);
+    HPFloat4 fraction = HPFloat4Fraction(scaleValue);
+    fraction = HPFloat4Select(HPFloat4Less(fraction, zero), HPFloat4Add(fraction, one), fraction);
+
+    HPFloat4 isZero = HPFloat4Less(HPFloat4Abs(fraction), epsilon);
+    HPFloat4 isOne = HPFloat4Less(HPFloat4Abs(HPFloat4Sub(fraction, one)), epsilon);
+    HPFloat4 roundUp = HPFloat4Or(HPFloat4Greater(fraction, half),
+                                  HPFloat4Less(HPFloat4Abs(HPFloat4Sub(fraction, half)), epsilon));
+    HPFloat4 ceil = HPFloat4LoadMask(forceCeil + i);
+    HPFloat4 floor = HPFloat4LoadMask(forceFloor + i);
+    HPFloat4 addOne = HPFloat4Or(HPFloat4Or(isOne, ceil), HPFloat4AndNot(floor, roundUp));
+    addOne = HPFloat4AndNot(isZero, addOne);
+
+    HPFloat4 rounded = HPFloat4Add(HPFloat4Sub(scaleValue, fraction), HPFloat4And(addOne, one));
+    HPFloat4Store(values + i, HPFloat4Div(rounded, scale));
+  }
+#endif
+  for (; i < count; i++) {
+    values[i] = HPRoundValueToPixelGrid(values[i], scaleFactor, forceCeil[i] != 0, forceFloor[i] != 0);
+  }
+}
+
+void HPPixelGrid::round(HPNodeRef root, float scaleFactor) {
+  nodes.clear();
+  values.clear();
+  forceCeil.clear();
+  forceFloor.clear();
+  gather(root, 0.0f, 0.0f);
+  if (nodes.empty()) {
+    return;
+  }
+
+  HPRoundValuesToPixelGrid(values.data(), forceCeil.data(), forceFloor.data(), values.size(),
+                           scaleFactor);
+
+  const float* value = values.data();
+  for (size_t i = 0; i < nodes.size(); i++, value += HP_PIXEL_GRID_VALUES_PER_NODE) {
+    HPLayout& result = nodes[i]->result;
+    result.position[CSSLeft] = value[0];
+    result.position[CSSTop] = value[1];
+    result.dim[DimWidth] = value[4] - value[2];
+    result.dim[DimHeight] = value[5] - value[3];
+  }
+}
+
+// absLeft, absTop is mainly think about the influence of parent's Fraction
+// offset for example: if parent's Fraction offset is 0.3 and current child
+// offset is 0.4 then the child's absolute offset  is 0.7. if use roundf ,
+// roundf(0.7) == 1 so we need absLeft, absTop  parameter
+void HPPixelGrid::gather(HPNodeRef node, float absLeft, float absTop) {
+  if (!node->hasNewLayout()) {
+    return;
+  }
+  const HPLayout& result = node->result;
+  const float left = result.position[CSSLeft];
+  const float top = result.position[CSSTop];
+  const float width = result.dim[DimWidth];
+  const float height = result.dim[DimHeight];
+  absLeft += left;
+  absTop += top;
+
+  const uint32_t isTextNode = node->style.nodeType == NodeTypeText ? ~0u : 0u;
+  const uint32_t hasFractionalWidth =
+      !FloatIsEqual(fmodf(width, 1.0), 0) && !FloatIsEqual(fmodf(width, 1.0), 1.0) ? ~0u : 0u;
+  const uint32_t hasFractionalHeight =
+      !FloatIsEqual(fmodf(height, 1.0), 0) && !FloatIsEqual(fmodf(height, 1.0), 1.0) ? ~0u : 0u;
+
+  nodes.push_back(node);
+  const float nodeValues[HP_PIXEL_GRID_VALUES_PER_NODE] = {
+      left, top, absLeft, absTop, absLeft + width, absTop + height};
+  const uint32_t nodeCeil[HP_PIXEL_GRID_VALUES_PER_NODE] = {
+      0, 0, 0, 0, isTextNode & hasFractionalWidth, isTextNode & hasFractionalHeight};
+  const uint32_t nodeFloor[HP_PIXEL_GRID_VALUES_PER_NODE] = {
+      isTextNode, isTextNode, isTextNode, isTextNode,
+      isTextNode & ~hasFractionalWidth, isTextNode & ~hasFractionalHeight};
+  values.insert(values.end(), nodeValues, nodeValues + HP_PIXEL_GRID_VALUES_PER_NODE);
+  forceCeil.insert(forceCeil.end(), nodeCeil, nodeCeil + HP_PIXEL_GRID_VALUES_PER_NODE);
+  forceFloor.insert(forceFloor.end(), nodeFloor, nodeFloor + HP_PIXEL_GRID_VALUES_PER_NODE);
+
+  for (size_t i = 0; i < node->children.size(); i++) {
+    gather(node->children[i], absLeft, absTop);
+  }
+}
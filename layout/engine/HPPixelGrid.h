@@ -0,0 +1,57 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module rounds layout results of a tree to the pixel grid in one
+ * flattened pass. positions and sizes of nodes with new layout are gathered
+ * into contiguous arrays, rounded four at a time with HPSimd.h and written
+ * back to the nodes. each value is rounded bit-identical to
+ * HPRoundValueToPixelGrid.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+class HPNode;
+typedef HPNode* HPNodeRef;
+
+// round values[i] as HPRoundValueToPixelGrid(values[i], scaleFactor,
+// forceCeil[i] != 0, forceFloor[i] != 0), masks are all 0 or all 1 bits.
+void HPRoundValuesToPixelGrid(float* values,
+                              const uint32_t* forceCeil,
+                              const uint32_t* forceFloor,
+                              uint32_t count,
+                              float scaleFactor);
+
+class HPPixelGrid {
+ public:
+  // round root and its descendants with new layout, arrays' capacity is
+  // kept for next pass.
+  void round(HPNodeRef root, float scaleFactor);
+
+ protected:
+  void gather(HPNodeRef node, float absLeft, float absTop);
+
+ private:
+  std::vector<HPNodeRef> nodes;
+  // per node: left, top in parent, then absolute left, top, right, bottom.
+  std::vector<float> values;
+  std::vector<uint32_t> forceCeil;
+  std::vector<uint32_t> forceFloor;
+};
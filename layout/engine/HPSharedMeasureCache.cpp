@@ -0,0 +1,122 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPSharedMeasureCache.h"
+
+#include <functional>
+
+#include "HPUtil.h"
+
+HPSharedMeasureCache::HPSharedMeasureCache(uint32_t capacity) {
+  this->capacity = capacity > 0 ? capacity : 1;
+  stats.hits = 0;
+  stats.misses = 0;
+  stats.evictions = 0;
+}
+
+HPSharedMeasureCache::~HPSharedMeasureCache() {}
+
+bool HPSharedMeasureCache::Key::operator==(const Key& other) const {
+  return contentHash == other.contentHash && measureId == other.measureId &&
+         width == other.width && height == other.height &&
+         widthMeasureMode == other.widthMeasureMode &&
+         heightMeasureMode == other.heightMeasureMode;
+}
+
+size_t HPSharedMeasureCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = std::hash<uint64_t>()(key.contentHash);
+  hash = hash * 31 + std::hash<const void*>()(key.measureId);
+  hash = hash * 31 + std::hash<float>()(key.width);
+  hash = hash * 31 + std::hash<float>()(key.height);
+  hash = hash * 31 + (key.widthMeasureMode << 2 | key.heightMeasureMode);
+  return hash;
+}
+
+HPSharedMeasureCache::Key HPSharedMeasureCache::makeKey(uint64_t contentHash,
+                                                        const void* measureId,
+                                                        HPSize availableSize,
+                                                        HPSizeMode measureMode) {
+  Key key;
+  key.contentHash = contentHash;
+  key.measureId = measureId;
+  // NAN never equals itself, undefined size is keyed by its mode only.
+  key.width = isUndefined(availableSize.width) ? -1.0f : availableSize.width;
+  key.height = isUndefined(availableSize.height) ? -1.0f : availableSize.height;
+  key.widthMeasureMode = measureMode.widthMeasureMode;
+  key.heightMeasureMode = measureMode.heightMeasureMode;
+  return key;
+}
+
+bool HPSharedMeasureCache::get(uint64_t contentHash,
+                               const void* measureId,
+                               HPSize availableSize,
+                               HPSizeMode measureMode,
+                               HPSize& resultSize) {
+  Key key = makeKey(contentHash, measureId, availableSize, measureMode);
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(key);
+  if (it == index.end()) {
+    stats.misses++;
+    return false;
+  }
+  stats.hits++;
+  entries.splice(entries.begin(), entries, it->second);
+  resultSize = it->second->second;
+  return true;
+}
+
+void HPSharedMeasureCache::put(uint64_t contentHash,
+                               const void* measureId,
+                               HPSize availableSize,
+                               HPSizeMode measureMode,
+                               HPSize resultSize) {
+  Key key = makeKey(contentHash, measureId, availableSize, measureMode);
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(key);
+  if (it != index.end()) {
+    it->second->second = resultSize;
+    entries.splice(entries.begin(), entries, it->second);
+    return;
+  }
+  if (entries.size() >= capacity) {
+    index.erase(entries.back().first);
+    entries.pop_back();
+    stats.evictions++;
+  }
+  entries.push_front(std::make_pair(key, resultSize));
+  index[key] = entries.begin();
+}
+
+void HPSharedMeasureCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.clear();
+  index.clear();
+}
+
+uint32_t HPSharedMeasureCache::size() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return entries.size();
+}
+
+uint32_t HPSharedMeasureCache::getCapacity() {
+  return capacity;
+}
+
+HPMeasureCacheStats HPSharedMeasureCache::getStats() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return stats;
+}
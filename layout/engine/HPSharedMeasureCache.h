@@ -0,0 +1,86 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module is a measure result cache shared by nodes of a HPConfig.
+ * nodes with same content (same text, font etc.) give same content hash by
+ * HPNodeSetMeasureContentHash, they reuse measure results of each other
+ * instead of calling measure function again and again.
+ * results are keyed by content hash, measure function, available size and
+ * measure modes, and the least recently used one is dropped when it's full.
+ * it's locked inside, can be used by parallel layout.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "Flex.h"
+#include "HPLayoutCache.h"
+
+class HPSharedMeasureCache {
+ public:
+  explicit HPSharedMeasureCache(uint32_t capacity);
+  virtual ~HPSharedMeasureCache();
+  // measureId tells measure functions apart, it's the function's address.
+  bool get(uint64_t contentHash,
+           const void* measureId,
+           HPSize availableSize,
+           HPSizeMode measureMode,
+           HPSize& resultSize);
+  void put(uint64_t contentHash,
+           const void* measureId,
+           HPSize availableSize,
+           HPSizeMode measureMode,
+           HPSize resultSize);
+  void clear();
+  uint32_t size();
+  uint32_t getCapacity();
+  HPMeasureCacheStats getStats();
+
+ protected:
+  struct Key {
+    uint64_t contentHash;
+    const void* measureId;
+    float width;
+    float height;
+    MeasureMode widthMeasureMode;
+    MeasureMode heightMeasureMode;
+    bool operator==(const Key& other) const;
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+  typedef std::list<std::pair<Key, HPSize>> EntryList;
+
+  static Key makeKey(uint64_t contentHash,
+                     const void* measureId,
+                     HPSize availableSize,
+                     HPSizeMode measureMode);
+
+ private:
+  std::mutex mutex;
+  // most recently used entry is at front.
+  EntryList entries;
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index;
+  uint32_t capacity;
+  HPMeasureCacheStats stats;
+};
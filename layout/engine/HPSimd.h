@@ -0,0 +1,111 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module is a small portable wrapper of 4-lane float vectors, SSE2 on
+ * x86 and NEON on arm64. HP_SIMD is 0 on other targets, callers then take
+ * their scalar path. only operations with IEEE results same as scalar float
+ * code are wrapped, armv7 NEON is left out as it flushes denormals and has
+ * no division.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HP_SIMD 1
+#define HP_SIMD_SSE2 1
+typedef __m128 HPFloat4;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define HP_SIMD 1
+#define HP_SIMD_NEON 1
+typedef float32x4_t HPFloat4;
+#else
+#define HP_SIMD 0
+#endif
+
+#if HP_SIMD
+
+// lanes of a compare result are all 1 bits or all 0 bits.
+#ifdef HP_SIMD_SSE2
+
+inline HPFloat4 HPFloat4Load(const float* p) { return _mm_loadu_ps(p); }
+inline void HPFloat4Store(float* p, HPFloat4 a) { _mm_storeu_ps(p, a); }
+inline HPFloat4 HPFloat4LoadMask(const uint32_t* p) {
+  return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+inline HPFloat4 HPFloat4Splat(float v) { return _mm_set1_ps(v); }
+inline HPFloat4 HPFloat4Add(HPFloat4 a, HPFloat4 b) { return _mm_add_ps(a, b); }
+inline HPFloat4 HPFloat4Sub(HPFloat4 a, HPFloat4 b) { return _mm_sub_ps(a, b); }
+inline HPFloat4 HPFloat4Mul(HPFloat4 a, HPFloat4 b) { return _mm_mul_ps(a, b); }
+inline HPFloat4 HPFloat4Div(HPFloat4 a, HPFloat4 b) { return _mm_div_ps(a, b); }
+inline HPFloat4 HPFloat4Abs(HPFloat4 a) {
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+}
+inline HPFloat4 HPFloat4Less(HPFloat4 a, HPFloat4 b) { return _mm_cmplt_ps(a, b); }
+inline HPFloat4 HPFloat4Greater(HPFloat4 a, HPFloat4 b) { return _mm_cmpgt_ps(a, b); }
+inline HPFloat4 HPFloat4And(HPFloat4 a, HPFloat4 b) { return _mm_and_ps(a, b); }
+// ~a & b
+inline HPFloat4 HPFloat4AndNot(HPFloat4 a, HPFloat4 b) { return _mm_andnot_ps(a, b); }
+inline HPFloat4 HPFloat4Or(HPFloat4 a, HPFloat4 b) { return _mm_or_ps(a, b); }
+// mask ? a : b
+inline HPFloat4 HPFloat4Select(HPFloat4 mask, HPFloat4 a, HPFloat4 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+// a - trunc(a), same as fmodf(a, 1.0f) except the sign of zero.
+inline HPFloat4 HPFloat4Fraction(HPFloat4 a) {
+  // values not less than 2^23 are integers, or inf and nan.
+  HPFloat4 small = _mm_cmplt_ps(HPFloat4Abs(a), _mm_set1_ps(8388608.0f));
+  HPFloat4 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+  return HPFloat4Select(small, _mm_sub_ps(a, truncated), _mm_sub_ps(a, a));
+}
+
+#else
+
+inline HPFloat4 HPFloat4Load(const float* p) { return vld1q_f32(p); }
+inline void HPFloat4Store(float* p, HPFloat4 a) { vst1q_f32(p, a); }
+inline HPFloat4 HPFloat4LoadMask(const uint32_t* p) { return vreinterpretq_f32_u32(vld1q_u32(p)); }
+inline HPFloat4 HPFloat4Splat(float v) { return vdupq_n_f32(v); }
+inline HPFloat4 HPFloat4Add(HPFloat4 a, HPFloat4 b) { return vaddq_f32(a, b); }
+inline HPFloat4 HPFloat4Sub(HPFloat4 a, HPFloat4 b) { return vsubq_f32(a, b); }
+inline HPFloat4 HPFloat4Mul(HPFloat4 a, HPFloat4 b) { return vmulq_f32(a, b); }
+inline HPFloat4 HPFloat4Div(HPFloat4 a, HPFloat4 b) { return vdivq_f32(a, b); }
+inline HPFloat4 HPFloat4Abs(HPFloat4 a) { return vabsq_f32(a); }
+inline HPFloat4 HPFloat4Less(HPFloat4 a, HPFloat4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+inline HPFloat4 HPFloat4Greater(HPFloat4 a, HPFloat4 b) {
+  return vreinterpretq_f32_u32(vcgtq_f32(a, b));
+}
+inline HPFloat4 HPFloat4And(HPFloat4 a, HPFloat4 b) {
+  return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+// ~a & b
+inline HPFloat4 HPFloat4AndNot(HPFloat4 a, HPFloat4 b) {
+  return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(b), vreinterpretq_u32_f32(a)));
+}
+inline HPFloat4 HPFloat4Or(HPFloat4 a, HPFloat4 b) {
+  return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+}
+inline HPFloat4 HPFloat4Select(HPFloat4 mask, HPFloat4 a, HPFloat4 b) {
+  return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+}
+inline HPFloat4 HPFloat4Fraction(HPFloat4 a) { return vsubq_f32(a, vrndq_f32(a)); }
+
+#endif
+
+#endif
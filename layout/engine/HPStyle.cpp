@@ -21,8 +21,27 @@
 
 #include <iostream>
 
-typedef float CSSValue[CSS_PROPS_COUNT];
-typedef CSSDirection CSSFrom[CSS_PROPS_COUNT];
+#include "HPStyleStore.h"
+
+// edges of a group never set.
+static void initEdges(HPEdges &edges, float value) {
+  for (int i = 0; i < CSS_PROPS_COUNT; i++) {
+    edges.value[i] = value;
+    edges.from[i] = CSSNONE;
+  }
+}
+
+static const HPEdges *retainEdges(const HPEdges *edges) {
+  HPStyleStore::shared()->retain(edges);
+  return edges;
+}
+
+void HPStyle::assignEdges(const HPEdges *&group, const HPEdges *edges) {
+  HPStyleStore *store = HPStyleStore::shared();
+  const HPEdges *old = group;
+  group = edges != nullptr ? store->intern(*edges) : nullptr;
+  store->release(old);
+}
 
 const char flex_direction_str[][20] = {"row", "row-reverse", "column", "column-reverse"};
 
@@ -65,22 +84,12 @@ HPStyle::HPStyle() {
   maxDim[DimWidth] = VALUE_UNDEFINED;
   maxDim[DimHeight] = VALUE_UNDEFINED;
 
-  position[CSSLeft] = VALUE_AUTO;
-  position[CSSRight] = VALUE_AUTO;
-  position[CSSTop] = VALUE_AUTO;
-  position[CSSBottom] = VALUE_AUTO;
-  position[CSSStart] = VALUE_AUTO;
-  position[CSSEnd] = VALUE_AUTO;
-
-  // CSS margin default value is 0
-  memset(reinterpret_cast<void *>(margin), 0, sizeof(float) * CSS_PROPS_COUNT);
-  // Why use 0xFF, memset fill byte as 0xFF , then marginForm[0] == CSSNone (-1)
-  memset(reinterpret_cast<void *>(marginFrom), 0xFF, sizeof(CSSDirection) * CSS_PROPS_COUNT);
-  ASSERT(marginFrom[0] == CSSNONE);
-  memset(reinterpret_cast<void *>(padding), 0, sizeof(float) * CSS_PROPS_COUNT);
-  memset(reinterpret_cast<void *>(paddingFrom), 0xFF, sizeof(CSSDirection) * CSS_PROPS_COUNT);
-  memset(reinterpret_cast<void *>(border), 0, sizeof(float) * CSS_PROPS_COUNT);
-  memset(reinterpret_cast<void *>(borderFrom), 0xFF, sizeof(CSSDirection) * CSS_PROPS_COUNT);
+  // CSS margin default value is 0, border's is 0 and position's is auto.
+  // the zero group is not counted by references.
+  margin = HPStyleStore::shared()->zeroEdges();
+  padding = margin;
+  border = nullptr;
+  position = nullptr;
 
   flexWrap = FlexNoWrap;
   flexGrow = 0;    // no grow
@@ -91,11 +100,106 @@ HPStyle::HPStyle() {
   lineSpace = 0;
 }
 
+HPStyle::HPStyle(const HPStyle &other)
+    : nodeType(other.nodeType),
+      direction(other.direction),
+      flexDirection(other.flexDirection),
+      justifyContent(other.justifyContent),
+      alignContent(other.alignContent),
+      alignItems(other.alignItems),
+      alignSelf(other.alignSelf),
+      flexWrap(other.flexWrap),
+      positionType(other.positionType),
+      displayType(other.displayType),
+      overflowType(other.overflowType),
+      flexBasis(other.flexBasis),
+      flexGrow(other.flexGrow),
+      flexShrink(other.flexShrink),
+      flex(other.flex),
+      margin(retainEdges(other.margin)),
+      padding(retainEdges(other.padding)),
+      border(retainEdges(other.border)),
+      position(retainEdges(other.position)),
+      itemSpace(other.itemSpace),
+      lineSpace(other.lineSpace) {
+  memcpy(dim, other.dim, sizeof(dim));
+  memcpy(minDim, other.minDim, sizeof(minDim));
+  memcpy(maxDim, other.maxDim, sizeof(maxDim));
+}
+
+HPStyle &HPStyle::operator=(const HPStyle &other) {
+  if (this == &other) {
+    return *this;
+  }
+  HPStyleStore *store = HPStyleStore::shared();
+  store->retain(other.margin);
+  store->retain(other.padding);
+  store->retain(other.border);
+  store->retain(other.position);
+  store->release(margin);
+  store->release(padding);
+  store->release(border);
+  store->release(position);
+  nodeType = other.nodeType;
+  direction = other.direction;
+  flexDirection = other.flexDirection;
+  justifyContent = other.justifyContent;
+  alignContent = other.alignContent;
+  alignItems = other.alignItems;
+  alignSelf = other.alignSelf;
+  flexWrap = other.flexWrap;
+  positionType = other.positionType;
+  displayType = other.displayType;
+  overflowType = other.overflowType;
+  flexBasis = other.flexBasis;
+  flexGrow = other.flexGrow;
+  flexShrink = other.flexShrink;
+  flex = other.flex;
+  margin = other.margin;
+  padding = other.padding;
+  border = other.border;
+  position = other.position;
+  memcpy(dim, other.dim, sizeof(dim));
+  memcpy(minDim, other.minDim, sizeof(minDim));
+  memcpy(maxDim, other.maxDim, sizeof(maxDim));
+  itemSpace = other.itemSpace;
+  lineSpace = other.lineSpace;
+  return *this;
+}
+
 HPStyle::~HPStyle() {
-  // TODO(ianwang): Auto-generated destructor stub
+  HPStyleStore *store = HPStyleStore::shared();
+  store->release(margin);
+  store->release(padding);
+  store->release(border);
+  store->release(position);
 }
 
-std::string edge2String(int type, CSSValue &edges, CSSFrom &edgesFrom) {
+// undefined values are equal.
+static inline bool sameValue(float a, float b) {
+  return a == b || (isUndefined(a) && isUndefined(b));
+}
+
+bool HPStyle::operator==(const HPStyle &other) const {
+  return nodeType == other.nodeType && direction == other.direction &&
+         flexDirection == other.flexDirection && justifyContent == other.justifyContent &&
+         alignContent == other.alignContent && alignItems == other.alignItems &&
+         alignSelf == other.alignSelf && flexWrap == other.flexWrap &&
+         positionType == other.positionType && displayType == other.displayType &&
+         overflowType == other.overflowType && sameValue(flexBasis, other.flexBasis) &&
+         sameValue(flexGrow, other.flexGrow) && sameValue(flexShrink, other.flexShrink) &&
+         sameValue(flex, other.flex) && margin == other.margin && padding == other.padding &&
+         border == other.border && position == other.position &&
+         sameValue(dim[DimWidth], other.dim[DimWidth]) &&
+         sameValue(dim[DimHeight], other.dim[DimHeight]) &&
+         sameValue(minDim[DimWidth], other.minDim[DimWidth]) &&
+         sameValue(minDim[DimHeight], other.minDim[DimHeight]) &&
+         sameValue(maxDim[DimWidth], other.maxDim[DimWidth]) &&
+         sameValue(maxDim[DimHeight], other.maxDim[DimHeight]) &&
+         sameValue(itemSpace, other.itemSpace) && sameValue(lineSpace, other.lineSpace);
+}
+
+std::string edge2String(int type, const HPEdges &edges) {
   std::string prefix = "";
   if (type == 0) {  // margin
     prefix = "margin";
@@ -112,60 +216,60 @@ std::string edge2String(int type, CSSValue &edges, CSSFrom &edgesFrom) {
   bool hasCSSAll = false;
   for (int i = CSSLeft; i <= CSSEnd; i++) {
     memset(str, 0, sizeof(str));
-    if (i == CSSStart && edgesFrom[i] == CSSStart) {
-      snprintf(str, 50, "-start:%0.f; ", edges[i]);
+    if (i == CSSStart && edges.from[i] == CSSStart) {
+      snprintf(str, 50, "-start:%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
       continue;
     }
 
-    if (i == CSSEnd && edgesFrom[i] == CSSEnd) {
-      snprintf(str, 50, "-end:%0.f; ", edges[i]);
+    if (i == CSSEnd && edges.from[i] == CSSEnd) {
+      snprintf(str, 50, "-end:%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
       continue;
     }
 
-    if (edgesFrom[i] == CSSLeft && !hasHorizontal) {
-      snprintf(str, 50, "-left:%0.f; ", edges[i]);
+    if (edges.from[i] == CSSLeft && !hasHorizontal) {
+      snprintf(str, 50, "-left:%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
     }
 
-    if (edgesFrom[i] == CSSRight && !hasHorizontal) {
-      snprintf(str, 50, "-right:%0.f; ", edges[i]);
+    if (edges.from[i] == CSSRight && !hasHorizontal) {
+      snprintf(str, 50, "-right:%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
     }
 
-    if (edgesFrom[i] == CSSTop && !hasVertical) {
-      snprintf(str, 50, "-top:%0.f; ", edges[i]);
+    if (edges.from[i] == CSSTop && !hasVertical) {
+      snprintf(str, 50, "-top:%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
     }
 
-    if (edgesFrom[i] == CSSBottom && !hasVertical) {
-      snprintf(str, 50, "-bottom:%0.f; ", edges[i]);
+    if (edges.from[i] == CSSBottom && !hasVertical) {
+      snprintf(str, 50, "-bottom:%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
     }
 
-    if (edgesFrom[i] == CSSHorizontal && !hasHorizontal) {
-      snprintf(str, 50, "-horizontal:%0.f; ", edges[i]);
+    if (edges.from[i] == CSSHorizontal && !hasHorizontal) {
+      snprintf(str, 50, "-horizontal:%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
       hasHorizontal = true;
     }
 
-    if (edgesFrom[i] == CSSVertical && !hasVertical) {
-      snprintf(str, 50, "-vertical:%0.f; ", edges[i]);
+    if (edges.from[i] == CSSVertical && !hasVertical) {
+      snprintf(str, 50, "-vertical:%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
       hasVertical = true;
     }
 
-    if (edgesFrom[i] == CSSAll && !hasCSSAll) {
-      snprintf(str, 50, ":%0.f; ", edges[i]);
+    if (edges.from[i] == CSSAll && !hasCSSAll) {
+      snprintf(str, 50, ":%0.f; ", edges.value[i]);
       styles += prefix;
       styles += str;
       hasCSSAll = true;
@@ -175,6 +279,49 @@ std::string edge2String(int type, CSSValue &edges, CSSFrom &edgesFrom) {
   return styles;
 }
 
+#define HP_HASH_OFFSET 14695981039346656037ULL
+#define HP_HASH_PRIME 1099511628211ULL
+
+// fnv-1a over bytes of value.
+template <typename T>
+static void hashValue(uint64_t &hash, const T &value) {
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&value);
+  for (size_t i = 0; i < sizeof(T); i++) {
+    hash = (hash ^ bytes[i]) * HP_HASH_PRIME;
+  }
+}
+
+static void hashEdges(uint64_t &hash, const HPEdges *edges) {
+  hashValue(hash, edges != nullptr);
+  if (edges != nullptr) {
+    hashValue(hash, edges->value);
+    hashValue(hash, edges->from);
+  }
+}
+
+uint64_t HPStyle::hash() {
+  uint64_t hash = HP_HASH_OFFSET;
+  // bit fields hashed one by one, the padding bits of struct are not read.
+  uint32_t enums[] = {nodeType,   direction,    flexDirection, justifyContent,
+                      alignContent, alignItems, alignSelf,     flexWrap,
+                      positionType, displayType, overflowType};
+  hashValue(hash, enums);
+  hashValue(hash, flexBasis);
+  hashValue(hash, flexGrow);
+  hashValue(hash, flexShrink);
+  hashValue(hash, flex);
+  hashEdges(hash, margin);
+  hashEdges(hash, padding);
+  hashEdges(hash, border);
+  hashEdges(hash, position);
+  hashValue(hash, dim);
+  hashValue(hash, minDim);
+  hashValue(hash, maxDim);
+  hashValue(hash, itemSpace);
+  hashValue(hash, lineSpace);
+  return hash;
+}
+
 std::string HPStyle::toString() {
   std::string styles;
   char str[60] = {0};
@@ -216,37 +363,37 @@ std::string HPStyle::toString() {
   }
 
   memset(str, 0, sizeof(str));
-  if (isDefined(position[CSSStart])) {
-    snprintf(str, 50, "position-start:%0.f; ", position[CSSStart]);
+  if (isDefined(getPosition(CSSStart))) {
+    snprintf(str, 50, "position-start:%0.f; ", getPosition(CSSStart));
     styles += str;
   }
 
   memset(str, 0, sizeof(str));
-  if (isDefined(position[CSSEnd])) {
-    snprintf(str, 50, "position-end:%0.f; ", position[CSSEnd]);
+  if (isDefined(getPosition(CSSEnd))) {
+    snprintf(str, 50, "position-end:%0.f; ", getPosition(CSSEnd));
     styles += str;
   }
 
   memset(str, 0, sizeof(str));
-  if (isDefined(position[CSSLeft])) {
-    snprintf(str, 50, "left:%0.f; ", position[CSSLeft]);
+  if (isDefined(getPosition(CSSLeft))) {
+    snprintf(str, 50, "left:%0.f; ", getPosition(CSSLeft));
     styles += str;
   }
 
   memset(str, 0, sizeof(str));
-  if (isDefined(position[CSSTop])) {
-    snprintf(str, 50, "top:%0.f; ", position[CSSTop]);
+  if (isDefined(getPosition(CSSTop))) {
+    snprintf(str, 50, "top:%0.f; ", getPosition(CSSTop));
     styles += str;
   }
   memset(str, 0, sizeof(str));
-  if (isDefined(position[CSSRight])) {
-    snprintf(str, 50, "right:%0.f; ", position[CSSRight]);
+  if (isDefined(getPosition(CSSRight))) {
+    snprintf(str, 50, "right:%0.f; ", getPosition(CSSRight));
     styles += str;
   }
 
   memset(str, 0, sizeof(str));
-  if (isDefined(position[CSSBottom])) {
-    snprintf(str, 50, "bottom:%0.f; ", position[CSSBottom]);
+  if (isDefined(getPosition(CSSBottom))) {
+    snprintf(str, 50, "bottom:%0.f; ", getPosition(CSSBottom));
     styles += str;
   }
 
@@ -286,9 +433,11 @@ std::string HPStyle::toString() {
     styles += str;
   }
 
-  styles += edge2String(0, margin, marginFrom);
-  styles += edge2String(1, padding, paddingFrom);
-  styles += edge2String(2, border, borderFrom);
+  styles += edge2String(0, *margin);
+  styles += edge2String(1, *padding);
+  if (border != nullptr) {
+    styles += edge2String(2, *border);
+  }
 
   memset(str, 0, sizeof(str));
   if (alignSelf != FlexAlignAuto /*&& alignSelf != FlexAlignStretch*/) {
@@ -327,7 +476,9 @@ std::string HPStyle::toString() {
  *[CSSTop,CSSLeft,CSSBottom,CSSRight] > [CSSHorizontal, CSSVertical] > CSSAll >
  *CSSNONE
  */
-bool setEdges(CSSDirection dir, float value, CSSValue &edges, CSSFrom &edgesFrom) {
+static bool setEdges(CSSDirection dir, float value, HPEdges &edgeGroup) {
+  float *edges = edgeGroup.value;
+  int8_t *edgesFrom = edgeGroup.from;
   bool hasSet = false;
   if (dir == CSSStart || dir == CSSEnd) {
     if (!FloatIsEqual(edges[dir], value)) {
@@ -390,46 +541,87 @@ bool setEdges(CSSDirection dir, float value, CSSValue &edges, CSSFrom &edgesFrom
   return hasSet;
 }
 
+// copy on write, an unset group starts from initialValue.
+static bool updateEdges(const HPEdges *&group, CSSDirection dir, float value, float initialValue) {
+  HPEdges edges;
+  if (group != nullptr) {
+    edges = *group;
+  } else {
+    initEdges(edges, initialValue);
+  }
+  bool hasSet = setEdges(dir, value, edges);
+  // directions may change without a value change.
+  if (group == nullptr || !HPEdgesEqual(edges, *group)) {
+    HPStyle::assignEdges(group, &edges);
+  }
+  return hasSet;
+}
+
 // Allow set value as auto (VALUE_AUTO), is NAN.
 // then margin is calculated in layout follow W3C regulars
 bool HPStyle::setMargin(CSSDirection dir, float value) {
-  return setEdges(dir, value, margin, marginFrom);
+  return updateEdges(margin, dir, value, 0);
 }
 
 bool HPStyle::setPadding(CSSDirection dir, float value) {
-  return setEdges(dir, value, padding, paddingFrom);
+  return updateEdges(padding, dir, value, 0);
 }
 
 bool HPStyle::setBorder(CSSDirection dir, float value) {
-  return setEdges(dir, value, border, borderFrom);
+  return updateEdges(border, dir, value, 0);
 }
 
 bool HPStyle::setPosition(CSSDirection dir, float value) {
-  if (dir > CSSEnd) {
+  if (dir < CSSLeft || dir > CSSEnd) {
     return false;
   }
 
-  if (!FloatIsEqual(position[dir], value)) {
-    position[dir] = value;
-    return true;
+  if (position == nullptr && isUndefined(value)) {
+    return false;
+  }
+  HPEdges edges;
+  if (position != nullptr) {
+    edges = *position;
+  } else {
+    initEdges(edges, VALUE_AUTO);
+  }
+  bool hasSet = !FloatIsEqual(edges.value[dir], value);
+  edges.value[dir] = value;
+  if (position == nullptr || hasSet) {
+    assignEdges(position, &edges);
   }
-  return false;
+  return hasSet;
+}
+
+float HPStyle::getPosition(CSSDirection dir) {
+  if (position == nullptr || dir < CSSLeft || dir > CSSEnd) {
+    return VALUE_AUTO;
+  }
+  return position->value[dir];
 }
 
 float HPStyle::getStartPosition(FlexDirection axis) {
-  if (isRowDirection(axis) && isDefined(position[CSSStart])) {
-    return position[CSSStart];
-  } else if (isDefined(position[axisStart[axis]])) {
-    return position[axisStart[axis]];
+  if (position == nullptr) {
+    return VALUE_AUTO;
+  }
+  const float *values = position->value;
+  if (isRowDirection(axis) && isDefined(values[CSSStart])) {
+    return values[CSSStart];
+  } else if (isDefined(values[axisStart[axis]])) {
+    return values[axisStart[axis]];
   }
   return VALUE_AUTO;
 }
 
 float HPStyle::getEndPosition(FlexDirection axis) {
-  if (isRowDirection(axis) && isDefined(position[CSSEnd])) {
-    return position[CSSEnd];
-  } else if (isDefined(position[axisEnd[axis]])) {
-    return position[axisEnd[axis]];
+  if (position == nullptr) {
+    return VALUE_AUTO;
+  }
+  const float *values = position->value;
+  if (isRowDirection(axis) && isDefined(values[CSSEnd])) {
+    return values[CSSEnd];
+  } else if (isDefined(values[axisEnd[axis]])) {
+    return values[axisEnd[axis]];
   }
   return VALUE_AUTO;
 }
@@ -456,61 +648,69 @@ bool HPStyle::isDimensionAuto(FlexDirection axis) {
 
 // axis must be get from resolveMainAxis or resolveCrossAxis in HPNode
 float HPStyle::getStartBorder(FlexDirection axis) {
-  if (isRowDirection(axis) && isDefined(border[CSSStart]) && borderFrom[CSSStart] != CSSNONE) {
-    return border[CSSStart];
+  if (border == nullptr) {
+    return 0.0f;
+  }
+  const HPEdges &edges = *border;
+  if (isRowDirection(axis) && isDefined(edges.value[CSSStart]) && edges.from[CSSStart] != CSSNONE) {
+    return edges.value[CSSStart];
   }
-  if (isDefined(border[axisStart[axis]])) {
-    return border[axisStart[axis]];
+  if (isDefined(edges.value[axisStart[axis]])) {
+    return edges.value[axisStart[axis]];
   }
   return 0.0f;
 }
 
 float HPStyle::getEndBorder(FlexDirection axis) {
-  if (isRowDirection(axis) && isDefined(border[CSSEnd]) && borderFrom[CSSEnd] != CSSNONE) {
-    return border[CSSEnd];
+  if (border == nullptr) {
+    return 0.0f;
+  }
+  const HPEdges &edges = *border;
+  if (isRowDirection(axis) && isDefined(edges.value[CSSEnd]) && edges.from[CSSEnd] != CSSNONE) {
+    return edges.value[CSSEnd];
   }
-  if (isDefined(border[axisEnd[axis]])) {
-    return border[axisEnd[axis]];
+  if (isDefined(edges.value[axisEnd[axis]])) {
+    return edges.value[axisEnd[axis]];
   }
   return 0.0f;
 }
 
 float HPStyle::getStartPadding(FlexDirection axis) {
-  if (isRowDirection(axis) && isDefined(padding[CSSStart]) && paddingFrom[CSSStart] != CSSNONE) {
-    return padding[CSSStart];
-  } else if (isDefined(padding[axisStart[axis]])) {
-    return padding[axisStart[axis]];
+  if (isRowDirection(axis) && isDefined(padding->value[CSSStart]) && padding->from[CSSStart] != CSSNONE) {
+    return padding->value[CSSStart];
+  } else if (isDefined(padding->value[axisStart[axis]])) {
+    return padding->value[axisStart[axis]];
   }
   return 0.0f;
 }
 
 float HPStyle::getEndPadding(FlexDirection axis) {
-  if (isRowDirection(axis) && isDefined(padding[CSSEnd]) && paddingFrom[CSSEnd] != CSSNONE) {
-    return padding[CSSEnd];
-  } else if (isDefined(padding[axisEnd[axis]])) {
-    return padding[axisEnd[axis]];
+  if (isRowDirection(axis) && isDefined(padding->value[CSSEnd]) && padding->from[CSSEnd] != CSSNONE) {
+    return padding->value[CSSEnd];
+  } else if (isDefined(padding->value[axisEnd[axis]])) {
+    return padding->value[axisEnd[axis]];
   }
   return 0.0f;
 }
 
 // auto margins are treated as zero
 float HPStyle::getStartMargin(FlexDirection axis) {
-  if (isRowDirection(axis) && isDefined(margin[CSSStart]) && marginFrom[CSSStart] != CSSNONE) {
-    return margin[CSSStart];
+  if (isRowDirection(axis) && isDefined(margin->value[CSSStart]) && margin->from[CSSStart] != CSSNONE) {
+    return margin->value[CSSStart];
   }
-  if (isDefined(margin[axisStart[axis]])) {
-    return margin[axisStart[axis]];
+  if (isDefined(margin->value[axisStart[axis]])) {
+    return margin->value[axisStart[axis]];
   }
   return 0.0f;
 }
 
 // auto margins are treated as zero
 float HPStyle::getEndMargin(FlexDirection axis) {
-  if (isRowDirection(axis) && isDefined(margin[CSSEnd]) && marginFrom[CSSEnd] != CSSNONE) {
-    return margin[CSSEnd];
+  if (isRowDirection(axis) && isDefined(margin->value[CSSEnd]) && margin->from[CSSEnd] != CSSNONE) {
+    return margin->value[CSSEnd];
   }
-  if (isDefined(margin[axisEnd[axis]])) {
-    return margin[axisEnd[axis]];
+  if (isDefined(margin->value[axisEnd[axis]])) {
+    return margin->value[axisEnd[axis]];
   }
   return 0.0f;
 }
@@ -520,17 +720,17 @@ float HPStyle::getMargin(FlexDirection axis) {
 }
 
 bool HPStyle::isAutoStartMargin(FlexDirection axis) {
-  if (isRowDirection(axis) && marginFrom[CSSStart] != CSSNONE) {
-    return isUndefined(margin[CSSStart]);
+  if (isRowDirection(axis) && margin->from[CSSStart] != CSSNONE) {
+    return isUndefined(margin->value[CSSStart]);
   }
-  return isUndefined(margin[axisStart[axis]]);
+  return isUndefined(margin->value[axisStart[axis]]);
 }
 
 bool HPStyle::isAutoEndMargin(FlexDirection axis) {
-  if (isRowDirection(axis) && marginFrom[CSSEnd] != CSSNONE) {
-    return isUndefined(margin[CSSEnd]);
+  if (isRowDirection(axis) && margin->from[CSSEnd] != CSSNONE) {
+    return isUndefined(margin->value[CSSEnd]);
   }
-  return isUndefined(margin[axisEnd[axis]]);
+  return isUndefined(margin->value[axisEnd[axis]]);
 }
 
 bool HPStyle::hasAutoMargin(FlexDirection axis) {
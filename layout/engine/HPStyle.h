@@ -17,17 +17,39 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <string>
 
 #include "Flex.h"
 #include "HPUtil.h"
 // CSSLeft <---> CSSEnd
 #define CSS_PROPS_COUNT (6)
+
+// values of an edge group and the direction each of them is set from,
+// CSSNONE if it's not set, see setEdges in HPStyle.cpp.
+typedef struct HPEdges {
+  float value[CSS_PROPS_COUNT];
+  int8_t from[CSS_PROPS_COUNT];
+} HPEdges;
+
+// enums are packed in bit fields. edge groups are interned and shared by
+// styles with equal values, see HPStyleStore. border and position are rarely
+// set, they are null and read as their initial values until first set.
 class HPStyle {
  public:
   HPStyle();
-  virtual ~HPStyle();
+  HPStyle(const HPStyle& other);
+  HPStyle& operator=(const HPStyle& other);
+  ~HPStyle();
+  // edge groups are compared by pointer.
+  bool operator==(const HPStyle& other) const;
+  bool operator!=(const HPStyle& other) const { return !(*this == other); }
+  // replace group with the interned one equal to edges, null to unset it.
+  static void assignEdges(const HPEdges*& group, const HPEdges* edges);
   std::string toString();
+  // hash of all style values, equal styles have equal hashes.
+  uint64_t hash();
   void setDirection(HPDirection direction_) { direction = direction_; }
 
   bool setMargin(CSSDirection dir, float value);
@@ -47,6 +69,7 @@ class HPStyle {
   bool hasAutoMargin(FlexDirection axis);
 
   bool setPosition(CSSDirection dir, float value);
+  float getPosition(CSSDirection dir);
   float getStartPosition(FlexDirection axis);
   float getEndPosition(FlexDirection axis);
   void setDim(FlexDirection axis, float value);
@@ -57,30 +80,30 @@ class HPStyle {
   float getFlexBasis();
 
  public:
-  NodeType nodeType;
-  HPDirection direction;
-  FlexDirection flexDirection;
-  FlexAlign justifyContent;
-  FlexAlign alignContent;
-  FlexAlign alignItems;
-  FlexAlign alignSelf;
-  FlexWrapMode flexWrap;
-  PositionType positionType;
-  DisplayType displayType;
-  OverflowType overflowType;
+  // widths hold all values of their enums.
+  NodeType nodeType : 1;
+  HPDirection direction : 2;
+  FlexDirection flexDirection : 2;
+  FlexAlign justifyContent : 4;
+  FlexAlign alignContent : 4;
+  FlexAlign alignItems : 4;
+  FlexAlign alignSelf : 4;
+  FlexWrapMode flexWrap : 2;
+  PositionType positionType : 1;
+  DisplayType displayType : 1;
+  OverflowType overflowType : 2;
 
   float flexBasis;
   float flexGrow;
   float flexShrink;
   float flex;
 
-  float margin[CSS_PROPS_COUNT];
-  CSSDirection marginFrom[CSS_PROPS_COUNT];
-  float padding[CSS_PROPS_COUNT];
-  CSSDirection paddingFrom[CSS_PROPS_COUNT];
-  float border[CSS_PROPS_COUNT];
-  CSSDirection borderFrom[CSS_PROPS_COUNT];
-  float position[CSS_PROPS_COUNT];
+  // interned, immutable
+  const HPEdges* margin;
+  const HPEdges* padding;
+  // null until set
+  const HPEdges* border;
+  const HPEdges* position;
 
   float dim[2];
   float minDim[2];
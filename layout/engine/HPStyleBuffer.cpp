@@ -0,0 +1,231 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPStyleBuffer.h"
+
+#include <string.h>
+
+#include <cmath>
+
+#include "Hippy.h"
+
+static bool IsEdgeProperty(uint16_t property) {
+  return property == HPStylePropertyPosition || property == HPStylePropertyMargin ||
+         property == HPStylePropertyMarginAuto || property == HPStylePropertyPadding ||
+         property == HPStylePropertyBorder;
+}
+
+static bool IsEnumValue(float value, int count) {
+  // false for nan too.
+  return value >= 0 && value < count && value == std::floor(value);
+}
+
+// values out of an enum would be truncated by style bit fields or index
+// arrays by axis, nan is only valid for lengths it means auto or undefined.
+static bool IsValidPropertyValue(uint16_t property, float value) {
+  switch (property) {
+    case HPStylePropertyDirection:
+      return IsEnumValue(value, DirectionRTL + 1);
+    case HPStylePropertyFlexDirection:
+      return IsEnumValue(value, FLexDirectionColumnReverse + 1);
+    case HPStylePropertyPositionType:
+      return IsEnumValue(value, PositionTypeAbsolute + 1);
+    case HPStylePropertyFlexWrap:
+      return IsEnumValue(value, FlexWrapReverse + 1);
+    case HPStylePropertyJustifyContent:
+    case HPStylePropertyAlignContent:
+    case HPStylePropertyAlignItems:
+    case HPStylePropertyAlignSelf:
+      return IsEnumValue(value, FlexAlignSpaceEvenly + 1);
+    case HPStylePropertyDisplay:
+      return IsEnumValue(value, DisplayTypeNone + 1);
+    case HPStylePropertyNodeType:
+      return IsEnumValue(value, NodeTypeText + 1);
+    case HPStylePropertyOverflow:
+      return IsEnumValue(value, OverflowScroll + 1);
+    case HPStylePropertyFlexGrow:
+    case HPStylePropertyFlexShrink:
+    case HPStylePropertyMargin:
+    case HPStylePropertyPadding:
+    case HPStylePropertyBorder:
+      return std::isfinite(value);
+    case HPStylePropertyMarginAuto:
+      return true;
+    default:
+      return !std::isinf(value);
+  }
+}
+
+// check the whole buffer before applying, so a bad buffer changes nothing.
+static bool ValidateStyleBuffer(uint32_t nodeCount, const char* data, uint32_t bufferSize) {
+  HPStyleBufferHeader header;
+  if (bufferSize < sizeof(header)) {
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.version != HP_STYLE_BUFFER_VERSION) {
+    return false;
+  }
+  uint32_t offset = sizeof(header);
+  for (uint32_t i = 0; i < header.nodeCount; i++) {
+    HPStyleBufferNode node;
+    if (bufferSize - offset < sizeof(node)) {
+      return false;
+    }
+    memcpy(&node, data + offset, sizeof(node));
+    offset += sizeof(node);
+    if (node.nodeIndex >= nodeCount ||
+        (bufferSize - offset) / sizeof(HPStyleBufferProperty) < node.propertyCount) {
+      return false;
+    }
+    for (uint32_t j = 0; j < node.propertyCount; j++) {
+      HPStyleBufferProperty property;
+      memcpy(&property, data + offset, sizeof(property));
+      offset += sizeof(property);
+      if (property.property >= HPStylePropertyCount) {
+        return false;
+      }
+      if (IsEdgeProperty(property.property) &&
+          (property.direction < CSSLeft || property.direction > CSSAll)) {
+        return false;
+      }
+      if (!IsValidPropertyValue(property.property, property.value)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void ApplyStyleProperty(HPNodeRef node, const HPStyleBufferProperty& property) {
+  float value = property.value;
+  CSSDirection dir = static_cast<CSSDirection>(property.direction);
+  int enumValue = static_cast<int>(value);
+  switch (property.property) {
+    case HPStylePropertyDirection:
+      HPNodeStyleSetDirection(node, static_cast<HPDirection>(enumValue));
+      break;
+    case HPStylePropertyWidth:
+      HPNodeStyleSetWidth(node, value);
+      break;
+    case HPStylePropertyHeight:
+      HPNodeStyleSetHeight(node, value);
+      break;
+    case HPStylePropertyFlex:
+      HPNodeStyleSetFlex(node, value);
+      break;
+    case HPStylePropertyFlexGrow:
+      HPNodeStyleSetFlexGrow(node, value);
+      break;
+    case HPStylePropertyFlexShrink:
+      HPNodeStyleSetFlexShrink(node, value);
+      break;
+    case HPStylePropertyFlexBasis:
+      HPNodeStyleSetFlexBasis(node, value);
+      break;
+    case HPStylePropertyFlexDirection:
+      HPNodeStyleSetFlexDirection(node, static_cast<FlexDirection>(enumValue));
+      break;
+    case HPStylePropertyPositionType:
+      HPNodeStyleSetPositionType(node, static_cast<PositionType>(enumValue));
+      break;
+    case HPStylePropertyPosition:
+      HPNodeStyleSetPosition(node, dir, value);
+      break;
+    case HPStylePropertyMargin:
+      HPNodeStyleSetMargin(node, dir, value);
+      break;
+    case HPStylePropertyMarginAuto:
+      HPNodeStyleSetMarginAuto(node, dir);
+      break;
+    case HPStylePropertyPadding:
+      HPNodeStyleSetPadding(node, dir, value);
+      break;
+    case HPStylePropertyBorder:
+      HPNodeStyleSetBorder(node, dir, value);
+      break;
+    case HPStylePropertyFlexWrap:
+      HPNodeStyleSetFlexWrap(node, static_cast<FlexWrapMode>(enumValue));
+      break;
+    case HPStylePropertyJustifyContent:
+      HPNodeStyleSetJustifyContent(node, static_cast<FlexAlign>(enumValue));
+      break;
+    case HPStylePropertyAlignContent:
+      HPNodeStyleSetAlignContent(node, static_cast<FlexAlign>(enumValue));
+      break;
+    case HPStylePropertyAlignItems:
+      HPNodeStyleSetAlignItems(node, static_cast<FlexAlign>(enumValue));
+      break;
+    case HPStylePropertyAlignSelf:
+      HPNodeStyleSetAlignSelf(node, static_cast<FlexAlign>(enumValue));
+      break;
+    case HPStylePropertyDisplay:
+      HPNodeStyleSetDisplay(node, static_cast<DisplayType>(enumValue));
+      break;
+    case HPStylePropertyMaxWidth:
+      HPNodeStyleSetMaxWidth(node, value);
+      break;
+    case HPStylePropertyMaxHeight:
+      HPNodeStyleSetMaxHeight(node, value);
+      break;
+    case HPStylePropertyMinWidth:
+      HPNodeStyleSetMinWidth(node, value);
+      break;
+    case HPStylePropertyMinHeight:
+      HPNodeStyleSetMinHeight(node, value);
+      break;
+    case HPStylePropertyNodeType:
+      HPNodeSetNodeType(node, static_cast<NodeType>(enumValue));
+      break;
+    case HPStylePropertyOverflow:
+      HPNodeStyleSetOverflow(node, static_cast<OverflowType>(enumValue));
+      break;
+    default:
+      break;
+  }
+}
+
+bool HPNodeApplyStyleBuffer(HPNodeRef* nodes,
+                            uint32_t nodeCount,
+                            const void* buffer,
+                            uint32_t bufferSize) {
+  if (nodes == nullptr || buffer == nullptr) {
+    return false;
+  }
+  const char* data = reinterpret_cast<const char*>(buffer);
+  if (!ValidateStyleBuffer(nodeCount, data, bufferSize)) {
+    return false;
+  }
+
+  HPStyleBufferHeader header;
+  memcpy(&header, data, sizeof(header));
+  uint32_t offset = sizeof(header);
+  for (uint32_t i = 0; i < header.nodeCount; i++) {
+    HPStyleBufferNode bufferNode;
+    memcpy(&bufferNode, data + offset, sizeof(bufferNode));
+    offset += sizeof(bufferNode);
+    HPNodeRef node = nodes[bufferNode.nodeIndex];
+    for (uint32_t j = 0; j < bufferNode.propertyCount; j++) {
+      HPStyleBufferProperty property;
+      memcpy(&property, data + offset, sizeof(property));
+      offset += sizeof(property);
+      // setters mark node dirty only when the value changed.
+      ApplyStyleProperty(node, property);
+    }
+  }
+  return true;
+}
@@ -0,0 +1,97 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module applies styles of many nodes packed in one buffer, so a
+ * platform bridge sets styles of a screen in one call instead of one call
+ * per property. properties are applied by HPNodeStyleSet* functions, only
+ * nodes whose style really changed are marked dirty.
+ *
+ * buffer layout, all fields in native byte order:
+ *   HPStyleBufferHeader
+ *   nodeCount times:
+ *     HPStyleBufferNode
+ *     propertyCount times HPStyleBufferProperty
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class HPNode;
+typedef HPNode* HPNodeRef;
+
+#define HP_STYLE_BUFFER_VERSION 1
+
+typedef enum {
+  HPStylePropertyDirection = 0,
+  HPStylePropertyWidth,
+  HPStylePropertyHeight,
+  HPStylePropertyFlex,
+  HPStylePropertyFlexGrow,
+  HPStylePropertyFlexShrink,
+  HPStylePropertyFlexBasis,
+  HPStylePropertyFlexDirection,
+  HPStylePropertyPositionType,
+  HPStylePropertyPosition,
+  HPStylePropertyMargin,
+  HPStylePropertyMarginAuto,
+  HPStylePropertyPadding,
+  HPStylePropertyBorder,
+  HPStylePropertyFlexWrap,
+  HPStylePropertyJustifyContent,
+  HPStylePropertyAlignContent,
+  HPStylePropertyAlignItems,
+  HPStylePropertyAlignSelf,
+  HPStylePropertyDisplay,
+  HPStylePropertyMaxWidth,
+  HPStylePropertyMaxHeight,
+  HPStylePropertyMinWidth,
+  HPStylePropertyMinHeight,
+  HPStylePropertyNodeType,
+  HPStylePropertyOverflow,
+  HPStylePropertyCount,
+} HPStyleProperty;
+
+typedef struct {
+  uint32_t version;
+  uint32_t nodeCount;
+} HPStyleBufferHeader;
+
+typedef struct {
+  // index in nodes array given to HPNodeApplyStyleBuffer
+  uint32_t nodeIndex;
+  uint32_t propertyCount;
+} HPStyleBufferNode;
+
+typedef struct {
+  // HPStyleProperty
+  uint16_t property;
+  // CSSDirection of edge properties, ignored by others
+  int16_t direction;
+  // enum values are stored as float too
+  float value;
+} HPStyleBufferProperty;
+
+// apply styles in buffer of bufferSize bytes to nodes.
+// return false and apply nothing if the buffer is malformed, of other
+// version, refers to a node out of nodes, or has a value out of its
+// property's range: enums out of their values, infinite numbers, and nan
+// for properties that can't be undefined, e.g. flex grow or padding.
+bool HPNodeApplyStyleBuffer(HPNodeRef* nodes,
+                            uint32_t nodeCount,
+                            const void* buffer,
+                            uint32_t bufferSize);
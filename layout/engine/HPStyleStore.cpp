@@ -0,0 +1,137 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPStyleStore.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include <type_traits>
+
+static uint64_t hashEdges(const HPEdges& edges) {
+  // fnv-1a, padding bytes of HPEdges are not read.
+  uint64_t hash = 14695981039346656037ULL;
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(edges.value);
+  for (size_t i = 0; i < sizeof(edges.value); i++) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+  bytes = reinterpret_cast<const unsigned char*>(edges.from);
+  for (size_t i = 0; i < sizeof(edges.from); i++) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+// values compared by bits, so undefined values are equal.
+bool HPEdgesEqual(const HPEdges& a, const HPEdges& b) {
+  return memcmp(a.value, b.value, sizeof(a.value)) == 0 &&
+         memcmp(a.from, b.from, sizeof(a.from)) == 0;
+}
+
+HPStyleStore* HPStyleStore::shared() {
+  // styles may be freed by static destructors, the store outlives them.
+  static HPStyleStore* store = new HPStyleStore();
+  return store;
+}
+
+HPStyleStore::HPStyleStore() {
+  for (int i = 0; i < CSS_PROPS_COUNT; i++) {
+    zero.edges.value[i] = 0;
+    zero.edges.from[i] = CSSNONE;
+  }
+  zero.hash = hashEdges(zero.edges);
+  zero.refs = 0;
+}
+
+HPStyleStore::Entry* HPStyleStore::entryOf(const HPEdges* edges) {
+  static_assert(std::is_standard_layout<Entry>::value, "offsetof needs a standard layout Entry");
+  const char* entry = reinterpret_cast<const char*>(edges) - offsetof(Entry, edges);
+  return reinterpret_cast<Entry*>(const_cast<char*>(entry));
+}
+
+HPStyleStore::Shard& HPStyleStore::shardOf(uint64_t hash) {
+  // low bits pick the bucket of the table, high bits pick the shard.
+  return shards[(hash >> 56) % HP_STYLE_STORE_SHARDS];
+}
+
+const HPEdges* HPStyleStore::intern(const HPEdges& edges) {
+  uint64_t hash = hashEdges(edges);
+  if (hash == zero.hash && HPEdgesEqual(zero.edges, edges)) {
+    return &zero.edges;
+  }
+  Shard& shard = shardOf(hash);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  std::pair<std::unordered_multimap<uint64_t, Entry*>::iterator,
+            std::unordered_multimap<uint64_t, Entry*>::iterator>
+      range = shard.entries.equal_range(hash);
+  for (std::unordered_multimap<uint64_t, Entry*>::iterator it = range.first;
+       it != range.second; ++it) {
+    if (HPEdgesEqual(it->second->edges, edges)) {
+      it->second->refs++;
+      return &it->second->edges;
+    }
+  }
+  Entry* entry = new Entry();
+  entry->edges = edges;
+  entry->hash = hash;
+  entry->refs = 1;
+  shard.entries.insert(std::make_pair(hash, entry));
+  return &entry->edges;
+}
+
+void HPStyleStore::retain(const HPEdges* edges) {
+  if (edges != nullptr && edges != &zero.edges) {
+    entryOf(edges)->refs++;
+  }
+}
+
+void HPStyleStore::release(const HPEdges* edges) {
+  if (edges == nullptr || edges == &zero.edges) {
+    return;
+  }
+  Entry* entry = entryOf(edges);
+  Shard& shard = shardOf(entry->hash);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (--entry->refs > 0) {
+    return;
+  }
+  std::pair<std::unordered_multimap<uint64_t, Entry*>::iterator,
+            std::unordered_multimap<uint64_t, Entry*>::iterator>
+      range = shard.entries.equal_range(entry->hash);
+  for (std::unordered_multimap<uint64_t, Entry*>::iterator it = range.first;
+       it != range.second; ++it) {
+    if (it->second == entry) {
+      shard.entries.erase(it);
+      break;
+    }
+  }
+  delete entry;
+}
+
+const HPEdges* HPStyleStore::zeroEdges() {
+  return &zero.edges;
+}
+
+uint32_t HPStyleStore::edgesCount() {
+  // and the zero group.
+  uint32_t count = 1;
+  for (int i = 0; i < HP_STYLE_STORE_SHARDS; i++) {
+    std::lock_guard<std::mutex> lock(shards[i].mutex);
+    count += shards[i].entries.size();
+  }
+  return count;
+}
@@ -0,0 +1,82 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module interns edge groups (margin, padding, border, position) of
+ * HPStyle. styles with equal values of a group share one immutable HPEdges,
+ * so a style holds four pointers instead of the values, copying a style only
+ * takes references, and equal groups compare by pointer. a style changes a
+ * group by interning a modified copy, see HPStyle::setMargin.
+ * it's thread safe, styles are copied and freed on layout threads too. the
+ * table is sharded by hash so those threads seldom wait for the same lock,
+ * and the initial group of all zeros is immortal and never locked.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#define HP_STYLE_STORE_SHARDS 16
+
+#include "HPStyle.h"
+
+class HPStyleStore {
+ public:
+  // the store of all styles, never freed.
+  static HPStyleStore* shared();
+  // interned group equal to edges, referenced for the caller.
+  const HPEdges* intern(const HPEdges& edges);
+  // take or drop a reference of an interned group, null is ignored.
+  void retain(const HPEdges* edges);
+  void release(const HPEdges* edges);
+  // group of all edges 0 and not set, initial margin, padding and border.
+  // it's not counted by references and never freed, retain and release
+  // ignore it.
+  const HPEdges* zeroEdges();
+  // count of interned groups.
+  uint32_t edgesCount();
+
+ protected:
+  HPStyleStore();
+
+ private:
+  typedef struct {
+    HPEdges edges;
+    uint64_t hash;
+    // changed under mutex of its shard except retain, which is called by an
+    // owner of a reference, so it never raises the count from 0.
+    std::atomic<uint32_t> refs;
+  } Entry;
+
+  typedef struct {
+    std::mutex mutex;
+    std::unordered_multimap<uint64_t, Entry*> entries;
+  } Shard;
+
+  // an interned group is the edges member of its entry.
+  static Entry* entryOf(const HPEdges* edges);
+  Shard& shardOf(uint64_t hash);
+
+  Shard shards[HP_STYLE_STORE_SHARDS];
+  Entry zero;
+};
+
+// same values and same directions they are set from.
+bool HPEdgesEqual(const HPEdges& a, const HPEdges& b);
@@ -0,0 +1,144 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPThreadPool.h"
+
+// pool and queue index of the worker running on current thread.
+static thread_local HPThreadPool* currentPool = nullptr;
+static thread_local int32_t currentIndex = -1;
+
+HPThreadPool::HPThreadPool(uint32_t threadCount) : queuedTasks(0), stopped(false), nextQueue(0) {
+  if (threadCount == 0) {
+    threadCount = 1;
+  }
+  for (uint32_t i = 0; i < threadCount; i++) {
+    queues.push_back(new WorkQueue());
+  }
+  for (uint32_t i = 0; i < threadCount; i++) {
+    workers.push_back(std::thread(&HPThreadPool::workerLoop, this, i));
+  }
+}
+
+HPThreadPool::~HPThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopped = true;
+  }
+  wakeUp.notify_all();
+  for (size_t i = 0; i < workers.size(); i++) {
+    workers[i].join();
+  }
+  for (size_t i = 0; i < queues.size(); i++) {
+    delete queues[i];
+  }
+  queues.clear();
+}
+
+uint32_t HPThreadPool::threadCount() {
+  return workers.size();
+}
+
+int32_t HPThreadPool::currentWorkerIndex() {
+  return currentPool == this ? currentIndex : -1;
+}
+
+void HPThreadPool::dispatch(HPTaskGroup* group, HPTaskFunc func, void* arg) {
+  Task task = {func, arg, group};
+  group->unfinished++;
+  // a worker keeps its nested tasks in its own queue, other threads spread
+  // tasks over workers' queues. idle workers steal the rest.
+  int32_t index = currentWorkerIndex();
+  WorkQueue* queue = queues[index >= 0 ? index : nextQueue++ % queues.size()];
+  {
+    // count before push, so a task taken right away never drops it below zero.
+    // lock to not lose the wake up of a worker going to sleep.
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    queuedTasks++;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->tasks.push_back(task);
+  }
+  wakeUp.notify_one();
+}
+
+void HPThreadPool::wait(HPTaskGroup* group) {
+  Task task;
+  // a worker takes its own queue first, where its nested tasks are.
+  int32_t index = currentWorkerIndex();
+  while (group->unfinished > 0 &&
+         ((index >= 0 && popTask(index, task)) || stealTask(index + 1, task))) {
+    runTask(task);
+  }
+  // remaining tasks of group are running in other threads, tasks they
+  // dispatch are run by themselves when no one else takes them.
+  // return with the lock taken, the last task may be notifying the group.
+  std::unique_lock<std::mutex> lock(sleepMutex);
+  group->finished.wait(lock, [group] { return group->unfinished == 0; });
+}
+
+bool HPThreadPool::popTask(uint32_t queueIndex, Task& task) {
+  WorkQueue* queue = queues[queueIndex];
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  if (queue->tasks.empty()) {
+    return false;
+  }
+  task = queue->tasks.back();
+  queue->tasks.pop_back();
+  queuedTasks--;
+  return true;
+}
+
+bool HPThreadPool::stealTask(uint32_t startIndex, Task& task) {
+  for (size_t i = 0; i < queues.size(); i++) {
+    WorkQueue* queue = queues[(startIndex + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->tasks.empty()) {
+      task = queue->tasks.front();
+      queue->tasks.pop_front();
+      queuedTasks--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void HPThreadPool::runTask(Task& task) {
+  task.func(task.arg);
+  // decrease under lock, group may be released once its waiter sees zero.
+  std::lock_guard<std::mutex> lock(sleepMutex);
+  if (--task.group->unfinished == 0) {
+    task.group->finished.notify_all();
+  }
+}
+
+void HPThreadPool::workerLoop(uint32_t queueIndex) {
+  currentPool = this;
+  currentIndex = queueIndex;
+  Task task;
+  while (true) {
+    if (popTask(queueIndex, task) || stealTask(queueIndex + 1, task)) {
+      runTask(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    wakeUp.wait(lock, [this] { return stopped || queuedTasks > 0; });
+    if (stopped) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,84 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module is a small work-stealing thread pool for parallel layout.
+ * every worker owns a task queue, it takes tasks from the back of its own
+ * queue and steals from the front of others' when its own is empty.
+ * the thread waiting for a task group runs queued tasks too, so a task can
+ * dispatch and wait for its own group without blocking a worker.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+typedef void (*HPTaskFunc)(void* arg);
+
+// tasks dispatched together and waited together.
+class HPTaskGroup {
+ public:
+  HPTaskGroup() : unfinished(0) {}
+  std::atomic<uint32_t> unfinished;
+  // notified with pool's sleepMutex held when unfinished drops to zero.
+  std::condition_variable finished;
+};
+
+class HPThreadPool {
+ public:
+  explicit HPThreadPool(uint32_t threadCount);
+  virtual ~HPThreadPool();
+  void dispatch(HPTaskGroup* group, HPTaskFunc func, void* arg);
+  // return after all tasks of group are done, run queued tasks meanwhile and
+  // sleep when the rest are running in other threads.
+  void wait(HPTaskGroup* group);
+  uint32_t threadCount();
+  // index of worker running current thread, -1 for threads not in pool.
+  int32_t currentWorkerIndex();
+
+ protected:
+  struct Task {
+    HPTaskFunc func;
+    void* arg;
+    HPTaskGroup* group;
+  };
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool popTask(uint32_t queueIndex, Task& task);
+  bool stealTask(uint32_t startIndex, Task& task);
+  void runTask(Task& task);
+  void workerLoop(uint32_t queueIndex);
+
+ private:
+  std::vector<std::thread> workers;
+  std::vector<WorkQueue*> queues;
+  // queued tasks not taken yet, workers sleep when it's zero.
+  std::atomic<uint32_t> queuedTasks;
+  std::mutex sleepMutex;
+  std::condition_variable wakeUp;
+  bool stopped;
+  std::atomic<uint32_t> nextQueue;
+};
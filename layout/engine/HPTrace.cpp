@@ -0,0 +1,260 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HPTrace.h"
+
+#include <stdio.h>
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+static uint64_t steadyNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static uint32_t currentThreadId() {
+  return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+}
+
+// ids of passes of all tracers, an id is never reused, so the visit map
+// cached by a thread is never mistaken for one of another pass or tracer.
+static std::atomic<uint64_t> nextPassId(1);
+
+static uint64_t newPassId() {
+  return nextPassId.fetch_add(1, std::memory_order_relaxed);
+}
+
+// visit map of the pass the current thread counted in last.
+static thread_local uint64_t cachedPassId = 0;
+static thread_local std::unordered_map<HPNodeRef, uint32_t>* cachedVisits = nullptr;
+
+HPTracer::HPTracer(uint32_t capacity) : passId(newPassId()) {
+  origin = steadyNanos();
+  events.resize(capacity > 0 ? capacity : 1);
+  lastPassStats = HPTracePassStats();
+}
+
+void HPTracer::setEnabled(bool enabled) {
+  this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void HPTracer::setCapacity(uint32_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex);
+  events.assign(capacity > 0 ? capacity : 1, HPTraceEvent());
+  head = 0;
+  eventCount = 0;
+}
+
+void HPTracer::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  head = 0;
+  eventCount = 0;
+  lastPassVisits.clear();
+  lastPassStats = HPTracePassStats();
+}
+
+uint64_t HPTracer::now() {
+  return steadyNanos() - origin;
+}
+
+void HPTracer::beginPass() {
+  layoutCount = 0;
+  layoutCacheHits = 0;
+  measureCount = 0;
+  measureCacheHits = 0;
+  measureCalls = 0;
+  measureNanos = 0;
+  std::lock_guard<std::mutex> lock(mutex);
+  threadVisits.clear();
+  passId = newPassId();
+}
+
+void HPTracer::endPass(uint64_t start) {
+  HPTraceEvent event;
+  event.name = "layout";
+  event.type = HPTraceEventPass;
+  event.threadId = currentThreadId();
+  event.start = start;
+  event.duration = now() - start;
+  event.stats.layoutCount = layoutCount;
+  event.stats.layoutCacheHits = layoutCacheHits;
+  event.stats.measureCount = measureCount;
+  event.stats.measureCacheHits = measureCacheHits;
+  event.stats.measureCalls = measureCalls;
+  event.stats.measureNanos = measureNanos;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  // layout of the pass is done, no thread counts in the maps any more.
+  passId = newPassId();
+  lastPassVisits.clear();
+  for (size_t i = 0; i < threadVisits.size(); i++) {
+    if (lastPassVisits.empty()) {
+      lastPassVisits.swap(*threadVisits[i]);
+      continue;
+    }
+    for (std::unordered_map<HPNodeRef, uint32_t>::iterator it = threadVisits[i]->begin();
+         it != threadVisits[i]->end(); ++it) {
+      lastPassVisits[it->first] += it->second;
+    }
+  }
+  threadVisits.clear();
+  event.stats.nodeCount = lastPassVisits.size();
+  event.stats.maxNodeVisits = 0;
+  for (std::unordered_map<HPNodeRef, uint32_t>::iterator it = lastPassVisits.begin();
+       it != lastPassVisits.end(); ++it) {
+    if (it->second > event.stats.maxNodeVisits) {
+      event.stats.maxNodeVisits = it->second;
+    }
+  }
+  lastPassStats = event.stats;
+  append(event);
+}
+
+void HPTracer::countLayout(HPNodeRef node, FlexLayoutAction layoutAction) {
+  if (layoutAction == LayoutActionLayout) {
+    layoutCount.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    measureCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  // the lock is taken once per thread and pass, not for every visit.
+  uint64_t pass = passId.load(std::memory_order_relaxed);
+  if (cachedPassId != pass) {
+    std::lock_guard<std::mutex> lock(mutex);
+    threadVisits.emplace_back(new std::unordered_map<HPNodeRef, uint32_t>());
+    cachedVisits = threadVisits.back().get();
+    cachedPassId = pass;
+  }
+  (*cachedVisits)[node]++;
+}
+
+void HPTracer::countCacheHit(FlexLayoutAction layoutAction) {
+  if (layoutAction == LayoutActionLayout) {
+    layoutCacheHits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    measureCacheHits.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void HPTracer::addMeasure(const char* name, uint64_t start, uint32_t measureCount) {
+  uint64_t duration = now() - start;
+  measureCalls.fetch_add(measureCount, std::memory_order_relaxed);
+  measureNanos.fetch_add(duration, std::memory_order_relaxed);
+  HPTraceEvent event = HPTraceEvent();
+  event.name = name;
+  event.type = HPTraceEventMeasure;
+  event.threadId = currentThreadId();
+  event.start = start;
+  event.duration = duration;
+  event.stats.measureCalls = measureCount;
+  event.stats.measureNanos = duration;
+  std::lock_guard<std::mutex> lock(mutex);
+  append(event);
+}
+
+void HPTracer::addEvent(const char* name, HPTraceEventType type, uint64_t start) {
+  HPTraceEvent event = HPTraceEvent();
+  event.name = name;
+  event.type = type;
+  event.threadId = currentThreadId();
+  event.start = start;
+  event.duration = now() - start;
+  std::lock_guard<std::mutex> lock(mutex);
+  append(event);
+}
+
+// called with mutex held.
+void HPTracer::append(const HPTraceEvent& event) {
+  events[head] = event;
+  head = (head + 1) % events.size();
+  if (eventCount < events.size()) {
+    eventCount++;
+  }
+}
+
+HPTracePassStats HPTracer::getLastPassStats() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return lastPassStats;
+}
+
+uint32_t HPTracer::getNodeVisits(HPNodeRef node) {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unordered_map<HPNodeRef, uint32_t>::iterator it = lastPassVisits.find(node);
+  return it != lastPassVisits.end() ? it->second : 0;
+}
+
+std::vector<HPTraceEvent> HPTracer::getEvents() {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<HPTraceEvent> result;
+  result.reserve(eventCount);
+  uint32_t first = (head + events.size() - eventCount) % events.size();
+  for (uint32_t i = 0; i < eventCount; i++) {
+    result.push_back(events[(first + i) % events.size()]);
+  }
+  return result;
+}
+
+// timestamps of chrome trace events are microseconds.
+std::string HPTracer::toChromeTraceJson() {
+  std::vector<HPTraceEvent> recorded = getEvents();
+  std::string json = "{\"traceEvents\":[";
+  char buffer[512];
+  for (size_t i = 0; i < recorded.size(); i++) {
+    const HPTraceEvent& event = recorded[i];
+    snprintf(buffer, sizeof(buffer),
+             "%s{\"name\":\"%s\",\"cat\":\"hippy.layout\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,"
+             "\"ts\":%.3f,\"dur\":%.3f",
+             i > 0 ? "," : "", event.name, event.threadId, event.start / 1000.0,
+             event.duration / 1000.0);
+    json += buffer;
+    const HPTracePassStats& stats = event.stats;
+    if (event.type == HPTraceEventPass) {
+      uint32_t lookups = stats.layoutCount + stats.measureCount;
+      uint32_t hits = stats.layoutCacheHits + stats.measureCacheHits;
+      snprintf(buffer, sizeof(buffer),
+               ",\"args\":{\"layout_count\":%u,\"layout_cache_hits\":%u,\"measure_count\":%u,"
+               "\"measure_cache_hits\":%u,\"cache_hit_rate\":%.3f,\"measure_calls\":%u,"
+               "\"measure_ms\":%.3f,\"node_count\":%u,\"max_node_visits\":%u}",
+               stats.layoutCount, stats.layoutCacheHits, stats.measureCount,
+               stats.measureCacheHits, lookups > 0 ? static_cast<double>(hits) / lookups : 0.0,
+               stats.measureCalls, stats.measureNanos / 1e6, stats.nodeCount,
+               stats.maxNodeVisits);
+      json += buffer;
+    } else if (event.type == HPTraceEventMeasure) {
+      snprintf(buffer, sizeof(buffer), ",\"args\":{\"measure_calls\":%u}", stats.measureCalls);
+      json += buffer;
+    }
+    json += "}";
+  }
+  json += "],\"displayTimeUnit\":\"ms\"}";
+  return json;
+}
+
+HPTraceScope::HPTraceScope(HPTracer* tracer, const char* name)
+    : tracer(tracer != nullptr && tracer->isEnabled() ? tracer : nullptr), name(name), start(0) {
+  if (this->tracer != nullptr) {
+    start = this->tracer->now();
+  }
+}
+
+HPTraceScope::~HPTraceScope() {
+  if (tracer != nullptr) {
+    tracer->addEvent(name, HPTraceEventScope, start);
+  }
+}
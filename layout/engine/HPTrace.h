@@ -0,0 +1,141 @@
+/* Tencent is pleased to support the open source community by making Hippy
+ * available. Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights
+ * reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* this module traces layout passes at runtime. it's compiled in all builds
+ * and off by default, so release builds can be profiled in the field.
+ * events of a pass are kept in a fixed size ring buffer, the oldest ones are
+ * overwritten, and exported as chrome trace event json which is opened by
+ * chrome://tracing or perfetto. counters are updated from parallel layout
+ * workers too, events are appended under a lock only when tracing is on.
+ * node visits are counted in a map of each thread, which takes the lock once
+ * per pass, and the maps are merged when the pass ends.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Flex.h"
+
+class HPNode;
+typedef HPNode* HPNodeRef;
+
+#define HP_TRACE_DEFAULT_CAPACITY 4096
+
+typedef enum {
+  // a layout pass, with HPTracePassStats
+  HPTraceEventPass,
+  // a measure function call, or a batch measure call for many nodes
+  HPTraceEventMeasure,
+  // a span given by HPTraceScope
+  HPTraceEventScope,
+} HPTraceEventType;
+
+typedef struct {
+  // layoutImpl calls to lay out or measure a node, and the ones hit cache.
+  uint32_t layoutCount;
+  uint32_t layoutCacheHits;
+  uint32_t measureCount;
+  uint32_t measureCacheHits;
+  // measure function calls, count of nodes for batch measure, and their time.
+  uint32_t measureCalls;
+  uint64_t measureNanos;
+  // nodes visited by layoutImpl and the visits of the most visited one.
+  uint32_t nodeCount;
+  uint32_t maxNodeVisits;
+} HPTracePassStats;
+
+typedef struct {
+  // static string
+  const char* name;
+  HPTraceEventType type;
+  uint32_t threadId;
+  // nanoseconds since the tracer is created
+  uint64_t start;
+  uint64_t duration;
+  // valid for HPTraceEventPass
+  HPTracePassStats stats;
+} HPTraceEvent;
+
+class HPTracer {
+ public:
+  explicit HPTracer(uint32_t capacity = HP_TRACE_DEFAULT_CAPACITY);
+  void setEnabled(bool enabled);
+  bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+  // drop recorded events and keep at most capacity of them afterwards.
+  void setCapacity(uint32_t capacity);
+  void clear();
+  uint64_t now();
+
+  void beginPass();
+  void endPass(uint64_t start);
+  void countLayout(HPNodeRef node, FlexLayoutAction layoutAction);
+  void countCacheHit(FlexLayoutAction layoutAction);
+  // measureCount is 1 for a measure function call, count of nodes for batch.
+  void addMeasure(const char* name, uint64_t start, uint32_t measureCount);
+  void addEvent(const char* name, HPTraceEventType type, uint64_t start);
+
+  HPTracePassStats getLastPassStats();
+  // layoutImpl calls of node in last pass.
+  uint32_t getNodeVisits(HPNodeRef node);
+  // recorded events from the oldest one.
+  std::vector<HPTraceEvent> getEvents();
+  std::string toChromeTraceJson();
+
+ protected:
+  void append(const HPTraceEvent& event);
+
+ private:
+  std::atomic<bool> enabled{false};
+  uint64_t origin;
+  std::mutex mutex;
+  std::vector<HPTraceEvent> events;
+  // next slot to write, and count of valid events
+  uint32_t head = 0;
+  uint32_t eventCount = 0;
+  std::atomic<uint32_t> layoutCount{0};
+  std::atomic<uint32_t> layoutCacheHits{0};
+  std::atomic<uint32_t> measureCount{0};
+  std::atomic<uint32_t> measureCacheHits{0};
+  std::atomic<uint32_t> measureCalls{0};
+  std::atomic<uint64_t> measureNanos{0};
+  // changed by beginPass and endPass, tells a thread its visit map is stale.
+  std::atomic<uint64_t> passId;
+  // node visits of the pass counted by each thread, merged by endPass.
+  std::vector<std::unique_ptr<std::unordered_map<HPNodeRef, uint32_t>>> threadVisits;
+  std::unordered_map<HPNodeRef, uint32_t> lastPassVisits;
+  HPTracePassStats lastPassStats;
+};
+
+// adds a HPTraceEventScope event of its lifetime if tracer is enabled.
+class HPTraceScope {
+ public:
+  HPTraceScope(HPTracer* tracer, const char* name);
+  ~HPTraceScope();
+
+ private:
+  HPTracer* tracer;
+  const char* name;
+  uint64_t start;
+};
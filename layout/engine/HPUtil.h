@@ -29,7 +29,6 @@
 #include "Flex.h"
 
 // #define __DEBUG__
-// #define LAYOUT_TIME_ANALYZE
 #define ASSERT(e) (assert(e))
 #define nullptr (NULL)
 #define VALUE_AUTO (NAN)
@@ -41,6 +40,16 @@
 #define PixelRoundInt(value) (roundf(value))
 #define NanAsINF(n) (std::isnan(n) ? INFINITY : n)
 
+// platform hooks of the engine shared by android and ios, decided at compile
+// time. android rounds layout results to pixel grid in java, ios in engine.
+#ifndef HP_ROUND_LAYOUT_RESULT
+#ifdef ANDROID
+#define HP_ROUND_LAYOUT_RESULT 0
+#else
+#define HP_ROUND_LAYOUT_RESULT 1
+#endif
+#endif
+
 typedef enum {
   LogLevelInfo,
   LogLevelVerbose,
@@ -17,13 +17,21 @@
 
 #include "Hippy.h"
 
+#include <new>
+
 #include "HPUtil.h"
 
 HPNodeRef HPNodeNew() {
-  return new HPNode();
+  return HPNodeNewWithConfig(HPConfigGetDefault());
 }
 
 HPNodeRef HPNodeNewWithConfig(HPConfigRef config) {
+  if (config != nullptr && config->UseNodePool()) {
+    HPNodePool* pool = config->GetNodePool();
+    HPNodeRef node = new (pool->allocate()) HPNode(config);
+    node->nodePool = pool;
+    return node;
+  }
   return new HPNode(config);
 }
 
@@ -31,7 +39,26 @@ void HPNodeFree(HPNodeRef node) {
   if (node == nullptr)
     return;
   // free self
-  delete node;
+  HPNodePool* pool = node->nodePool;
+  if (pool != nullptr) {
+    node->~HPNode();
+    pool->deallocate(node);
+  } else {
+    delete node;
+  }
+}
+
+// free all descendants of node, children are detached from their parent
+// in one time, avoid to remove them from children list one by one.
+static void HPNodeFreeDescendants(HPNodeRef node) {
+  std::vector<HPNodeRef>& items = node->children;
+  for (size_t i = 0; i < items.size(); i++) {
+    HPNodeRef item = items[i];
+    item->setParent(nullptr);
+    HPNodeFreeDescendants(item);
+    HPNodeFree(item);
+  }
+  items.clear();
 }
 
 void HPNodeFreeRecursive(HPNodeRef node) {
@@ -39,11 +66,7 @@ void HPNodeFreeRecursive(HPNodeRef node) {
     return;
   }
 
-  while (node->childCount() > 0) {
-    HPNodeRef child = node->getChild(0);
-    HPNodeFreeRecursive(child);
-  }
-
+  HPNodeFreeDescendants(node);
   HPNodeFree(node);
 }
 
@@ -80,6 +103,49 @@ bool HPNodeSetMeasureFunc(HPNodeRef node, HPMeasureFunc _measure) {
   return node->setMeasureFunc(_measure);
 }
 
+bool HPNodeSetStyle(HPNodeRef node, const HPStyle& style) {
+  if (node == nullptr || node->style == style)
+    return false;
+
+  node->setStyle(style);
+  node->markAsDirty();
+  return true;
+}
+
+void HPNodeSetMeasureContentHash(HPNodeRef node, uint64_t contentHash) {
+  if (node == nullptr || node->measureContentHash == contentHash)
+    return;
+
+  node->measureContentHash = contentHash;
+  node->markAsDirty();
+}
+
+void HPNodeSetViewport(HPNodeRef node,
+                       float offset,
+                       float size,
+                       float margin,
+                       float estimatedItemSize) {
+  if (node == nullptr)
+    return;
+
+  HPViewport viewport = {offset, size, margin, estimatedItemSize};
+  node->setViewport(viewport);
+}
+
+void HPNodeClearViewport(HPNodeRef node) {
+  if (node == nullptr)
+    return;
+
+  node->clearViewport();
+}
+
+bool HPNodeIsOutOfViewport(HPNodeRef node) {
+  if (node == nullptr)
+    return false;
+
+  return node->outOfViewport;
+}
+
 void HPNodeStyleSetFlex(HPNodeRef node, float flex) {
   if (node == nullptr || FloatIsEqual(node->style.flex, flex))
     return;
@@ -137,7 +203,7 @@ void HPNodeStyleSetPositionType(HPNodeRef node, PositionType positionType) {
 }
 
 void HPNodeStyleSetPosition(HPNodeRef node, CSSDirection dir, float value) {
-  if (node == nullptr || FloatIsEqual(node->style.position[dir], value))
+  if (node == nullptr || FloatIsEqual(node->style.getPosition(dir), value))
     return;
   if (node->style.setPosition(dir, value)) {
     node->markAsDirty();
@@ -267,6 +333,102 @@ bool HPNodeLayoutGetHadOverflow(HPNodeRef node) {
   return node->result.hadOverflow;
 }
 
+float HPNodeStyleGetMaxWidth(HPNodeRef node) {
+  if (node == nullptr)
+    return 0;
+  return node->style.maxDim[DimWidth];
+}
+
+float HPNodeStyleGetMaxHeight(HPNodeRef node) {
+  if (node == nullptr)
+    return 0;
+  return node->style.maxDim[DimHeight];
+}
+
+float HPNodeStyleGetMinWidth(HPNodeRef node) {
+  if (node == nullptr)
+    return 0;
+  return node->style.minDim[DimWidth];
+}
+
+float HPNodeStyleGetMinHeight(HPNodeRef node) {
+  if (node == nullptr)
+    return 0;
+  return node->style.minDim[DimHeight];
+}
+
+float HPNodeStyleGetFlexGrow(HPNodeRef node) {
+  if (node == nullptr)
+    return 0;
+  return node->style.flexGrow;
+}
+
+float HPNodeStyleGetFlexShrink(HPNodeRef node) {
+  if (node == nullptr)
+    return 0;
+  return node->style.flexShrink;
+}
+
+float HPNodeStyleGetFlexBasis(HPNodeRef node) {
+  if (node == nullptr)
+    return 0;
+  return node->style.getFlexBasis();
+}
+
+float HPNodeStyleGetPosition(HPNodeRef node, CSSDirection dir) {
+  if (node == nullptr || dir < CSSLeft || dir > CSSAll)
+    return 0;
+  return node->style.getPosition(dir);
+}
+
+DisplayType HPNodeStyleGetDisplay(HPNodeRef node) {
+  if (node == nullptr)
+    return DisplayTypeFlex;
+  return node->style.displayType;
+}
+
+FlexDirection HPNodeStyleGetFlexDirection(HPNodeRef node) {
+  if (node == nullptr)
+    return FLexDirectionColumn;
+  return node->style.flexDirection;
+}
+
+FlexAlign HPNodeStyleGetJustifyContent(HPNodeRef node) {
+  if (node == nullptr)
+    return FlexAlignStart;
+  return node->style.justifyContent;
+}
+
+FlexAlign HPNodeStyleGetAlignSelf(HPNodeRef node) {
+  if (node == nullptr)
+    return FlexAlignAuto;
+  return node->style.alignSelf;
+}
+
+FlexAlign HPNodeStyleGetAlignItems(HPNodeRef node) {
+  if (node == nullptr)
+    return FlexAlignStretch;
+  return node->style.alignItems;
+}
+
+PositionType HPNodeStyleGetPositionType(HPNodeRef node) {
+  if (node == nullptr)
+    return PositionTypeRelative;
+  return node->style.positionType;
+}
+
+FlexWrapMode HPNodeStyleGetFlexWrap(HPNodeRef node) {
+  if (node == nullptr)
+    return FlexNoWrap;
+  return node->style.flexWrap;
+}
+
+OverflowType HPNodeStyleGetOverflow(HPNodeRef node) {
+  if (node == nullptr)
+    return OverflowVisible;
+  return node->style.overflowType;
+}
+
 void HPNodeSetConfig(HPNodeRef node, HPConfigRef config) {
   node->SetConfig(config);
 }
@@ -342,6 +504,42 @@ bool HPNodeRemoveChild(HPNodeRef node, HPNodeRef child) {
   return node->removeChild(child);
 }
 
+bool HPNodeApplyChildMoves(HPNodeRef node, const HPChildMove* moves, uint32_t count) {
+  if (node == nullptr || (moves == nullptr && count > 0))
+    return false;
+  return node->applyChildMoves(moves, count);
+}
+
+uint32_t HPNodeChildCount(HPNodeRef node) {
+  if (node == nullptr)
+    return 0;
+  return node->childCount();
+}
+
+HPNodeRef HPNodeGetChild(HPNodeRef node, uint32_t index) {
+  if (node == nullptr)
+    return nullptr;
+  return node->getChild(index);
+}
+
+HPNodeRef HPNodeGetParent(HPNodeRef node) {
+  if (node == nullptr)
+    return nullptr;
+  return node->getParent();
+}
+
+void HPNodeSetContext(HPNodeRef node, void* context) {
+  if (node == nullptr)
+    return;
+  node->setContext(context);
+}
+
+void* HPNodeGetContext(HPNodeRef node) {
+  if (node == nullptr)
+    return nullptr;
+  return node->getContext();
+}
+
 bool HPNodeHasNewLayout(HPNodeRef node) {
   if (node == nullptr)
     return false;
@@ -363,7 +561,7 @@ void HPNodeMarkDirty(HPNodeRef node) {
 bool HPNodeIsDirty(HPNodeRef node) {
   if (node == nullptr)
     return false;
-  return node->isDirty;
+  return node->isDirty || node->hasDirtyDescendant;
 }
 
 void HPNodeDoLayout(HPNodeRef node,
@@ -377,6 +575,19 @@ void HPNodeDoLayout(HPNodeRef node,
   node->layout(parentWidth, parentHeight, node->GetConfig(), direction, layoutContext);
 }
 
+void HPNodeDoLayoutWithBatchMeasure(HPNodeRef node,
+                                    float parentWidth,
+                                    float parentHeight,
+                                    HPBatchMeasureFunc batchMeasureFunc,
+                                    HPDirection direction,
+                                    void* layoutContext) {
+  if (node == nullptr)
+    return;
+
+  node->layout(parentWidth, parentHeight, node->GetConfig(), direction, layoutContext,
+               batchMeasureFunc);
+}
+
 void HPNodePrint(HPNodeRef node) {
   if (node == nullptr)
     return;
@@ -389,3 +600,35 @@ bool HPNodeReset(HPNodeRef node) {
 
   return node->reset();
 }
+
+HPMeasureCacheStats HPNodeGetMeasureCacheStats(HPNodeRef node) {
+  if (node == nullptr) {
+    HPMeasureCacheStats stats = {0, 0, 0};
+    return stats;
+  }
+  return node->layoutCache.getStats();
+}
+
+HPMeasureCacheStats HPNodeGetTreeMeasureCacheStats(HPNodeRef node) {
+  HPMeasureCacheStats stats = HPNodeGetMeasureCacheStats(node);
+  if (node == nullptr)
+    return stats;
+
+  for (uint32_t i = 0; i < node->childCount(); i++) {
+    HPMeasureCacheStats childStats = HPNodeGetTreeMeasureCacheStats(node->getChild(i));
+    stats.hits += childStats.hits;
+    stats.misses += childStats.misses;
+    stats.evictions += childStats.evictions;
+  }
+  return stats;
+}
+
+void HPNodeResetMeasureCacheStats(HPNodeRef node) {
+  if (node == nullptr)
+    return;
+
+  node->layoutCache.resetStats();
+  for (uint32_t i = 0; i < node->childCount(); i++) {
+    HPNodeResetMeasureCacheStats(node->getChild(i));
+  }
+}
@@ -23,6 +23,12 @@
 
 #include "HPNode.h"
 #include "HPConfig.h"
+#include "HPBatchMeasure.h"
+#include "HPLayoutExport.h"
+#include "HPStyleBuffer.h"
+#include "HPLayoutPipeline.h"
+#include "HPLayoutSnapshot.h"
+#include "HPTrace.h"
 
 HPNodeRef HPNodeNew();
 HPNodeRef HPNodeNewWithConfig(HPConfigRef config);
@@ -33,6 +39,23 @@ void HPNodeStyleSetDirection(HPNodeRef node, HPDirection direction);
 void HPNodeStyleSetWidth(HPNodeRef node, float width);
 void HPNodeStyleSetHeight(HPNodeRef node, float height);
 bool HPNodeSetMeasureFunc(HPNodeRef node, HPMeasureFunc _measure);
+// replace the whole style, node is dirtied only if style changed,
+// return whether it changed.
+bool HPNodeSetStyle(HPNodeRef node, const HPStyle& style);
+// nodes with same content give same hash to share measure results,
+// 0 means the content is not shared. see HPConfig::SetSharedMeasureCacheCapacity
+void HPNodeSetMeasureContentHash(HPNodeRef node, uint64_t contentHash);
+// windowed layout of a scroll container (overflow scroll, no wrap), only items
+// in [offset - margin, offset + size + margin] along main axis are laid out,
+// the others keep main size of last pass or estimatedItemSize.
+void HPNodeSetViewport(HPNodeRef node,
+                       float offset,
+                       float size,
+                       float margin,
+                       float estimatedItemSize);
+void HPNodeClearViewport(HPNodeRef node);
+// item was skipped by its parent's windowed layout in last pass.
+bool HPNodeIsOutOfViewport(HPNodeRef node);
 void HPNodeStyleSetFlex(HPNodeRef node, float flex);
 void HPNodeStyleSetFlexGrow(HPNodeRef node, float flexGrow);
 void HPNodeStyleSetFlexShrink(HPNodeRef node, float flexShrink);
@@ -69,12 +92,39 @@ float HPNodeLayoutGetPadding(HPNodeRef node, CSSDirection dir);
 float HPNodeLayoutGetBorder(HPNodeRef node, CSSDirection dir);
 bool HPNodeLayoutGetHadOverflow(HPNodeRef node);
 
+float HPNodeStyleGetMaxWidth(HPNodeRef node);
+float HPNodeStyleGetMaxHeight(HPNodeRef node);
+float HPNodeStyleGetMinWidth(HPNodeRef node);
+float HPNodeStyleGetMinHeight(HPNodeRef node);
+float HPNodeStyleGetFlexGrow(HPNodeRef node);
+float HPNodeStyleGetFlexShrink(HPNodeRef node);
+float HPNodeStyleGetFlexBasis(HPNodeRef node);
+float HPNodeStyleGetPosition(HPNodeRef node, CSSDirection dir);
+DisplayType HPNodeStyleGetDisplay(HPNodeRef node);
+FlexDirection HPNodeStyleGetFlexDirection(HPNodeRef node);
+FlexAlign HPNodeStyleGetJustifyContent(HPNodeRef node);
+FlexAlign HPNodeStyleGetAlignSelf(HPNodeRef node);
+FlexAlign HPNodeStyleGetAlignItems(HPNodeRef node);
+PositionType HPNodeStyleGetPositionType(HPNodeRef node);
+FlexWrapMode HPNodeStyleGetFlexWrap(HPNodeRef node);
+OverflowType HPNodeStyleGetOverflow(HPNodeRef node);
+
 void HPNodeSetConfig(HPNodeRef node, HPConfigRef config);
 void HPConfigFree(HPConfigRef);
 HPConfigRef HPConfigGetDefault();
 
+// children are kept in a vector the layout algorithm indexes. a child is
+// found in O(1), but inserting or removing it shifts the children after it,
+// O(n) except at the end. many changes of one parent should go through
+// HPNodeApplyChildMoves, O(n + moves) for all of them.
 bool HPNodeInsertChild(HPNodeRef node, HPNodeRef child, uint32_t index);
 bool HPNodeRemoveChild(HPNodeRef node, HPNodeRef child);
+bool HPNodeApplyChildMoves(HPNodeRef node, const HPChildMove* moves, uint32_t count);
+uint32_t HPNodeChildCount(HPNodeRef node);
+HPNodeRef HPNodeGetChild(HPNodeRef node, uint32_t index);
+HPNodeRef HPNodeGetParent(HPNodeRef node);
+void HPNodeSetContext(HPNodeRef node, void* context);
+void* HPNodeGetContext(HPNodeRef node);
 bool HPNodeHasNewLayout(HPNodeRef node);
 void HPNodesetHasNewLayout(HPNodeRef node, bool hasNewLayout);
 void HPNodeMarkDirty(HPNodeRef node);
@@ -84,5 +134,19 @@ void HPNodeDoLayout(HPNodeRef node,
                     float parentHeight,
                     HPDirection direction = DirectionLTR,
                     void* layoutContext = nullptr);
+// layout in batch measure mode, content nodes are measured by
+// batchMeasureFunc in a few calls instead of their own measure functions.
+void HPNodeDoLayoutWithBatchMeasure(HPNodeRef node,
+                                    float parentWidth,
+                                    float parentHeight,
+                                    HPBatchMeasureFunc batchMeasureFunc,
+                                    HPDirection direction = DirectionLTR,
+                                    void* layoutContext = nullptr);
 void HPNodePrint(HPNodeRef node);
 bool HPNodeReset(HPNodeRef node);
+
+// layout cache lookups of the node, or the sum of the node and its descendants.
+HPMeasureCacheStats HPNodeGetMeasureCacheStats(HPNodeRef node);
+HPMeasureCacheStats HPNodeGetTreeMeasureCacheStats(HPNodeRef node);
+// reset counters of the node and its descendants.
+void HPNodeResetMeasureCacheStats(HPNodeRef node);
@@ -21,4 +21,6 @@ ${MAKE}
 GTEST_RUN_PATH="${BUILD_DIR}"/gtest/gtest_hippy_layout
 if [ -x "${GTEST_RUN_PATH}" ];then
 ${GTEST_RUN_PATH}
+# run all suites again with parallel layout in default config.
+HP_PARALLEL_LAYOUT_THREADS=4 ${GTEST_RUN_PATH}
 fi
@@ -0,0 +1,140 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include "HPTestTrees.h"
+
+static int batchCount = 0;
+static int batchRequestCount = 0;
+
+static void _batchMeasureText(HPMeasureRequest* requests, uint32_t count, void* layoutContext) {
+  batchCount++;
+  batchRequestCount += count;
+  for (uint32_t i = 0; i < count; i++) {
+    requests[i].result = measureTextOfLength(reinterpret_cast<intptr_t>(requests[i].context),
+                                             requests[i].width, requests[i].widthMeasureMode);
+  }
+}
+
+TEST(HippyTest, batch_measure_same_as_measure_func) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildFeed(config);
+  textMeasureCount = 0;
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_GE(textMeasureCount.load(), 40);
+
+  const HPNodeRef batchRoot = buildFeed(config);
+  textMeasureCount = 0;
+  batchCount = 0;
+  batchRequestCount = 0;
+  HPNodeDoLayoutWithBatchMeasure(batchRoot, VALUE_UNDEFINED, VALUE_UNDEFINED, _batchMeasureText);
+  // measure functions are not called, all content nodes are measured in
+  // a few batches.
+  ASSERT_EQ(0, textMeasureCount.load());
+  ASSERT_GE(batchRequestCount, 40);
+  ASSERT_LE(batchCount, HP_MAX_BATCH_MEASURE_ROUNDS - 1);
+  ASSERT_EQ(static_cast<uint32_t>(batchCount), config->GetLayoutStats().batchMeasureCount);
+  assertSameLayout(root, batchRoot);
+
+  // relayout after text changed, only the changed node is requested.
+  setTextLength(batchRoot->getChild(3)->getChild(1), 60);
+  batchRequestCount = 0;
+  HPNodeDoLayoutWithBatchMeasure(batchRoot, VALUE_UNDEFINED, VALUE_UNDEFINED, _batchMeasureText);
+  ASSERT_GT(batchRequestCount, 0);
+  ASSERT_LT(batchRequestCount, 10);
+  ASSERT_EQ(0, textMeasureCount.load());
+
+  setTextLength(root->getChild(3)->getChild(1), 60);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  assertSameLayout(root, batchRoot);
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(batchRoot);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, batch_measure_no_content_node) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetWidth(root, 100);
+  const HPNodeRef child = HPNodeNewWithConfig(config);
+  HPNodeStyleSetHeight(child, 30);
+  HPNodeInsertChild(root, child, 0);
+
+  batchCount = 0;
+  HPNodeDoLayoutWithBatchMeasure(root, VALUE_UNDEFINED, VALUE_UNDEFINED, _batchMeasureText);
+  ASSERT_EQ(0, batchCount);
+  ASSERT_FLOAT_EQ(30, HPNodeLayoutGetHeight(root));
+  ASSERT_TRUE(config->batchMeasure == nullptr);
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
+
+// each level is a column of a text and a row below it, the row shrinks a text
+// and the next level beside each other. so widths of a level are known only
+// after all texts of levels before it are measured.
+static HPNodeRef buildNestedTexts(HPConfigRef config, uint32_t depth) {
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetWidth(root, 600);
+  HPNodeRef level = root;
+  for (uint32_t i = 0; i < depth; i++) {
+    HPNodeStyleSetAlignItems(level, FlexAlignStart);
+    const HPNodeRef title = HPNodeNewWithConfig(config);
+    HPNodeSetMeasureFunc(title, measureText);
+    title->setContext(reinterpret_cast<void*>(static_cast<intptr_t>(40 + i % 3)));
+    HPNodeInsertChild(level, title, 0);
+
+    const HPNodeRef row = HPNodeNewWithConfig(config);
+    HPNodeStyleSetFlexDirection(row, FLexDirectionRow);
+    HPNodeStyleSetAlignSelf(row, FlexAlignStretch);
+    HPNodeInsertChild(level, row, 1);
+    const HPNodeRef text = HPNodeNewWithConfig(config);
+    HPNodeStyleSetFlexShrink(text, 1);
+    HPNodeSetMeasureFunc(text, measureText);
+    text->setContext(reinterpret_cast<void*>(static_cast<intptr_t>(30)));
+    HPNodeInsertChild(row, text, 0);
+    const HPNodeRef next = HPNodeNewWithConfig(config);
+    HPNodeStyleSetFlexShrink(next, 1);
+    HPNodeInsertChild(row, next, 1);
+    level = next;
+  }
+  return root;
+}
+
+TEST(HippyTest, batch_measure_stops_after_max_rounds) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildNestedTexts(config, 10);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  const HPNodeRef batchRoot = buildNestedTexts(config, 10);
+  textMeasureCount = 0;
+  batchCount = 0;
+  HPNodeDoLayoutWithBatchMeasure(batchRoot, VALUE_UNDEFINED, VALUE_UNDEFINED, _batchMeasureText);
+  // every round finds new requests, the last pass measures the rest itself.
+  ASSERT_EQ(HP_MAX_BATCH_MEASURE_ROUNDS, batchCount);
+  ASSERT_EQ(static_cast<uint32_t>(batchCount), config->GetLayoutStats().batchMeasureCount);
+  ASSERT_GT(textMeasureCount.load(), 0);
+  ASSERT_TRUE(config->batchMeasure == nullptr);
+  assertSameLayout(root, batchRoot);
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(batchRoot);
+  HPConfigFree(config);
+}
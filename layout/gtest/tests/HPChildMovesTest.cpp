@@ -0,0 +1,161 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <gtest.h>
+
+static int dirtiedCount = 0;
+
+static void countDirtied(HPNodeRef node) {
+  dirtiedCount++;
+}
+
+static HPNodeRef buildRow(HPNodeRef children[], uint32_t count) {
+  const HPNodeRef root = HPNodeNew();
+  HPNodeStyleSetFlexDirection(root, FLexDirectionRow);
+  for (uint32_t i = 0; i < count; i++) {
+    children[i] = HPNodeNew();
+    HPNodeStyleSetWidth(children[i], 10 * (i + 1));
+    HPNodeStyleSetHeight(children[i], 10);
+    HPNodeInsertChild(root, children[i], i);
+  }
+  return root;
+}
+
+TEST(HippyTest, child_index_in_parent) {
+  HPNodeRef children[5];
+  const HPNodeRef root = buildRow(children, 5);
+  for (uint32_t i = 0; i < 5; i++) {
+    ASSERT_EQ(static_cast<int32_t>(i), root->indexOfChild(children[i]));
+  }
+
+  ASSERT_TRUE(HPNodeRemoveChild(root, children[1]));
+  ASSERT_EQ(4u, HPNodeChildCount(root));
+  ASSERT_EQ(-1, root->indexOfChild(children[1]));
+  ASSERT_EQ(1, root->indexOfChild(children[2]));
+  ASSERT_EQ(3, root->indexOfChild(children[4]));
+  ASSERT_FALSE(HPNodeRemoveChild(root, children[1]));
+
+  // stale index after children changed directly is repaired.
+  std::swap(root->children[0], root->children[3]);
+  ASSERT_EQ(3, root->indexOfChild(children[0]));
+  ASSERT_EQ(0, root->indexOfChild(children[4]));
+
+  HPNodeFree(children[1]);
+  HPNodeFreeRecursive(root);
+}
+
+TEST(HippyTest, apply_child_moves) {
+  HPNodeRef children[5];
+  const HPNodeRef root = buildRow(children, 5);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  const HPNodeRef added = HPNodeNew();
+  HPNodeStyleSetWidth(added, 5);
+  HPNodeStyleSetHeight(added, 10);
+  // [0 1 2 3 4] -> [4 added 0 2 3]
+  HPChildMove moves[] = {{children[4], 0}, {added, 1}, {children[1], -1}};
+  ASSERT_TRUE(HPNodeApplyChildMoves(root, moves, 3));
+  ASSERT_EQ(5u, HPNodeChildCount(root));
+  HPNodeRef expected[] = {children[4], added, children[0], children[2], children[3]};
+  for (uint32_t i = 0; i < 5; i++) {
+    ASSERT_EQ(expected[i], HPNodeGetChild(root, i));
+    ASSERT_EQ(root, HPNodeGetParent(expected[i]));
+    ASSERT_EQ(static_cast<int32_t>(i), root->indexOfChild(expected[i]));
+  }
+  ASSERT_TRUE(HPNodeGetParent(children[1]) == nullptr);
+  ASSERT_TRUE(HPNodeIsDirty(root));
+
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  float left = 0;
+  for (uint32_t i = 0; i < 5; i++) {
+    ASSERT_FLOAT_EQ(left, HPNodeLayoutGetLeft(expected[i]));
+    left += HPNodeLayoutGetWidth(expected[i]);
+  }
+
+  HPNodeFree(children[1]);
+  HPNodeFreeRecursive(root);
+}
+
+TEST(HippyTest, apply_child_moves_dirty_once) {
+  HPNodeRef children[4];
+  const HPNodeRef root = buildRow(children, 4);
+  const HPNodeRef container = HPNodeNew();
+  HPNodeInsertChild(container, root, 0);
+  HPNodeDoLayout(container, 100, 100);
+  root->setDirtiedFunc(countDirtied);
+
+  dirtiedCount = 0;
+  HPChildMove moves[] = {{children[0], 3}, {children[3], 0}, {children[2], 1}};
+  ASSERT_TRUE(HPNodeApplyChildMoves(root, moves, 3));
+  ASSERT_EQ(1, dirtiedCount);
+  ASSERT_EQ(children[3], HPNodeGetChild(root, 0));
+  ASSERT_EQ(children[2], HPNodeGetChild(root, 1));
+  ASSERT_EQ(children[1], HPNodeGetChild(root, 2));
+  ASSERT_EQ(children[0], HPNodeGetChild(root, 3));
+
+  // moves keeping the order change nothing.
+  HPNodeDoLayout(container, 100, 100);
+  dirtiedCount = 0;
+  HPChildMove same[] = {{children[1], 2}};
+  ASSERT_TRUE(HPNodeApplyChildMoves(root, same, 1));
+  ASSERT_EQ(0, dirtiedCount);
+  ASSERT_FALSE(HPNodeIsDirty(root));
+
+  HPNodeFreeRecursive(container);
+}
+
+TEST(HippyTest, apply_child_moves_invalid) {
+  HPNodeRef children[3];
+  const HPNodeRef root = buildRow(children, 3);
+  const HPNodeRef other = HPNodeNew();
+
+  // out of range, same slot, same child twice, remove a non child, and
+  // insert this node or its ancestor into it.
+  HPChildMove outOfRange[] = {{children[0], 3}};
+  HPChildMove sameSlot[] = {{children[0], 1}, {children[2], 1}};
+  HPChildMove sameChild[] = {{children[0], 1}, {children[0], 2}};
+  HPChildMove removeOther[] = {{other, -1}};
+  HPChildMove insertTwice[] = {{other, 0}, {other, 1}};
+  HPChildMove insertSelf[] = {{root, 0}};
+  HPChildMove insertAncestor[] = {{root, 0}};
+  ASSERT_FALSE(HPNodeApplyChildMoves(root, outOfRange, 1));
+  ASSERT_FALSE(HPNodeApplyChildMoves(root, sameSlot, 2));
+  ASSERT_FALSE(HPNodeApplyChildMoves(root, sameChild, 2));
+  ASSERT_FALSE(HPNodeApplyChildMoves(root, removeOther, 1));
+  ASSERT_FALSE(HPNodeApplyChildMoves(root, insertTwice, 2));
+  ASSERT_FALSE(HPNodeApplyChildMoves(root, insertSelf, 1));
+  ASSERT_FALSE(HPNodeApplyChildMoves(children[1], insertAncestor, 1));
+  ASSERT_EQ(0u, HPNodeChildCount(children[1]));
+  ASSERT_EQ(3u, HPNodeChildCount(root));
+  for (uint32_t i = 0; i < 3; i++) {
+    ASSERT_EQ(children[i], HPNodeGetChild(root, i));
+  }
+  ASSERT_TRUE(HPNodeGetParent(other) == nullptr);
+
+  // move a node from another parent.
+  const HPNodeRef otherParent = HPNodeNew();
+  HPNodeInsertChild(otherParent, other, 0);
+  HPChildMove adopt[] = {{other, 0}};
+  ASSERT_TRUE(HPNodeApplyChildMoves(root, adopt, 1));
+  ASSERT_EQ(0u, HPNodeChildCount(otherParent));
+  ASSERT_EQ(root, HPNodeGetParent(other));
+  ASSERT_EQ(other, HPNodeGetChild(root, 0));
+
+  HPNodeFree(otherParent);
+  HPNodeFreeRecursive(root);
+}
@@ -0,0 +1,86 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Hippy.h>
+#include <gtest.h>
+
+TEST(HippyTest, flex_line_arena_frames_reuse_lines) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef container = HPNodeNewWithConfig(config);
+  HPFlexLineArena arena;
+
+  std::vector<FlexLine*>& outer = arena.pushFrame();
+  FlexLine* first = arena.newLine(container);
+  outer.push_back(first);
+  container->result.hypotheticalMainAxisMarginBoxSize = 10;
+  first->addItem(container);
+  std::vector<FlexLine*>& inner = arena.pushFrame();
+  FlexLine* nested = arena.newLine(container);
+  inner.push_back(nested);
+  ASSERT_NE(first, nested);
+  ASSERT_EQ(2u, arena.frameDepth());
+  arena.popFrame();
+  // lines of outer frame are untouched by nested frames.
+  ASSERT_EQ(1u, outer.size());
+  ASSERT_EQ(first, outer[0]);
+  ASSERT_FLOAT_EQ(10, first->sumHypotheticalMainSize);
+  arena.popFrame();
+
+  // a new frame gets the same line objects back, reset.
+  std::vector<FlexLine*>& again = arena.pushFrame();
+  ASSERT_TRUE(again.empty());
+  FlexLine* reused = arena.newLine(container);
+  ASSERT_EQ(first, reused);
+  ASSERT_TRUE(reused->isEmpty());
+  ASSERT_FLOAT_EQ(0, reused->sumHypotheticalMainSize);
+  arena.popFrame();
+  ASSERT_EQ(2u, arena.lineCapacity());
+  ASSERT_EQ(0u, arena.frameDepth());
+
+  HPNodeFree(container);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, flex_line_arena_kept_across_layout_passes) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetFlexDirection(root, FLexDirectionRow);
+  HPNodeStyleSetFlexWrap(root, FlexWrap);
+  HPNodeStyleSetWidth(root, 100);
+  for (uint32_t i = 0; i < 10; i++) {
+    const HPNodeRef child = HPNodeNewWithConfig(config);
+    HPNodeStyleSetWidth(child, 30);
+    HPNodeStyleSetHeight(child, 10);
+    HPNodeInsertChild(root, child, i);
+  }
+
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(40, HPNodeLayoutGetHeight(root));
+  HPFlexLineArena* arena = HPFlexLineArena::current();
+  uint32_t capacity = arena->lineCapacity();
+  ASSERT_GE(capacity, 4u);
+  ASSERT_EQ(0u, arena->frameDepth());
+
+  HPNodeStyleSetWidth(root, 60);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(50, HPNodeLayoutGetHeight(root));
+  // one more line than last pass at most.
+  ASSERT_LE(arena->lineCapacity(), capacity + 1);
+  ASSERT_EQ(0u, arena->frameDepth());
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
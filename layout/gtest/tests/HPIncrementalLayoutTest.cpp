@@ -0,0 +1,176 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include "HPTestTrees.h"
+
+TEST(HippyTest, incremental_layout_text_change_relayout_its_cell_only) {
+  HPConfigRef config = new HPConfig();
+  config->SetIncrementalLayout(true);
+  const HPNodeRef root = buildFeed(config, true);
+  HPNodeStyleSetHeight(root, 1000);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(1000, HPNodeLayoutGetHeight(root));
+  uint32_t fullVisitCount = config->GetLayoutStats().visitCount;
+
+  const HPNodeRef cell = root->getChild(5);
+  const HPNodeRef text = cell->getChild(1);
+  const HPNodeRef other = cell->getChild(2);
+  ASSERT_FLOAT_EQ(80, HPNodeLayoutGetWidth(text));
+  ASSERT_FLOAT_EQ(125, HPNodeLayoutGetLeft(other));
+
+  setTextLength(text, 10);
+  // dirty state stops at the cell
+  ASSERT_TRUE(cell->isDirty);
+  ASSERT_FALSE(root->isDirty);
+  ASSERT_TRUE(HPNodeIsDirty(root));
+
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FALSE(HPNodeIsDirty(root));
+  ASSERT_EQ(1u, config->GetLayoutStats().relayoutAloneCount);
+  ASSERT_LT(config->GetLayoutStats().visitCount, fullVisitCount / 4);
+  ASSERT_FLOAT_EQ(45, HPNodeLayoutGetLeft(text));
+  ASSERT_FLOAT_EQ(100, HPNodeLayoutGetWidth(text));
+  ASSERT_FLOAT_EQ(145, HPNodeLayoutGetLeft(other));
+  ASSERT_FLOAT_EQ(250, HPNodeLayoutGetTop(cell));
+  ASSERT_FLOAT_EQ(1000, HPNodeLayoutGetHeight(root));
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, incremental_layout_same_as_full_layout) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildFeed(config, true);
+  HPConfigRef incrementalConfig = new HPConfig();
+  incrementalConfig->SetIncrementalLayout(true);
+  const HPNodeRef incrementalRoot = buildFeed(incrementalConfig, true);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  HPNodeDoLayout(incrementalRoot, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  for (uint32_t i = 0; i < 20; i += 3) {
+    setTextLength(root->getChild(i)->getChild(1), 15);
+    setTextLength(incrementalRoot->getChild(i)->getChild(1), 15);
+  }
+  // own size of a cell changed, its parent must relayout too.
+  HPNodeStyleSetHeight(root->getChild(3), 60);
+  HPNodeStyleSetHeight(incrementalRoot->getChild(3), 60);
+  ASSERT_TRUE(incrementalRoot->isDirty);
+
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  HPNodeDoLayout(incrementalRoot, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  // dirty cells are laid out by their dirty parent, not alone before it.
+  ASSERT_EQ(0u, incrementalConfig->GetLayoutStats().relayoutAloneCount);
+  ASSERT_FLOAT_EQ(210, HPNodeLayoutGetTop(incrementalRoot->getChild(4)));
+  assertSameLayout(root, incrementalRoot);
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(incrementalRoot);
+  HPConfigFree(config);
+  HPConfigFree(incrementalConfig);
+}
+
+TEST(HippyTest, incremental_layout_boundary_style_change_after_dirty) {
+  HPConfigRef config = new HPConfig();
+  config->SetIncrementalLayout(true);
+  const HPNodeRef root = buildFeed(config, true);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  const HPNodeRef cell = root->getChild(0);
+  HPNodeMarkDirty(cell->getChild(1));
+  ASSERT_FALSE(root->isDirty);
+  // cell has been dirty by its child, its own size change still goes up.
+  HPNodeStyleSetHeight(cell, 100);
+  ASSERT_TRUE(root->isDirty);
+
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(100, HPNodeLayoutGetTop(root->getChild(1)));
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, incremental_layout_stops_at_ancestor_of_same_size) {
+  HPConfigRef config = new HPConfig();
+  config->SetIncrementalLayout(true);
+  const HPNodeRef root = buildFeed(config);
+  HPNodeStyleSetHeight(root, 1000);
+  HPConfigRef fullConfig = new HPConfig();
+  const HPNodeRef fullRoot = buildFeed(fullConfig);
+  HPNodeStyleSetHeight(fullRoot, 1000);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  HPNodeDoLayout(fullRoot, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  uint32_t fullVisitCount = config->GetLayoutStats().visitCount;
+  const HPNodeRef cell = root->getChild(5);
+  ASSERT_FLOAT_EQ(50, HPNodeLayoutGetHeight(cell));
+
+  // cell is as high as its content, its height stays the same.
+  setTextLength(cell->getChild(1), 11);
+  setTextLength(fullRoot->getChild(5)->getChild(1), 11);
+  ASSERT_FALSE(root->isDirty);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  HPNodeDoLayout(fullRoot, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_EQ(1u, config->GetLayoutStats().relayoutAloneCount);
+  ASSERT_LT(config->GetLayoutStats().visitCount, fullVisitCount / 4);
+  ASSERT_FLOAT_EQ(155, HPNodeLayoutGetLeft(cell->getChild(2)));
+  ASSERT_FLOAT_EQ(50, HPNodeLayoutGetHeight(cell));
+  assertSameLayout(fullRoot, root);
+
+  // texts wrap and the cell grows, its parent is relayout and the cells
+  // after it move down.
+  setTextLength(cell->getChild(1), 60);
+  setTextLength(fullRoot->getChild(5)->getChild(1), 60);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  HPNodeDoLayout(fullRoot, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FALSE(HPNodeIsDirty(root));
+  ASSERT_FLOAT_EQ(90, HPNodeLayoutGetHeight(cell));
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetTop(cell) + 90, HPNodeLayoutGetTop(root->getChild(6)));
+  assertSameLayout(fullRoot, root);
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(fullRoot);
+  HPConfigFree(config);
+  HPConfigFree(fullConfig);
+}
+
+static uint32_t countModeStates(HPNodeRef node) {
+  uint32_t count = node->modeState != nullptr ? 1 : 0;
+  for (uint32_t i = 0; i < HPNodeChildCount(node); i++) {
+    count += countModeStates(HPNodeGetChild(node, i));
+  }
+  return count;
+}
+
+TEST(HippyTest, incremental_layout_state_only_in_incremental_mode) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildFeed(config);
+  HPNodeDoLayout(root, 300, VALUE_UNDEFINED);
+  ASSERT_EQ(0u, countModeStates(root));
+
+  // every node but the root keeps the calls of its parent.
+  HPConfigRef incrementalConfig = new HPConfig();
+  incrementalConfig->SetIncrementalLayout(true);
+  const HPNodeRef incrementalRoot = buildFeed(incrementalConfig);
+  HPNodeDoLayout(incrementalRoot, 300, VALUE_UNDEFINED);
+  ASSERT_EQ(80u, countModeStates(incrementalRoot));
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(incrementalRoot);
+  HPConfigFree(config);
+  HPConfigFree(incrementalConfig);
+}
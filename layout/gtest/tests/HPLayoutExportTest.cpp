@@ -0,0 +1,133 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include <string.h>
+
+#include <vector>
+
+// id is the node's index in a vector
+static int32_t _nodeId(HPNodeRef node, void* context) {
+  std::vector<HPNodeRef>& nodes = *reinterpret_cast<std::vector<HPNodeRef>*>(context);
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (nodes[i] == node) {
+      return static_cast<int32_t>(i);
+    }
+  }
+  return -1;
+}
+
+static float readFloat(const std::vector<uint32_t>& buffer, size_t index) {
+  float value;
+  memcpy(&value, &buffer[index], sizeof(float));
+  return value;
+}
+
+TEST(HippyTest, layout_export_new_layout_nodes) {
+  std::vector<HPNodeRef> nodes;
+  const HPNodeRef root = HPNodeNew();
+  HPNodeStyleSetWidth(root, 100);
+  HPNodeStyleSetHeight(root, 100);
+  HPNodeStyleSetPadding(root, CSSAll, 10);
+  nodes.push_back(root);
+  for (uint32_t i = 0; i < 3; i++) {
+    const HPNodeRef child = HPNodeNew();
+    HPNodeStyleSetHeight(child, 20);
+    HPNodeStyleSetMargin(child, CSSLeft, i);
+    HPNodeInsertChild(root, child, i);
+    nodes.push_back(child);
+  }
+  HPNodeDoLayout(root, 100, 100);
+
+  uint32_t recordSize = HPLayoutExportRecordSize(HP_EXPORT_MARGIN | HP_EXPORT_PADDING);
+  ASSERT_EQ(13u, recordSize);
+  std::vector<uint32_t> buffer(recordSize * nodes.size());
+  uint32_t count = HPNodeExportLayout(root, HP_EXPORT_MARGIN | HP_EXPORT_PADDING, _nodeId, &nodes,
+                                      buffer.data(), buffer.size() * sizeof(uint32_t));
+  ASSERT_EQ(4u, count);
+  for (uint32_t i = 0; i < count; i++) {
+    size_t base = i * recordSize;
+    int32_t id = static_cast<int32_t>(buffer[base]);
+    ASSERT_EQ(static_cast<int32_t>(i), id);
+    HPNodeRef node = nodes[id];
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetLeft(node), readFloat(buffer, base + 1));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetTop(node), readFloat(buffer, base + 2));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetWidth(node), readFloat(buffer, base + 3));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetHeight(node), readFloat(buffer, base + 4));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetMargin(node, CSSLeft), readFloat(buffer, base + 5));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetPadding(node, CSSBottom), readFloat(buffer, base + 12));
+    ASSERT_FALSE(HPNodeHasNewLayout(node));
+  }
+
+  // nothing changed, nothing to export.
+  // root with undefined parent size is always laid out again, give it one.
+  HPNodeDoLayout(root, 100, 100);
+  ASSERT_EQ(0u, HPNodeExportLayout(root, 0, _nodeId, &nodes, buffer.data(),
+                                   buffer.size() * sizeof(uint32_t)));
+
+  HPNodeStyleSetHeight(nodes[2], 30);
+  HPNodeDoLayout(root, 100, 100);
+  count = HPNodeExportLayout(root, 0, _nodeId, &nodes, buffer.data(),
+                             buffer.size() * sizeof(uint32_t));
+  ASSERT_GE(count, 2u);
+  ASSERT_EQ(0u, buffer[0]);
+  bool changedNodeExported = false;
+  for (uint32_t i = 0; i < count; i++) {
+    size_t base = i * HPLayoutExportRecordSize(0);
+    if (buffer[base] == 2u) {
+      changedNodeExported = true;
+      ASSERT_FLOAT_EQ(30, readFloat(buffer, base + 4));
+    }
+  }
+  ASSERT_TRUE(changedNodeExported);
+
+  HPNodeFreeRecursive(root);
+}
+
+TEST(HippyTest, layout_export_buffer_too_small) {
+  std::vector<HPNodeRef> nodes;
+  const HPNodeRef root = HPNodeNew();
+  HPNodeStyleSetWidth(root, 100);
+  nodes.push_back(root);
+  for (uint32_t i = 0; i < 3; i++) {
+    const HPNodeRef child = HPNodeNew();
+    HPNodeStyleSetHeight(child, 20);
+    HPNodeInsertChild(root, child, i);
+    // the last child has no id, it's skipped.
+    if (i < 2) {
+      nodes.push_back(child);
+    }
+  }
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  uint32_t recordSize = HPLayoutExportRecordSize(0);
+  std::vector<uint32_t> buffer(recordSize * 2);
+  ASSERT_EQ(3u, HPNodeExportLayout(root, 0, _nodeId, &nodes, buffer.data(),
+                                   buffer.size() * sizeof(uint32_t)));
+  // nothing is marked seen, retry with a larger buffer.
+  ASSERT_TRUE(HPNodeHasNewLayout(root));
+  buffer.resize(recordSize * 3);
+  ASSERT_EQ(3u, HPNodeExportLayout(root, 0, _nodeId, &nodes, buffer.data(),
+                                   buffer.size() * sizeof(uint32_t)));
+  ASSERT_FALSE(HPNodeHasNewLayout(root));
+  ASSERT_EQ(2u, buffer[2 * recordSize]);
+  ASSERT_TRUE(HPNodeHasNewLayout(root->getChild(2)));
+
+  HPNodeFreeRecursive(root);
+}
@@ -0,0 +1,192 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "HPTestTrees.h"
+
+static std::thread::id pipelineMeasureThread;
+
+// labels are texts of 4 characters, their context is their id.
+static HPSize measureLabel(HPNodeRef node,
+                           float width,
+                           MeasureMode widthMeasureMode,
+                           float height,
+                           MeasureMode heightMeasureMode,
+                           void* layoutContext) {
+  pipelineMeasureThread = std::this_thread::get_id();
+  return measureTextOfLength(4, width, widthMeasureMode);
+}
+
+static HPNodeRef newNode(intptr_t id) {
+  const HPNodeRef node = HPNodeNew();
+  HPNodeSetContext(node, reinterpret_cast<void*>(id));
+  return node;
+}
+
+// row of count boxes, each with a label inside.
+static HPNodeRef buildRow(uint32_t count) {
+  const HPNodeRef root = newNode(1);
+  HPNodeStyleSetFlexDirection(root, FLexDirectionRow);
+  HPNodeStyleSetFlexWrap(root, FlexWrap);
+  HPNodeStyleSetWidth(root, 200);
+  for (uint32_t i = 0; i < count; i++) {
+    const HPNodeRef box = newNode(100 + i);
+    HPNodeStyleSetPadding(box, CSSAll, 5);
+    HPNodeInsertChild(root, box, i);
+    const HPNodeRef label = newNode(200 + i);
+    HPNodeSetMeasureFunc(label, measureLabel);
+    HPNodeInsertChild(box, label, 0);
+  }
+  return root;
+}
+
+TEST(HippyTest, pipeline_publishes_layout_of_worker_thread) {
+  const HPNodeRef pending = buildRow(8);
+  HPLayoutPipeline pipeline(pending);
+  pipeline.commit(VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FALSE(HPNodeIsDirty(pending));
+  pipeline.waitIdle();
+  ASSERT_NE(std::this_thread::get_id(), pipelineMeasureThread);
+
+  std::vector<HPPublishedLayout> results;
+  ASSERT_EQ(1u, pipeline.takeResults(results));
+  ASSERT_EQ(17u, results.size());
+
+  const HPNodeRef expected = buildRow(8);
+  HPNodeDoLayout(expected, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  assertSameLayout(results, expected);
+  for (uint32_t i = 0; i < 8; i++) {
+    assertSameLayout(results, HPNodeGetChild(expected, i));
+    assertSameLayout(results, HPNodeGetChild(HPNodeGetChild(expected, i), 0));
+  }
+  // pending tree itself is never laid out.
+  ASSERT_FLOAT_EQ(0, HPNodeLayoutGetWidth(pending));
+
+  pipeline.takeResults(results);
+  ASSERT_EQ(0u, results.size());
+  HPNodeFreeRecursive(expected);
+  HPNodeFreeRecursive(pending);
+}
+
+TEST(HippyTest, pipeline_commits_only_changed_subtrees) {
+  const HPNodeRef pending = buildRow(8);
+  HPLayoutPipeline pipeline(pending);
+  pipeline.commit(VALUE_UNDEFINED, VALUE_UNDEFINED);
+  pipeline.waitIdle();
+  std::vector<HPPublishedLayout> results;
+  pipeline.takeResults(results);
+
+  // grow the last box, labels of the others keep their layout
+  // and are not published.
+  const HPNodeRef last = HPNodeGetChild(pending, 7);
+  HPNodeStyleSetWidth(last, 100);
+  pipeline.commit(VALUE_UNDEFINED, VALUE_UNDEFINED);
+  pipeline.waitIdle();
+  ASSERT_EQ(2u, pipeline.takeResults(results));
+  ASSERT_TRUE(findPublishedLayout(results, last) != nullptr);
+  ASSERT_FLOAT_EQ(100, findPublishedLayout(results, last)->width);
+  ASSERT_LT(results.size(), 17u);
+  const HPNodeRef firstLabel = HPNodeGetChild(HPNodeGetChild(pending, 0), 0);
+  ASSERT_TRUE(findPublishedLayout(results, firstLabel) == nullptr);
+
+  // no change, no pass.
+  pipeline.commit(VALUE_UNDEFINED, VALUE_UNDEFINED);
+  pipeline.waitIdle();
+  ASSERT_EQ(2u, pipeline.takeResults(results));
+  ASSERT_EQ(0u, results.size());
+  HPNodeFreeRecursive(pending);
+}
+
+TEST(HippyTest, pipeline_follows_structure_changes) {
+  const HPNodeRef pending = buildRow(8);
+  HPLayoutPipeline pipeline(pending);
+  pipeline.commit(VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  // edit pending tree while the worker may be laying it out.
+  HPNodeFreeRecursive(HPNodeGetChild(pending, 0));
+  const HPNodeRef source = HPNodeGetChild(pending, 1);
+  const HPNodeRef target = HPNodeGetChild(pending, 4);
+  const HPNodeRef moved = HPNodeGetChild(source, 0);
+  HPNodeRemoveChild(source, moved);
+  HPNodeInsertChild(target, moved, 1);
+  const HPNodeRef added = newNode(300);
+  HPNodeStyleSetWidth(added, 30);
+  HPNodeStyleSetHeight(added, 30);
+  HPNodeInsertChild(pending, added, 0);
+  pipeline.commit(VALUE_UNDEFINED, VALUE_UNDEFINED);
+  pipeline.waitIdle();
+
+  const HPNodeRef layoutRoot = pipeline.layoutRoot();
+  ASSERT_EQ(HPNodeChildCount(pending), HPNodeChildCount(layoutRoot));
+  ASSERT_EQ(0u, HPNodeChildCount(HPNodeGetChild(layoutRoot, 2)));
+  ASSERT_EQ(2u, HPNodeChildCount(HPNodeGetChild(layoutRoot, 5)));
+
+  // same layout as laying out the pending tree directly.
+  HPNodeDoLayout(pending, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  for (uint32_t i = 0; i < HPNodeChildCount(pending); i++) {
+    HPNodeRef child = HPNodeGetChild(pending, i);
+    HPNodeRef layoutChild = HPNodeGetChild(layoutRoot, i);
+    ASSERT_EQ(HPNodeGetContext(child), HPNodeGetContext(layoutChild));
+    assertSameLayout(child, layoutChild);
+  }
+  HPNodeFreeRecursive(pending);
+}
+
+static std::atomic<bool> publishedFuncDone(false);
+
+static void _unsetInPublishedFunc(void* userData) {
+  HPLayoutPipeline* pipeline = reinterpret_cast<HPLayoutPipeline*>(userData);
+  // called without the pipeline locked.
+  pipeline->setPublishedFunc(nullptr, nullptr);
+  publishedFuncDone = true;
+}
+
+TEST(HippyTest, pipeline_syncs_context_with_own_config) {
+  const HPNodeRef pending = buildRow(4);
+  HPConfigRef settings = new HPConfig();
+  settings->SetIncrementalLayout(true);
+  HPLayoutPipeline pipeline(pending, settings);
+  ASSERT_TRUE(pipeline.layoutConfig() != settings);
+  ASSERT_TRUE(pipeline.layoutConfig() != HPConfigGetDefault());
+  ASSERT_TRUE(pipeline.layoutConfig()->UseIncrementalLayout());
+  pipeline.setPublishedFunc(_unsetInPublishedFunc, &pipeline);
+  pipeline.commit(VALUE_UNDEFINED, VALUE_UNDEFINED);
+  while (!publishedFuncDone) {
+    std::this_thread::yield();
+  }
+  std::vector<HPPublishedLayout> results;
+  pipeline.takeResults(results);
+
+  // only the context changed, the node is still synced and published.
+  const HPNodeRef label = HPNodeGetChild(HPNodeGetChild(pending, 2), 0);
+  HPNodeSetContext(label, reinterpret_cast<void*>(static_cast<intptr_t>(400)));
+  ASSERT_TRUE(HPNodeIsDirty(label));
+  pipeline.commit(VALUE_UNDEFINED, VALUE_UNDEFINED);
+  pipeline.waitIdle();
+  pipeline.takeResults(results);
+  ASSERT_TRUE(findPublishedLayout(results, label) != nullptr);
+  ASSERT_EQ(HPNodeGetContext(label),
+            HPNodeGetContext(HPNodeGetChild(HPNodeGetChild(pipeline.layoutRoot(), 2), 0)));
+
+  HPNodeFreeRecursive(pending);
+  HPConfigFree(settings);
+}
@@ -0,0 +1,205 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include <vector>
+
+#include "HPTestTrees.h"
+
+static std::vector<HPNodeRef> measuredNodes;
+
+static HPSize recordMeasure(HPNodeRef node,
+                            float width,
+                            MeasureMode widthMeasureMode,
+                            float height,
+                            MeasureMode heightMeasureMode,
+                            void* layoutContext) {
+  measuredNodes.push_back(node);
+  return measureText(node, width, widthMeasureMode, height, heightMeasureMode, layoutContext);
+}
+
+// pre-order: root, row, text, box, absolute, text.
+static intptr_t textLengths[] = {0, 0, 25, 0, 0, 40};
+
+static HPNodeRef buildScreen(HPConfigRef config, const intptr_t* lengths) {
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetWidth(root, 300);
+  HPNodeStyleSetPadding(root, CSSAll, 8);
+
+  const HPNodeRef row = HPNodeNewWithConfig(config);
+  HPNodeStyleSetFlexDirection(row, FLexDirectionRow);
+  HPNodeStyleSetBorder(row, CSSBottom, 1);
+  HPNodeInsertChild(root, row, 0);
+
+  const HPNodeRef title = newText(config, lengths[2]);
+  HPNodeSetMeasureContentHash(title, static_cast<uint64_t>(lengths[2]));
+  HPNodeStyleSetFlexShrink(title, 1);
+  HPNodeInsertChild(row, title, 0);
+
+  const HPNodeRef box = HPNodeNewWithConfig(config);
+  HPNodeStyleSetWidth(box, 40);
+  HPNodeStyleSetHeight(box, 40);
+  HPNodeStyleSetMargin(box, CSSLeft, 4);
+  HPNodeInsertChild(row, box, 1);
+
+  const HPNodeRef badge = HPNodeNewWithConfig(config);
+  HPNodeStyleSetPositionType(badge, PositionTypeAbsolute);
+  HPNodeStyleSetPosition(badge, CSSRight, 2);
+  HPNodeStyleSetPosition(badge, CSSTop, 2);
+  HPNodeStyleSetWidth(badge, 10);
+  HPNodeStyleSetHeight(badge, 10);
+  HPNodeInsertChild(box, badge, 0);
+
+  const HPNodeRef body = newText(config, lengths[5]);
+  HPNodeSetMeasureContentHash(body, static_cast<uint64_t>(lengths[5]));
+  HPNodeInsertChild(root, body, 1);
+  return root;
+}
+
+typedef struct {
+  const intptr_t* lengths;
+  std::vector<HPNodeRef> dirtied;
+} BindContext;
+
+static void bindNode(HPNodeRef node, uint32_t index, void* userData) {
+  BindContext* bind = static_cast<BindContext*>(userData);
+  if (node->measure == nullptr) {
+    return;
+  }
+  HPNodeSetContext(node, reinterpret_cast<void*>(bind->lengths[index]));
+  if (node->measureContentHash != static_cast<uint64_t>(bind->lengths[index])) {
+    HPNodeSetMeasureContentHash(node, static_cast<uint64_t>(bind->lengths[index]));
+    HPNodeMarkDirty(node);
+    bind->dirtied.push_back(node);
+  }
+}
+
+static std::vector<char> saveSnapshot(HPNodeRef root) {
+  std::vector<char> buffer(HPNodeSaveSnapshot(root, nullptr, 0));
+  EXPECT_EQ(buffer.size(), HPNodeSaveSnapshot(root, buffer.data(), buffer.size()));
+  return buffer;
+}
+
+TEST(HippyTest, snapshot_restores_layout_without_measure) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildScreen(config, textLengths);
+  HPNodeDoLayout(root, 300, 600);
+  std::vector<char> buffer = saveSnapshot(root);
+
+  BindContext bind = {textLengths, {}};
+  const HPNodeRef loaded = HPNodeLoadSnapshot(buffer.data(), buffer.size(), config, recordMeasure,
+                                              bindNode, &bind);
+  ASSERT_TRUE(loaded != nullptr);
+  ASSERT_TRUE(bind.dirtied.empty());
+  ASSERT_FALSE(HPNodeIsDirty(loaded));
+  ASSERT_TRUE(HPNodeHasNewLayout(loaded));
+  ASSERT_FLOAT_EQ(2, HPNodeStyleGetPosition(HPNodeGetChild(HPNodeGetChild(
+                         HPNodeGetChild(loaded, 0), 1), 0), CSSRight));
+  assertSameLayout(root, loaded);
+
+  measuredNodes.clear();
+  HPNodeDoLayout(loaded, 300, 600);
+  ASSERT_TRUE(measuredNodes.empty());
+  assertSameLayout(root, loaded);
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(loaded);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, snapshot_relayout_changed_content) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildScreen(config, textLengths);
+  HPNodeDoLayout(root, 300, 600);
+  std::vector<char> buffer = saveSnapshot(root);
+
+  intptr_t changedLengths[] = {0, 0, 25, 0, 0, 90};
+  BindContext bind = {changedLengths, {}};
+  const HPNodeRef loaded = HPNodeLoadSnapshot(buffer.data(), buffer.size(), config, recordMeasure,
+                                              bindNode, &bind);
+  ASSERT_EQ(1u, bind.dirtied.size());
+  ASSERT_EQ(HPNodeGetChild(loaded, 1), bind.dirtied[0]);
+
+  measuredNodes.clear();
+  HPNodeDoLayout(loaded, 300, 600);
+  ASSERT_FALSE(measuredNodes.empty());
+  for (size_t i = 0; i < measuredNodes.size(); i++) {
+    ASSERT_EQ(bind.dirtied[0], measuredNodes[i]);
+  }
+
+  const HPNodeRef expected = buildScreen(config, changedLengths);
+  HPNodeDoLayout(expected, 300, 600);
+  assertSameLayout(expected, loaded);
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(loaded);
+  HPNodeFreeRecursive(expected);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, snapshot_file_into_node_pool) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildScreen(config, textLengths);
+  HPNodeDoLayout(root, 300, 600);
+  const char* path = "hp_layout_snapshot_test.bin";
+  ASSERT_TRUE(HPNodeSaveSnapshotFile(root, path));
+
+  HPConfigRef poolConfig = new HPConfig();
+  poolConfig->SetUseNodePool(true);
+  BindContext bind = {textLengths, {}};
+  const HPNodeRef loaded = HPNodeLoadSnapshotFile(path, poolConfig, recordMeasure, bindNode, &bind);
+  remove(path);
+  ASSERT_TRUE(loaded != nullptr);
+  ASSERT_EQ(6u, poolConfig->GetNodePool()->liveCount());
+  assertSameLayout(root, loaded);
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(loaded);
+  HPConfigFree(config);
+  HPConfigFree(poolConfig);
+}
+
+TEST(HippyTest, snapshot_rejects_malformed_data) {
+  const HPNodeRef root = buildScreen(HPConfigGetDefault(), textLengths);
+  HPNodeDoLayout(root, 300, 600);
+  std::vector<char> buffer = saveSnapshot(root);
+  ASSERT_EQ(0u, HPNodeSaveSnapshot(nullptr, nullptr, 0));
+
+  ASSERT_TRUE(HPNodeLoadSnapshot(buffer.data(), buffer.size() - 1, nullptr, measureText,
+                                 nullptr, nullptr) == nullptr);
+  std::vector<char> copy = buffer;
+  reinterpret_cast<HPSnapshotHeader*>(copy.data())->version++;
+  ASSERT_TRUE(HPNodeLoadSnapshot(copy.data(), copy.size(), nullptr, measureText, nullptr,
+                                 nullptr) == nullptr);
+  copy = buffer;
+  HPSnapshotNode* records = reinterpret_cast<HPSnapshotNode*>(copy.data() +
+                                                              sizeof(HPSnapshotHeader));
+  records[0].childCount = 3;
+  ASSERT_TRUE(HPNodeLoadSnapshot(copy.data(), copy.size(), nullptr, measureText, nullptr,
+                                 nullptr) == nullptr);
+  copy = buffer;
+  records = reinterpret_cast<HPSnapshotNode*>(copy.data() + sizeof(HPSnapshotHeader));
+  records[1].alignItems = 100;
+  ASSERT_TRUE(HPNodeLoadSnapshot(copy.data(), copy.size(), nullptr, measureText, nullptr,
+                                 nullptr) == nullptr);
+  ASSERT_TRUE(HPNodeLoadSnapshotFile("no_such_snapshot.bin", nullptr, measureText, nullptr,
+                                     nullptr) == nullptr);
+
+  HPNodeFreeRecursive(root);
+}
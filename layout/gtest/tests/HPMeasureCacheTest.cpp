@@ -188,3 +188,70 @@ TEST(HippyTest, remeasure_with_already_measured_value_smaller_but_still_float_eq
 
   ASSERT_EQ(1, measureCount);
 }
+
+TEST(HippyTest, measure_cache_replace_least_recently_used) {
+  HPLayoutCache cache;
+  cache.setCapacity(2);
+  HPSizeMode mode = {MeasureModeAtMost, MeasureModeUndefined};
+  cache.cacheResult(HPSize{100, VALUE_UNDEFINED}, HPSize{100, 10}, mode, LayoutActionMeasureWidth);
+  cache.cacheResult(HPSize{200, VALUE_UNDEFINED}, HPSize{200, 10}, mode, LayoutActionMeasureWidth);
+  // use the first one, the second one becomes least recently used.
+  ASSERT_TRUE(cache.getCachedMeasureResult(HPSize{100, VALUE_UNDEFINED}, mode,
+                                           LayoutActionMeasureWidth, false) != nullptr);
+  cache.cacheResult(HPSize{300, VALUE_UNDEFINED}, HPSize{300, 10}, mode, LayoutActionMeasureWidth);
+
+  ASSERT_TRUE(cache.getCachedMeasureResult(HPSize{100, VALUE_UNDEFINED}, mode,
+                                           LayoutActionMeasureWidth, false) != nullptr);
+  ASSERT_TRUE(cache.getCachedMeasureResult(HPSize{200, VALUE_UNDEFINED}, mode,
+                                           LayoutActionMeasureWidth, false) == nullptr);
+  MeasureResult* result = cache.getCachedMeasureResult(HPSize{300, VALUE_UNDEFINED}, mode,
+                                                       LayoutActionMeasureWidth, false);
+  ASSERT_TRUE(result != nullptr);
+  ASSERT_FLOAT_EQ(300, result->resultSize.width);
+
+  HPMeasureCacheStats stats = cache.getStats();
+  ASSERT_EQ(3u, stats.hits);
+  ASSERT_EQ(1u, stats.misses);
+  ASSERT_EQ(1u, stats.evictions);
+
+  // counters are kept when cache is cleared.
+  cache.clearCache();
+  ASSERT_TRUE(cache.getCachedMeasureResult(HPSize{100, VALUE_UNDEFINED}, mode,
+                                           LayoutActionMeasureWidth, false) == nullptr);
+  ASSERT_EQ(2u, cache.getStats().misses);
+  cache.resetStats();
+  ASSERT_EQ(0u, cache.getStats().hits);
+}
+
+TEST(HippyTest, measure_cache_capacity_from_config) {
+  HPConfigRef config = new HPConfig();
+  config->SetMeasureCacheCapacity(16);
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetFlexDirection(root, FLexDirectionRow);
+  HPNodeStyleSetWidth(root, 100);
+  ASSERT_EQ(16u, root->layoutCache.getCapacity());
+
+  int measureCount = 0;
+  for (uint32_t i = 0; i < 3; i++) {
+    const HPNodeRef text = HPNodeNewWithConfig(config);
+    text->setContext(&measureCount);
+    HPNodeSetMeasureFunc(text, _measureMin);
+    HPNodeStyleSetFlexShrink(text, 1);
+    HPNodeInsertChild(root, text, i);
+  }
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_EQ(3, measureCount);
+
+  HPMeasureCacheStats stats = HPNodeGetTreeMeasureCacheStats(root);
+  ASSERT_GT(stats.misses, 0u);
+  ASSERT_EQ(0u, stats.evictions);
+  HPMeasureCacheStats childStats = HPNodeGetMeasureCacheStats(root->getChild(0));
+  ASSERT_LE(childStats.hits + childStats.misses, stats.hits + stats.misses);
+
+  HPNodeResetMeasureCacheStats(root);
+  stats = HPNodeGetTreeMeasureCacheStats(root);
+  ASSERT_EQ(0u, stats.hits + stats.misses + stats.evictions);
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
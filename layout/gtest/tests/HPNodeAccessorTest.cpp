@@ -0,0 +1,61 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Hippy.h>
+#include <gtest.h>
+
+TEST(HippyTest, style_getters_read_back_setters) {
+  const HPNodeRef node = HPNodeNew();
+  HPNodeStyleSetMaxWidth(node, 120);
+  HPNodeStyleSetMinHeight(node, 20);
+  HPNodeStyleSetFlexGrow(node, 2);
+  HPNodeStyleSetFlexBasis(node, 40);
+  HPNodeStyleSetPosition(node, CSSLeft, 8);
+  HPNodeStyleSetFlexDirection(node, FLexDirectionRow);
+  HPNodeStyleSetJustifyContent(node, FlexAlignCenter);
+  HPNodeStyleSetPositionType(node, PositionTypeAbsolute);
+  HPNodeStyleSetOverflow(node, OverflowScroll);
+
+  ASSERT_FLOAT_EQ(120, HPNodeStyleGetMaxWidth(node));
+  ASSERT_FLOAT_EQ(20, HPNodeStyleGetMinHeight(node));
+  ASSERT_FLOAT_EQ(2, HPNodeStyleGetFlexGrow(node));
+  ASSERT_FLOAT_EQ(40, HPNodeStyleGetFlexBasis(node));
+  ASSERT_FLOAT_EQ(8, HPNodeStyleGetPosition(node, CSSLeft));
+  ASSERT_EQ(FLexDirectionRow, HPNodeStyleGetFlexDirection(node));
+  ASSERT_EQ(FlexAlignCenter, HPNodeStyleGetJustifyContent(node));
+  ASSERT_EQ(PositionTypeAbsolute, HPNodeStyleGetPositionType(node));
+  ASSERT_EQ(OverflowScroll, HPNodeStyleGetOverflow(node));
+
+  HPNodeFree(node);
+}
+
+TEST(HippyTest, tree_accessors_and_context) {
+  const HPNodeRef root = HPNodeNew();
+  const HPNodeRef child = HPNodeNew();
+  HPNodeInsertChild(root, child, 0);
+
+  ASSERT_EQ(1u, HPNodeChildCount(root));
+  ASSERT_EQ(child, HPNodeGetChild(root, 0));
+  ASSERT_TRUE(HPNodeGetChild(root, 1) == nullptr);
+  ASSERT_EQ(root, HPNodeGetParent(child));
+  ASSERT_TRUE(HPNodeGetParent(root) == nullptr);
+
+  int tag = 7;
+  HPNodeSetContext(child, &tag);
+  ASSERT_EQ(&tag, HPNodeGetContext(child));
+
+  HPNodeFreeRecursive(root);
+}
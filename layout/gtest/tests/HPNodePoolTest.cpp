@@ -0,0 +1,100 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Hippy.h>
+#include <gtest.h>
+
+TEST(HippyTest, node_pool_reuse_freed_node) {
+  HPConfigRef config = new HPConfig();
+  config->SetUseNodePool(true);
+  HPNodePool* pool = config->GetNodePool();
+
+  const HPNodeRef node0 = HPNodeNewWithConfig(config);
+  ASSERT_EQ(pool, node0->nodePool);
+  ASSERT_EQ(1u, pool->liveCount());
+
+  HPNodeFree(node0);
+  ASSERT_EQ(0u, pool->liveCount());
+
+  const HPNodeRef node1 = HPNodeNewWithConfig(config);
+  ASSERT_EQ(node0, node1);
+  ASSERT_EQ(1u, pool->liveCount());
+
+  HPNodeFree(node1);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, node_pool_free_recursive) {
+  HPConfigRef config = new HPConfig();
+  config->SetUseNodePool(true);
+  HPNodePool* pool = config->GetNodePool();
+
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  for (uint32_t i = 0; i < 100; i++) {
+    const HPNodeRef child = HPNodeNewWithConfig(config);
+    HPNodeInsertChild(root, child, i);
+    for (uint32_t j = 0; j < 10; j++) {
+      HPNodeInsertChild(child, HPNodeNewWithConfig(config), j);
+    }
+  }
+  ASSERT_EQ(1101u, pool->liveCount());
+  ASSERT_EQ(5u, pool->blockCount());
+
+  HPNodeFreeRecursive(root);
+  ASSERT_EQ(0u, pool->liveCount());
+
+  // all memory comes from freed nodes, no more block needed.
+  const HPNodeRef node = HPNodeNewWithConfig(config);
+  ASSERT_EQ(5u, pool->blockCount());
+  HPNodeFree(node);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, node_pool_free_recursive_child_subtree) {
+  HPConfigRef config = new HPConfig();
+  config->SetUseNodePool(true);
+  HPNodePool* pool = config->GetNodePool();
+
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetWidth(root, 100);
+  HPNodeStyleSetHeight(root, 100);
+
+  const HPNodeRef root_child0 = HPNodeNewWithConfig(config);
+  HPNodeStyleSetHeight(root_child0, 10);
+  HPNodeInsertChild(root, root_child0, 0);
+  HPNodeInsertChild(root_child0, HPNodeNewWithConfig(config), 0);
+
+  const HPNodeRef root_child1 = HPNodeNewWithConfig(config);
+  HPNodeStyleSetHeight(root_child1, 20);
+  HPNodeInsertChild(root, root_child1, 1);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(10, HPNodeLayoutGetTop(root_child1));
+
+  // free a subtree in the middle of the tree, it is removed from its parent.
+  HPNodeFreeRecursive(root_child0);
+  ASSERT_EQ(2u, pool->liveCount());
+  ASSERT_EQ(1u, root->childCount());
+  ASSERT_TRUE(root->isDirty);
+
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(0, HPNodeLayoutGetTop(root_child1));
+  ASSERT_FLOAT_EQ(100, HPNodeLayoutGetWidth(root_child1));
+  ASSERT_FLOAT_EQ(20, HPNodeLayoutGetHeight(root_child1));
+
+  HPNodeFreeRecursive(root);
+  ASSERT_EQ(0u, pool->liveCount());
+  HPConfigFree(config);
+}
@@ -0,0 +1,147 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Hippy.h>
+#include <gtest.h>
+#include <stdlib.h>
+
+#include "HPTestTrees.h"
+
+// with HP_PARALLEL_LAYOUT_THREADS set, the default config lays out every
+// item with children in worker threads, so all suites using it run in
+// parallel mode, see build_run_gtest_for_hippy_layout.sh.
+class HPParallelLayoutEnvironment : public testing::Environment {
+ public:
+  void SetUp() override {
+    const char* threads = getenv("HP_PARALLEL_LAYOUT_THREADS");
+    if (threads != nullptr && atoi(threads) > 0) {
+      HPConfigGetDefault()->SetParallelLayout(atoi(threads), 2);
+    }
+  }
+};
+
+static testing::Environment* const parallelLayoutEnvironment =
+    testing::AddGlobalTestEnvironment(new HPParallelLayoutEnvironment());
+
+// same seed gives same tree, a simple LCG keeps it same on all platforms.
+static uint32_t nextRandom(uint32_t& seed) {
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) & 0x7fff;
+}
+
+static void buildRandomTree(HPConfigRef config, HPNodeRef node, uint32_t depth, uint32_t& seed) {
+  uint32_t childCount = depth == 0 ? 0 : nextRandom(seed) % 6;
+  if (childCount == 0) {
+    node->setContext(reinterpret_cast<void*>(static_cast<intptr_t>(1 + nextRandom(seed) % 12)));
+    HPNodeSetMeasureFunc(node, measureText);
+    return;
+  }
+  HPNodeStyleSetFlexDirection(node, static_cast<FlexDirection>(nextRandom(seed) % 4));
+  HPNodeStyleSetFlexWrap(node, nextRandom(seed) % 3 == 0 ? FlexWrap : FlexNoWrap);
+  HPNodeStyleSetPadding(node, CSSAll, nextRandom(seed) % 3 * 1.5f);
+  for (uint32_t i = 0; i < childCount; i++) {
+    const HPNodeRef child = HPNodeNewWithConfig(config);
+    uint32_t kind = nextRandom(seed) % 4;
+    if (kind == 0) {
+      // definite size subtree, laid out in worker threads.
+      HPNodeStyleSetWidth(child, 20.3f + nextRandom(seed) % 80);
+      HPNodeStyleSetHeight(child, 10.7f + nextRandom(seed) % 60);
+    } else if (kind == 1) {
+      HPNodeStyleSetPositionType(child, PositionTypeAbsolute);
+      HPNodeStyleSetPosition(child, CSSLeft, nextRandom(seed) % 10);
+      HPNodeStyleSetPosition(child, CSSRight, nextRandom(seed) % 10);
+      HPNodeStyleSetPosition(child, CSSTop, nextRandom(seed) % 10);
+      HPNodeStyleSetPosition(child, CSSBottom, nextRandom(seed) % 10);
+    } else if (kind == 2) {
+      HPNodeStyleSetFlexGrow(child, nextRandom(seed) % 3);
+    }
+    HPNodeStyleSetMargin(child, CSSLeft, nextRandom(seed) % 4 * 0.7f);
+    HPNodeStyleSetAlignSelf(child, static_cast<FlexAlign>(nextRandom(seed) % 5));
+    HPNodeInsertChild(node, child, i);
+    buildRandomTree(config, child, depth - 1, seed);
+  }
+}
+
+TEST(HippyTest, parallel_layout_same_as_serial) {
+  HPConfigRef config = new HPConfig();
+  HPConfigRef parallelConfig = new HPConfig();
+  // every item with children is a task, not only the large ones.
+  parallelConfig->SetParallelLayout(4, 2);
+  ASSERT_TRUE(parallelConfig->UseParallelLayout());
+
+  for (uint32_t i = 0; i < 50; i++) {
+    uint32_t seed = i;
+    const HPNodeRef root = HPNodeNewWithConfig(config);
+    HPNodeStyleSetWidth(root, 375);
+    buildRandomTree(config, root, 5, seed);
+
+    seed = i;
+    const HPNodeRef parallelRoot = HPNodeNewWithConfig(parallelConfig);
+    HPNodeStyleSetWidth(parallelRoot, 375);
+    buildRandomTree(parallelConfig, parallelRoot, 5, seed);
+
+    HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+    HPNodeDoLayout(parallelRoot, VALUE_UNDEFINED, VALUE_UNDEFINED);
+    assertSameLayout(root, parallelRoot);
+    ASSERT_EQ(config->GetLayoutStats().visitCount, parallelConfig->GetLayoutStats().visitCount);
+
+    // relayout in a different width.
+    HPNodeStyleSetWidth(root, 320);
+    HPNodeStyleSetWidth(parallelRoot, 320);
+    HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+    HPNodeDoLayout(parallelRoot, VALUE_UNDEFINED, VALUE_UNDEFINED);
+    assertSameLayout(root, parallelRoot);
+
+    HPNodeFreeRecursive(root);
+    HPNodeFreeRecursive(parallelRoot);
+  }
+
+  HPConfigFree(config);
+  HPConfigFree(parallelConfig);
+}
+
+TEST(HippyTest, parallel_layout_fixed_size_children) {
+  HPConfigRef config = new HPConfig();
+  config->SetParallelLayout(2, 2);
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetFlexDirection(root, FLexDirectionRow);
+  HPNodeStyleSetFlexWrap(root, FlexWrap);
+  HPNodeStyleSetWidth(root, 100);
+
+  for (uint32_t i = 0; i < 8; i++) {
+    const HPNodeRef cell = HPNodeNewWithConfig(config);
+    HPNodeStyleSetWidth(cell, 50);
+    HPNodeStyleSetHeight(cell, 50);
+    HPNodeStyleSetPadding(cell, CSSAll, 5);
+    HPNodeInsertChild(root, cell, i);
+    const HPNodeRef content = HPNodeNewWithConfig(config);
+    HPNodeStyleSetFlexGrow(content, 1);
+    HPNodeInsertChild(cell, content, 0);
+  }
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  ASSERT_FLOAT_EQ(200, HPNodeLayoutGetHeight(root));
+  for (uint32_t i = 0; i < 8; i++) {
+    const HPNodeRef cell = root->getChild(i);
+    ASSERT_FLOAT_EQ(i % 2 * 50, HPNodeLayoutGetLeft(cell));
+    ASSERT_FLOAT_EQ(i / 2 * 50, HPNodeLayoutGetTop(cell));
+    ASSERT_FLOAT_EQ(40, HPNodeLayoutGetWidth(cell->getChild(0)));
+    ASSERT_FLOAT_EQ(40, HPNodeLayoutGetHeight(cell->getChild(0)));
+  }
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
@@ -0,0 +1,145 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <HPPixelGrid.h>
+#include <gtest.h>
+
+#include <string.h>
+
+#include "HPTestTrees.h"
+
+static uint32_t pixelGridSeed = 7;
+
+static float nextValue() {
+  pixelGridSeed = pixelGridSeed * 1103515245 + 12345;
+  return (pixelGridSeed >> 8) % 200000 / 64.0f - 1000.0f;
+}
+
+static bool sameBits(float a, float b) {
+  return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+TEST(HippyTest, pixel_grid_rounds_same_bits_as_scalar) {
+  std::vector<float> input;
+  const float specials[] = {0.0f, -0.0f, 0.5f, -0.5f, 1.49995f, 2.50004f, 0.99996f,
+                            -3.0f, 8388607.5f, 8388608.0f, -16777216.0f, 1e-40f,
+                            INFINITY, -INFINITY, NAN, 33.3333f, 66.6667f};
+  input.insert(input.end(), specials, specials + sizeof(specials) / sizeof(float));
+  for (uint32_t i = 0; i < 3000; i++) {
+    input.push_back(nextValue());
+  }
+  std::vector<uint32_t> forceCeil(input.size());
+  std::vector<uint32_t> forceFloor(input.size());
+  for (size_t i = 0; i < input.size(); i++) {
+    forceCeil[i] = i % 3 == 1 ? ~0u : 0u;
+    forceFloor[i] = i % 3 == 2 || i % 5 == 0 ? ~0u : 0u;
+  }
+
+  const float scales[] = {1.0f, 2.0f, 3.0f, 1.5f, 2.75f};
+  for (size_t s = 0; s < sizeof(scales) / sizeof(float); s++) {
+    std::vector<float> values(input);
+    HPRoundValuesToPixelGrid(values.data(), forceCeil.data(), forceFloor.data(), values.size(),
+                             scales[s]);
+    for (size_t i = 0; i < input.size(); i++) {
+      float expected =
+          HPRoundValueToPixelGrid(input[i], scales[s], forceCeil[i] != 0, forceFloor[i] != 0);
+      ASSERT_TRUE(sameBits(expected, values[i])) << input[i] << " scale " << scales[s];
+    }
+  }
+}
+
+// rounding of one node as the layout pass did before the flattened pass.
+static void roundEachNode(HPNodeRef node, float absLeft, float absTop, float scaleFactor) {
+  if (!node->hasNewLayout()) {
+    return;
+  }
+  const float left = node->result.position[CSSLeft];
+  const float top = node->result.position[CSSTop];
+  const float width = node->result.dim[DimWidth];
+  const float height = node->result.dim[DimHeight];
+  absLeft += left;
+  absTop += top;
+  bool isTextNode = node->style.nodeType == NodeTypeText;
+  node->result.position[CSSLeft] = HPRoundValueToPixelGrid(left, scaleFactor, false, isTextNode);
+  node->result.position[CSSTop] = HPRoundValueToPixelGrid(top, scaleFactor, false, isTextNode);
+  const bool hasFractionalWidth =
+      !FloatIsEqual(fmodf(width, 1.0), 0) && !FloatIsEqual(fmodf(width, 1.0), 1.0);
+  const bool hasFractionalHeight =
+      !FloatIsEqual(fmodf(height, 1.0), 0) && !FloatIsEqual(fmodf(height, 1.0), 1.0);
+  node->result.dim[DimWidth] =
+      HPRoundValueToPixelGrid(absLeft + width, scaleFactor, isTextNode && hasFractionalWidth,
+                              isTextNode && !hasFractionalWidth) -
+      HPRoundValueToPixelGrid(absLeft, scaleFactor, false, isTextNode);
+  node->result.dim[DimHeight] =
+      HPRoundValueToPixelGrid(absTop + height, scaleFactor, isTextNode && hasFractionalHeight,
+                              isTextNode && !hasFractionalHeight) -
+      HPRoundValueToPixelGrid(absTop, scaleFactor, false, isTextNode);
+  for (size_t i = 0; i < node->children.size(); i++) {
+    roundEachNode(node->children[i], absLeft, absTop, scaleFactor);
+  }
+}
+
+// two same trees with unrounded layout results, some nodes are text nodes,
+// some subtrees have no new layout.
+static void buildUnroundedTrees(HPNodeRef a, HPNodeRef b, uint32_t depth) {
+  for (uint32_t i = 0; i < 4; i++) {
+    HPNodeRef childA = HPNodeNew();
+    HPNodeRef childB = HPNodeNew();
+    HPNodeInsertChild(a, childA, i);
+    HPNodeInsertChild(b, childB, i);
+    if (depth < 4) {
+      buildUnroundedTrees(childA, childB, depth + 1);
+    }
+  }
+  const float left = nextValue() / 10;
+  const float top = nextValue() / 10;
+  const float width = fabsf(nextValue()) / 10;
+  const float height = depth % 2 == 0 ? 24.0f : fabsf(nextValue()) / 10;
+  const bool hasNewLayout = (pixelGridSeed >> 12) % 8 != 0;
+  const bool isTextNode = a->children.empty() && (pixelGridSeed >> 16) % 2 == 0;
+  HPNodeRef nodes[2] = {a, b};
+  for (uint32_t i = 0; i < 2; i++) {
+    nodes[i]->result.position[CSSLeft] = left;
+    nodes[i]->result.position[CSSTop] = top;
+    nodes[i]->result.dim[DimWidth] = width;
+    nodes[i]->result.dim[DimHeight] = height;
+    nodes[i]->setHasNewLayout(hasNewLayout);
+    if (isTextNode) {
+      nodes[i]->style.nodeType = NodeTypeText;
+    }
+  }
+}
+
+TEST(HippyTest, pixel_grid_tree_same_as_rounding_each_node) {
+  const float scales[] = {1.0f, 2.0f, 3.0f, 2.75f};
+  for (size_t s = 0; s < sizeof(scales) / sizeof(float); s++) {
+    const HPNodeRef expected = HPNodeNew();
+    const HPNodeRef root = HPNodeNew();
+    buildUnroundedTrees(expected, root, 0);
+    expected->setHasNewLayout(true);
+    root->setHasNewLayout(true);
+
+    roundEachNode(expected, 0, 0, scales[s]);
+    HPPixelGrid grid;
+    grid.round(root, scales[s]);
+    assertSameLayout(expected, root);
+
+    HPNodeFreeRecursive(expected);
+    HPNodeFreeRecursive(root);
+  }
+}
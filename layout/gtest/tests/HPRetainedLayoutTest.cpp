@@ -0,0 +1,133 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include "HPTestTrees.h"
+
+TEST(HippyTest, retained_layout_reused_on_reattach) {
+  HPConfigRef config = new HPConfig();
+  config->SetRetainDetachedLayout(true);
+  const HPNodeRef list = buildFeedOfSize(config, 300, 3);
+  const HPNodeRef other = buildFeedOfSize(config, 300, 1);
+  HPNodeDoLayout(list, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  HPNodeDoLayout(other, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  const HPNodeRef cell = HPNodeGetChild(list, 2);
+  const HPNodeRef text = HPNodeGetChild(cell, 1);
+  float cellHeight = HPNodeLayoutGetHeight(cell);
+  float textWidth = HPNodeLayoutGetWidth(text);
+  ASSERT_TRUE(HPNodeRemoveChild(list, cell));
+  ASSERT_FLOAT_EQ(cellHeight, HPNodeLayoutGetHeight(cell));
+  ASSERT_FALSE(HPNodeIsDirty(cell));
+
+  // the pass doesn't visit the retained subtree, all of it has new layout.
+  HPNodesetHasNewLayout(cell, false);
+  HPNodesetHasNewLayout(text, false);
+  ASSERT_TRUE(HPNodeInsertChild(other, cell, 0));
+  ASSERT_TRUE(HPNodeHasNewLayout(cell));
+  ASSERT_TRUE(HPNodeHasNewLayout(text));
+  textMeasureCount = 0;
+  HPNodeDoLayout(other, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_EQ(0, textMeasureCount.load());
+  ASSERT_FLOAT_EQ(0, HPNodeLayoutGetTop(cell));
+  ASSERT_FLOAT_EQ(cellHeight, HPNodeLayoutGetTop(HPNodeGetChild(other, 1)));
+  ASSERT_FLOAT_EQ(cellHeight, HPNodeLayoutGetHeight(cell));
+  ASSERT_FLOAT_EQ(textWidth, HPNodeLayoutGetWidth(text));
+  ASSERT_FLOAT_EQ(cellHeight + HPNodeLayoutGetHeight(HPNodeGetChild(other, 1)),
+                  HPNodeLayoutGetHeight(other));
+
+  HPNodeFreeRecursive(list);
+  HPNodeFreeRecursive(other);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, retained_layout_off_by_default) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef list = buildFeedOfSize(config, 300, 2);
+  HPNodeDoLayout(list, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  const HPNodeRef cell = HPNodeGetChild(list, 1);
+  ASSERT_TRUE(HPNodeRemoveChild(list, cell));
+  ASSERT_TRUE(isUndefined(HPNodeLayoutGetHeight(cell)));
+  ASSERT_TRUE(HPNodeIsDirty(cell));
+
+  textMeasureCount = 0;
+  HPNodeInsertChild(list, cell, 0);
+  HPNodeDoLayout(list, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_GT(textMeasureCount.load(), 0);
+
+  HPNodeFreeRecursive(list);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, retained_layout_checks_constraints_and_styles) {
+  HPConfigRef config = new HPConfig();
+  config->SetRetainDetachedLayout(true);
+  const HPNodeRef list = buildFeedOfSize(config, 300, 2);
+  const HPNodeRef narrow = buildFeedOfSize(config, 150, 0);
+  HPNodeDoLayout(list, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  // other width constraint, laid out again.
+  const HPNodeRef cell = HPNodeGetChild(list, 1);
+  HPNodeRemoveChild(list, cell);
+  HPNodeInsertChild(narrow, cell, 0);
+  textMeasureCount = 0;
+  HPNodeDoLayout(narrow, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_GT(textMeasureCount.load(), 0);
+  const HPNodeRef expected = buildFeedOfSize(config, 150, 2);
+  HPNodeDoLayout(expected, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetHeight(HPNodeGetChild(expected, 1)),
+                  HPNodeLayoutGetHeight(cell));
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetWidth(HPNodeGetChild(HPNodeGetChild(expected, 1), 1)),
+                  HPNodeLayoutGetWidth(HPNodeGetChild(cell, 1)));
+
+  // style written directly while detached, layout is dropped on reattach.
+  const HPNodeRef other = HPNodeGetChild(list, 0);
+  HPNodeRemoveChild(list, other);
+  HPNodeRef icon = HPNodeGetChild(other, 0);
+  HPStyle style = icon->getStyle();
+  style.setDim(DimHeight, 80);
+  icon->setStyle(style);
+  ASSERT_FALSE(HPNodeIsDirty(other));
+  HPNodeInsertChild(list, other, 0);
+  ASSERT_TRUE(HPNodeIsDirty(other));
+  HPNodeDoLayout(list, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(90, HPNodeLayoutGetHeight(other));
+
+  HPNodeFreeRecursive(list);
+  HPNodeFreeRecursive(narrow);
+  HPNodeFreeRecursive(expected);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, style_hash) {
+  HPStyle a;
+  HPStyle b;
+  ASSERT_EQ(a.hash(), b.hash());
+  a.setMargin(CSSLeft, 4);
+  ASSERT_NE(a.hash(), b.hash());
+  b.setMargin(CSSLeft, 4);
+  ASSERT_EQ(a.hash(), b.hash());
+  // border set to its initial value is still a set style.
+  a.setBorder(CSSTop, 0);
+  ASSERT_NE(a.hash(), b.hash());
+  a.alignSelf = FlexAlignCenter;
+  b.setBorder(CSSTop, 0);
+  ASSERT_NE(a.hash(), b.hash());
+}
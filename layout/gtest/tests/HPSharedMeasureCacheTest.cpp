@@ -0,0 +1,92 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include "HPTestTrees.h"
+
+// 30 row cells of a text each, contentKinds text lengths in all. texts of
+// the same length share their content hash.
+static HPNodeRef buildList(HPConfigRef config, uint32_t contentKinds) {
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetWidth(root, 300);
+  for (uint32_t i = 0; i < 30; i++) {
+    const HPNodeRef cell = HPNodeNewWithConfig(config);
+    HPNodeStyleSetFlexDirection(cell, FLexDirectionRow);
+    HPNodeInsertChild(root, cell, i);
+    const HPNodeRef text = newText(config, 1 + i % contentKinds);
+    HPNodeSetMeasureContentHash(text, 1 + i % contentKinds);
+    HPNodeInsertChild(cell, text, 0);
+  }
+  return root;
+}
+
+TEST(HippyTest, shared_measure_cache_measure_same_content_once) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildList(config, 3);
+  textMeasureCount = 0;
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  int unsharedMeasureCount = textMeasureCount.load();
+  ASSERT_GE(unsharedMeasureCount, 30);
+
+  HPConfigRef sharedConfig = new HPConfig();
+  sharedConfig->SetSharedMeasureCacheCapacity(64);
+  const HPNodeRef sharedRoot = buildList(sharedConfig, 3);
+  textMeasureCount = 0;
+  HPNodeDoLayout(sharedRoot, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  // one call for each content and measure constraints.
+  ASSERT_LE(textMeasureCount.load(), unsharedMeasureCount / 10);
+  HPMeasureCacheStats stats = sharedConfig->GetSharedMeasureCache()->getStats();
+  ASSERT_EQ(static_cast<uint32_t>(textMeasureCount.load()), stats.misses);
+  ASSERT_GT(stats.hits, 0u);
+
+  for (uint32_t i = 0; i < 30; i++) {
+    HPNodeRef text = root->getChild(i)->getChild(0);
+    HPNodeRef sharedText = sharedRoot->getChild(i)->getChild(0);
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetWidth(text), HPNodeLayoutGetWidth(sharedText));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetHeight(text), HPNodeLayoutGetHeight(sharedText));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetTop(root->getChild(i)),
+                    HPNodeLayoutGetTop(sharedRoot->getChild(i)));
+  }
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(sharedRoot);
+  HPConfigFree(config);
+  HPConfigFree(sharedConfig);
+}
+
+TEST(HippyTest, shared_measure_cache_drop_least_recently_used) {
+  HPSharedMeasureCache cache(2);
+  HPSizeMode mode = {MeasureModeAtMost, MeasureModeUndefined};
+  HPSize size = {100, VALUE_UNDEFINED};
+  HPSize result = {0, 0};
+  cache.put(1, nullptr, size, mode, HPSize{10, 10});
+  cache.put(2, nullptr, size, mode, HPSize{20, 10});
+  ASSERT_TRUE(cache.get(1, nullptr, size, mode, result));
+  ASSERT_FLOAT_EQ(10, result.width);
+  cache.put(3, nullptr, size, mode, HPSize{30, 10});
+  ASSERT_EQ(2u, cache.size());
+  ASSERT_FALSE(cache.get(2, nullptr, size, mode, result));
+  ASSERT_TRUE(cache.get(3, nullptr, size, mode, result));
+  ASSERT_FLOAT_EQ(30, result.width);
+  // different constraints are different entries.
+  ASSERT_FALSE(cache.get(1, nullptr, HPSize{99, VALUE_UNDEFINED}, mode, result));
+  ASSERT_EQ(1u, cache.getStats().evictions);
+
+  cache.clear();
+  ASSERT_EQ(0u, cache.size());
+}
@@ -0,0 +1,194 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include <string.h>
+
+#include <vector>
+
+class StyleBufferWriter {
+ public:
+  StyleBufferWriter() {
+    HPStyleBufferHeader header = {HP_STYLE_BUFFER_VERSION, 0};
+    write(&header, sizeof(header));
+  }
+
+  void beginNode(uint32_t nodeIndex, uint32_t propertyCount) {
+    HPStyleBufferNode node = {nodeIndex, propertyCount};
+    write(&node, sizeof(node));
+    HPStyleBufferHeader* header = reinterpret_cast<HPStyleBufferHeader*>(data.data());
+    header->nodeCount++;
+  }
+
+  void property(HPStyleProperty property, float value, CSSDirection dir = CSSNONE) {
+    HPStyleBufferProperty p = {static_cast<uint16_t>(property), static_cast<int16_t>(dir), value};
+    write(&p, sizeof(p));
+  }
+
+  std::vector<char> data;
+
+ private:
+  void write(const void* bytes, size_t size) {
+    size_t offset = data.size();
+    data.resize(offset + size);
+    memcpy(data.data() + offset, bytes, size);
+  }
+};
+
+TEST(HippyTest, style_buffer_same_as_setters) {
+  const HPNodeRef root = HPNodeNew();
+  HPNodeStyleSetWidth(root, 200);
+  HPNodeStyleSetFlexDirection(root, FLexDirectionRow);
+  HPNodeStyleSetJustifyContent(root, FlexAlignCenter);
+  HPNodeStyleSetPadding(root, CSSAll, 10);
+  const HPNodeRef child = HPNodeNew();
+  HPNodeStyleSetFlexGrow(child, 1);
+  HPNodeStyleSetHeight(child, 20);
+  HPNodeStyleSetMargin(child, CSSLeft, 5);
+  HPNodeInsertChild(root, child, 0);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  HPNodeRef nodes[2] = {HPNodeNew(), HPNodeNew()};
+  HPNodeInsertChild(nodes[0], nodes[1], 0);
+  StyleBufferWriter writer;
+  writer.beginNode(0, 4);
+  writer.property(HPStylePropertyWidth, 200);
+  writer.property(HPStylePropertyFlexDirection, FLexDirectionRow);
+  writer.property(HPStylePropertyJustifyContent, FlexAlignCenter);
+  writer.property(HPStylePropertyPadding, 10, CSSAll);
+  writer.beginNode(1, 3);
+  writer.property(HPStylePropertyFlexGrow, 1);
+  writer.property(HPStylePropertyHeight, 20);
+  writer.property(HPStylePropertyMargin, 5, CSSLeft);
+  ASSERT_TRUE(HPNodeApplyStyleBuffer(nodes, 2, writer.data.data(), writer.data.size()));
+  HPNodeDoLayout(nodes[0], VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetHeight(root), HPNodeLayoutGetHeight(nodes[0]));
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetLeft(child), HPNodeLayoutGetLeft(nodes[1]));
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetWidth(child), HPNodeLayoutGetWidth(nodes[1]));
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetPadding(root, CSSTop), HPNodeLayoutGetPadding(nodes[0], CSSTop));
+
+  HPNodeFreeRecursive(root);
+  HPNodeFreeRecursive(nodes[0]);
+}
+
+TEST(HippyTest, style_buffer_dirty_changed_nodes_only) {
+  HPNodeRef nodes[3] = {HPNodeNew(), HPNodeNew(), HPNodeNew()};
+  HPNodeStyleSetWidth(nodes[0], 100);
+  for (uint32_t i = 1; i < 3; i++) {
+    HPNodeStyleSetHeight(nodes[i], 10);
+    HPNodeInsertChild(nodes[0], nodes[i], i - 1);
+  }
+  HPNodeDoLayout(nodes[0], VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  // same value for node 1, new value for node 2.
+  StyleBufferWriter writer;
+  writer.beginNode(1, 1);
+  writer.property(HPStylePropertyHeight, 10);
+  writer.beginNode(2, 1);
+  writer.property(HPStylePropertyHeight, 30);
+  ASSERT_TRUE(HPNodeApplyStyleBuffer(nodes, 3, writer.data.data(), writer.data.size()));
+  ASSERT_FALSE(nodes[1]->isDirty);
+  ASSERT_TRUE(nodes[2]->isDirty);
+  ASSERT_TRUE(nodes[0]->isDirty);
+
+  HPNodeDoLayout(nodes[0], VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(40, HPNodeLayoutGetHeight(nodes[0]));
+  HPNodeFreeRecursive(nodes[0]);
+}
+
+TEST(HippyTest, style_buffer_reject_bad_buffer) {
+  HPNodeRef nodes[1] = {HPNodeNew()};
+
+  // node index out of nodes, nothing is applied.
+  StyleBufferWriter writer;
+  writer.beginNode(0, 1);
+  writer.property(HPStylePropertyWidth, 50);
+  writer.beginNode(1, 1);
+  writer.property(HPStylePropertyWidth, 50);
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, writer.data.data(), writer.data.size()));
+  ASSERT_TRUE(isUndefined(nodes[0]->style.dim[DimWidth]));
+
+  // truncated
+  StyleBufferWriter truncated;
+  truncated.beginNode(0, 2);
+  truncated.property(HPStylePropertyWidth, 50);
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, truncated.data.data(), truncated.data.size()));
+
+  // other version
+  StyleBufferWriter versioned;
+  versioned.beginNode(0, 1);
+  versioned.property(HPStylePropertyWidth, 50);
+  reinterpret_cast<HPStyleBufferHeader*>(versioned.data.data())->version = 0;
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, versioned.data.data(), versioned.data.size()));
+
+  // bad edge
+  StyleBufferWriter edge;
+  edge.beginNode(0, 1);
+  edge.property(HPStylePropertyMargin, 50, CSSNONE);
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, edge.data.data(), edge.data.size()));
+  ASSERT_TRUE(isUndefined(nodes[0]->style.dim[DimWidth]));
+
+  HPNodeFree(nodes[0]);
+}
+
+TEST(HippyTest, style_buffer_reject_bad_values) {
+  HPNodeRef nodes[1] = {HPNodeNew()};
+
+  // enum out of its values, checked before width is applied.
+  StyleBufferWriter direction;
+  direction.beginNode(0, 2);
+  direction.property(HPStylePropertyWidth, 50);
+  direction.property(HPStylePropertyFlexDirection, 99);
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, direction.data.data(), direction.data.size()));
+  ASSERT_TRUE(isUndefined(nodes[0]->style.dim[DimWidth]));
+  ASSERT_EQ(FLexDirectionColumn, nodes[0]->style.flexDirection);
+
+  // enum not integral.
+  StyleBufferWriter align;
+  align.beginNode(0, 1);
+  align.property(HPStylePropertyAlignItems, 1.5f);
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, align.data.data(), align.data.size()));
+
+  // nan in enum and in a property which can't be undefined.
+  StyleBufferWriter nanEnum;
+  nanEnum.beginNode(0, 1);
+  nanEnum.property(HPStylePropertyDisplay, NAN);
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, nanEnum.data.data(), nanEnum.data.size()));
+  StyleBufferWriter nanGrow;
+  nanGrow.beginNode(0, 1);
+  nanGrow.property(HPStylePropertyFlexGrow, NAN);
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, nanGrow.data.data(), nanGrow.data.size()));
+
+  // infinite length.
+  StyleBufferWriter infinite;
+  infinite.beginNode(0, 1);
+  infinite.property(HPStylePropertyHeight, INFINITY);
+  ASSERT_FALSE(HPNodeApplyStyleBuffer(nodes, 1, infinite.data.data(), infinite.data.size()));
+
+  // nan width is auto.
+  HPNodeStyleSetWidth(nodes[0], 50);
+  StyleBufferWriter autoWidth;
+  autoWidth.beginNode(0, 1);
+  autoWidth.property(HPStylePropertyWidth, VALUE_AUTO);
+  ASSERT_TRUE(HPNodeApplyStyleBuffer(nodes, 1, autoWidth.data.data(), autoWidth.data.size()));
+  ASSERT_TRUE(isUndefined(nodes[0]->style.dim[DimWidth]));
+
+  HPNodeFree(nodes[0]);
+}
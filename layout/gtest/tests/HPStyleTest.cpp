@@ -0,0 +1,182 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <HPStyleStore.h>
+#include <gtest.h>
+
+TEST(HippyTest, style_packs_enums_and_rare_edges) {
+  // enums take one word, edge groups are pointers to interned values,
+  // it was 272 bytes with all of them inline.
+  ASSERT_LE(sizeof(HPStyle), 88u);
+
+  HPStyle style;
+  ASSERT_TRUE(style.border == nullptr);
+  ASSERT_TRUE(style.position == nullptr);
+  ASSERT_FLOAT_EQ(0, style.getStartBorder(FLexDirectionRow));
+  ASSERT_TRUE(isUndefined(style.getStartPosition(FLexDirectionColumn)));
+  ASSERT_TRUE(isUndefined(style.getPosition(CSSLeft)));
+
+  // setting position to auto changes nothing.
+  ASSERT_FALSE(style.setPosition(CSSLeft, VALUE_AUTO));
+  ASSERT_TRUE(style.position == nullptr);
+
+  style.alignSelf = FlexAlignSpaceEvenly;
+  style.overflowType = OverflowScroll;
+  ASSERT_EQ(FlexAlignSpaceEvenly, style.alignSelf);
+  ASSERT_EQ(OverflowScroll, style.overflowType);
+  ASSERT_EQ(FlexAlignStretch, style.alignItems);
+}
+
+TEST(HippyTest, style_allocates_border_and_position_when_set) {
+  HPStyle style;
+  ASSERT_TRUE(style.setBorder(CSSHorizontal, 3));
+  ASSERT_TRUE(style.border != nullptr);
+  ASSERT_TRUE(style.setBorder(CSSLeft, 5));
+  ASSERT_FLOAT_EQ(5, style.getStartBorder(FLexDirectionRow));
+  ASSERT_FLOAT_EQ(3, style.getEndBorder(FLexDirectionRow));
+  ASSERT_FLOAT_EQ(0, style.getStartBorder(FLexDirectionColumn));
+
+  ASSERT_TRUE(style.setPosition(CSSStart, 7));
+  ASSERT_FLOAT_EQ(7, style.getStartPosition(FLexDirectionRow));
+  ASSERT_TRUE(isUndefined(style.getEndPosition(FLexDirectionRow)));
+
+  // copies share their edges until one of them changes.
+  HPStyle copy(style);
+  ASSERT_TRUE(copy.border == style.border);
+  ASSERT_TRUE(copy == style);
+  ASSERT_FLOAT_EQ(5, copy.getStartBorder(FLexDirectionRow));
+  style.setBorder(CSSLeft, 1);
+  ASSERT_TRUE(copy.border != style.border);
+  ASSERT_TRUE(copy != style);
+  ASSERT_FLOAT_EQ(5, copy.getStartBorder(FLexDirectionRow));
+
+  HPStyle assigned;
+  assigned.setPosition(CSSTop, 2);
+  assigned = copy;
+  ASSERT_FLOAT_EQ(7, assigned.getStartPosition(FLexDirectionRow));
+  ASSERT_TRUE(isUndefined(assigned.getPosition(CSSTop)));
+  assigned = HPStyle();
+  ASSERT_TRUE(assigned.border == nullptr);
+  ASSERT_TRUE(assigned.position == nullptr);
+}
+
+TEST(HippyTest, style_interns_equal_edges) {
+  HPStyleStore* store = HPStyleStore::shared();
+  HPStyle a;
+  HPStyle b;
+  ASSERT_TRUE(a.margin == b.margin);
+  ASSERT_TRUE(a.margin == a.padding);
+  ASSERT_TRUE(a == b);
+
+  size_t count = store->edgesCount();
+  a.setMargin(CSSLeft, 8);
+  a.setPadding(CSSAll, 2);
+  ASSERT_EQ(count + 2, store->edgesCount());
+  b.setPadding(CSSAll, 2);
+  b.setMargin(CSSLeft, 8);
+  ASSERT_EQ(count + 2, store->edgesCount());
+  ASSERT_TRUE(a.margin == b.margin);
+  ASSERT_TRUE(a.padding == b.padding);
+  ASSERT_TRUE(a == b);
+
+  // same value, different direction.
+  b.setPadding(CSSAll, VALUE_UNDEFINED);
+  b.setPadding(CSSHorizontal, 2);
+  b.setPadding(CSSVertical, 2);
+  ASSERT_FLOAT_EQ(2, b.getStartPadding(FLexDirectionRow));
+  ASSERT_TRUE(a.padding != b.padding);
+
+  // undefined dims are equal.
+  b = a;
+  ASSERT_TRUE(a == b);
+  b.dim[DimWidth] = 10;
+  ASSERT_TRUE(a != b);
+  b.dim[DimWidth] = VALUE_UNDEFINED;
+  ASSERT_TRUE(a == b);
+
+  // groups go away with the last style using them.
+  a = HPStyle();
+  ASSERT_EQ(count + 2, store->edgesCount());
+  b = HPStyle();
+  ASSERT_EQ(count, store->edgesCount());
+}
+
+TEST(HippyTest, style_zero_edges_immortal) {
+  HPStyleStore* store = HPStyleStore::shared();
+  const HPEdges* zero = store->zeroEdges();
+  size_t count = store->edgesCount();
+
+  // a group equal to all zeros is the zero group.
+  HPStyle a;
+  a.setMargin(CSSTop, 4);
+  ASSERT_TRUE(a.margin != zero);
+  HPEdges edges = *zero;
+  HPStyle::assignEdges(a.margin, &edges);
+  ASSERT_TRUE(a.margin == zero);
+  ASSERT_TRUE(store->intern(*zero) == zero);
+  ASSERT_EQ(count, store->edgesCount());
+
+  // unbalanced releases leave it alone.
+  store->release(zero);
+  store->release(zero);
+  ASSERT_TRUE(HPStyle().padding == zero);
+  ASSERT_FLOAT_EQ(0, HPStyle().getStartPadding(FLexDirectionRow));
+}
+
+TEST(HippyTest, style_set_whole_style) {
+  const HPNodeRef node = HPNodeNew();
+  HPNodeStyleSetWidth(node, 10);
+  HPNodeStyleSetMargin(node, CSSTop, 3);
+  HPNodeDoLayout(node, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FALSE(HPNodeIsDirty(node));
+
+  HPStyle style = node->getStyle();
+  ASSERT_FALSE(HPNodeSetStyle(node, style));
+  ASSERT_FALSE(HPNodeIsDirty(node));
+
+  style.setMargin(CSSTop, 5);
+  ASSERT_TRUE(HPNodeSetStyle(node, style));
+  ASSERT_TRUE(HPNodeIsDirty(node));
+  HPNodeDoLayout(node, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FLOAT_EQ(5, HPNodeLayoutGetTop(node));
+
+  HPNodeFree(node);
+}
+
+TEST(HippyTest, style_border_and_position_in_layout) {
+  const HPNodeRef root = HPNodeNew();
+  HPNodeStyleSetWidth(root, 100);
+  HPNodeStyleSetHeight(root, 100);
+  HPNodeStyleSetBorder(root, CSSAll, 4);
+
+  const HPNodeRef child = HPNodeNew();
+  HPNodeStyleSetPositionType(child, PositionTypeAbsolute);
+  HPNodeStyleSetPosition(child, CSSRight, 10);
+  HPNodeStyleSetPosition(child, CSSTop, 6);
+  HPNodeStyleSetWidth(child, 20);
+  HPNodeStyleSetHeight(child, 20);
+  HPNodeInsertChild(root, child, 0);
+  HPNodeDoLayout(root, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  ASSERT_FLOAT_EQ(4, HPNodeLayoutGetBorder(root, CSSLeft));
+  ASSERT_FLOAT_EQ(66, HPNodeLayoutGetLeft(child));
+  ASSERT_FLOAT_EQ(10, HPNodeLayoutGetTop(child));
+  ASSERT_FLOAT_EQ(10, HPNodeStyleGetPosition(child, CSSRight));
+
+  HPNodeFreeRecursive(root);
+}
@@ -0,0 +1,137 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* trees and measure function shared by tests comparing layout of one tree
+ * in different modes, include it after Hippy.h and gtest.h.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <string.h>
+
+#include <atomic>
+#include <vector>
+
+// calls of measureText, reset by the test counting them. it's called on
+// layout threads too.
+static std::atomic<int> textMeasureCount(0);
+
+// text of length characters wraps in given width, 10 wide and 20 high for
+// each character.
+static inline HPSize measureTextOfLength(intptr_t length,
+                                         float width,
+                                         MeasureMode widthMeasureMode) {
+  float textWidth = length * 10.0f;
+  if (widthMeasureMode != MeasureModeUndefined && textWidth > width) {
+    float lineWidth = width > 10.0f ? width : 10.0f;
+    return HPSize{lineWidth, ceilf(textWidth / lineWidth) * 20.0f};
+  }
+  return HPSize{textWidth, 20.0f};
+}
+
+// measure function of a text, its length is the node context.
+static inline HPSize measureText(HPNodeRef node,
+                                 float width,
+                                 MeasureMode widthMeasureMode,
+                                 float height,
+                                 MeasureMode heightMeasureMode,
+                                 void* layoutContext) {
+  textMeasureCount++;
+  return measureTextOfLength(reinterpret_cast<intptr_t>(node->getContext()), width,
+                             widthMeasureMode);
+}
+
+static inline HPNodeRef newText(HPConfigRef config, intptr_t length) {
+  const HPNodeRef text = HPNodeNewWithConfig(config);
+  HPNodeSetMeasureFunc(text, measureText);
+  text->setContext(reinterpret_cast<void*>(length));
+  return text;
+}
+
+static inline void setTextLength(HPNodeRef text, intptr_t length) {
+  text->setContext(reinterpret_cast<void*>(length));
+  HPNodeMarkDirty(text);
+}
+
+// a feed of row cells, every cell holds an icon and two texts shrinking in
+// the row, so they are measured in more than one width. cells are 50 high or
+// as high as their content.
+static inline HPNodeRef buildFeedOfSize(HPConfigRef config, float width, uint32_t cellCount,
+                                        bool fixedCellHeight = false) {
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetWidth(root, width);
+  for (uint32_t i = 0; i < cellCount; i++) {
+    const HPNodeRef cell = HPNodeNewWithConfig(config);
+    HPNodeStyleSetFlexDirection(cell, FLexDirectionRow);
+    HPNodeStyleSetPadding(cell, CSSAll, 5);
+    if (fixedCellHeight) {
+      HPNodeStyleSetHeight(cell, 50);
+    }
+    HPNodeInsertChild(root, cell, i);
+
+    const HPNodeRef icon = HPNodeNewWithConfig(config);
+    HPNodeStyleSetWidth(icon, 40);
+    HPNodeStyleSetHeight(icon, 40);
+    HPNodeInsertChild(cell, icon, 0);
+
+    for (uint32_t j = 0; j < 2; j++) {
+      const HPNodeRef text = newText(config, 3 + (i * 7 + j * 5) % 30);
+      HPNodeStyleSetFlexShrink(text, 1);
+      HPNodeInsertChild(cell, text, j + 1);
+    }
+  }
+  return root;
+}
+
+// a feed 300 wide of 20 cells.
+static inline HPNodeRef buildFeed(HPConfigRef config, bool fixedCellHeight = false) {
+  return buildFeedOfSize(config, 300, 20, fixedCellHeight);
+}
+
+// results of the two trees are bit identical, not only nearly equal.
+static inline void assertSameLayout(HPNodeRef node, HPNodeRef other) {
+  ASSERT_EQ(0, memcmp(node->result.dim, other->result.dim, sizeof(node->result.dim)));
+  ASSERT_EQ(0,
+            memcmp(node->result.position, other->result.position, sizeof(node->result.position)));
+  ASSERT_EQ(node->childCount(), other->childCount());
+  for (uint32_t i = 0; i < node->childCount(); i++) {
+    assertSameLayout(node->getChild(i), other->getChild(i));
+  }
+}
+
+// record of the node in layout published by an HPLayoutPipeline, nodes are
+// told apart by their context.
+static inline const HPPublishedLayout* findPublishedLayout(
+    const std::vector<HPPublishedLayout>& results, HPNodeRef node) {
+  for (size_t i = 0; i < results.size(); i++) {
+    if (results[i].context == HPNodeGetContext(node)) {
+      return &results[i];
+    }
+  }
+  return nullptr;
+}
+
+// published layout of the node is the layout it got laid out directly.
+static inline void assertSameLayout(const std::vector<HPPublishedLayout>& results,
+                                    HPNodeRef node) {
+  const HPPublishedLayout* record = findPublishedLayout(results, node);
+  ASSERT_TRUE(record != nullptr);
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetLeft(node), record->left);
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetTop(node), record->top);
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetWidth(node), record->width);
+  ASSERT_FLOAT_EQ(HPNodeLayoutGetHeight(node), record->height);
+}
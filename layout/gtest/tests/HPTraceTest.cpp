@@ -0,0 +1,169 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "HPTestTrees.h"
+
+static HPNodeRef buildTracedTree(HPConfigRef config) {
+  const HPNodeRef root = HPNodeNewWithConfig(config);
+  HPNodeStyleSetFlexDirection(root, FLexDirectionRow);
+  HPNodeStyleSetFlexWrap(root, FlexWrap);
+  for (uint32_t i = 0; i < 4; i++) {
+    const HPNodeRef child = HPNodeNewWithConfig(config);
+    HPNodeStyleSetFlexGrow(child, 1);
+    HPNodeInsertChild(root, child, i);
+    const HPNodeRef text = newText(config, 3);
+    HPNodeInsertChild(child, text, 0);
+  }
+  return root;
+}
+
+TEST(HippyTest, trace_off_by_default) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildTracedTree(config);
+  HPNodeDoLayout(root, 200, 200);
+  ASSERT_TRUE(config->tracer == nullptr);
+  HPTracer* tracer = config->GetTracer();
+  ASSERT_FALSE(tracer->isEnabled());
+  HPNodeMarkDirty(root);
+  HPNodeDoLayout(root, 200, 200);
+  ASSERT_TRUE(tracer->getEvents().empty());
+  ASSERT_EQ(0u, tracer->getNodeVisits(root));
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, trace_pass_stats) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildTracedTree(config);
+  HPTracer* tracer = config->GetTracer();
+  tracer->setEnabled(true);
+
+  textMeasureCount = 0;
+  HPNodeDoLayout(root, 200, 200);
+  HPTracePassStats stats = tracer->getLastPassStats();
+  ASSERT_EQ(static_cast<uint32_t>(textMeasureCount.load()), stats.measureCalls);
+  ASSERT_GT(stats.measureCalls, 0u);
+  ASSERT_EQ(9u, stats.nodeCount);
+  ASSERT_EQ(config->GetLayoutStats().visitCount, stats.layoutCount + stats.measureCount);
+  ASSERT_GE(stats.maxNodeVisits, tracer->getNodeVisits(root));
+  ASSERT_GE(tracer->getNodeVisits(HPNodeGetChild(root, 0)), 1u);
+
+  std::vector<HPTraceEvent> events = tracer->getEvents();
+  ASSERT_EQ(stats.measureCalls + 1, events.size());
+  ASSERT_EQ(HPTraceEventMeasure, events[0].type);
+  const HPTraceEvent& pass = events.back();
+  ASSERT_EQ(HPTraceEventPass, pass.type);
+  ASSERT_STREQ("layout", pass.name);
+  ASSERT_LE(events[0].start, pass.start + pass.duration);
+
+  // nothing changed, the pass is served by layout cache.
+  textMeasureCount = 0;
+  HPNodeDoLayout(root, 200, 200);
+  stats = tracer->getLastPassStats();
+  ASSERT_EQ(0, textMeasureCount.load());
+  ASSERT_EQ(0u, stats.measureCalls);
+  ASSERT_GT(stats.layoutCacheHits + stats.measureCacheHits, 0u);
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
+
+TEST(HippyTest, trace_ring_buffer) {
+  HPTracer tracer(4);
+  tracer.setEnabled(true);
+  for (uint32_t i = 0; i < 10; i++) {
+    tracer.beginPass();
+    tracer.endPass(tracer.now());
+  }
+  {
+    HPTraceScope scope(&tracer, "export");
+  }
+  std::vector<HPTraceEvent> events = tracer.getEvents();
+  ASSERT_EQ(4u, events.size());
+  ASSERT_EQ(HPTraceEventScope, events[3].type);
+  ASSERT_STREQ("export", events[3].name);
+  for (uint32_t i = 1; i < events.size(); i++) {
+    ASSERT_LE(events[i - 1].start, events[i].start);
+  }
+
+  tracer.setEnabled(false);
+  {
+    HPTraceScope scope(&tracer, "skipped");
+  }
+  ASSERT_EQ(4u, tracer.getEvents().size());
+  tracer.clear();
+  ASSERT_TRUE(tracer.getEvents().empty());
+}
+
+TEST(HippyTest, trace_chrome_json) {
+  HPConfigRef config = new HPConfig();
+  const HPNodeRef root = buildTracedTree(config);
+  HPTracer* tracer = config->GetTracer();
+  tracer->setEnabled(true);
+  HPNodeDoLayout(root, 200, 200);
+
+  std::string json = tracer->toChromeTraceJson();
+  ASSERT_EQ(0u, json.find("{\"traceEvents\":[{"));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"layout\""));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"measure\""));
+  ASSERT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+  ASSERT_NE(std::string::npos, json.find("\"cache_hit_rate\":"));
+  ASSERT_NE(std::string::npos, json.find("\"max_node_visits\":"));
+  ASSERT_EQ(json.size() - 1, json.rfind("}"));
+
+  tracer->clear();
+  ASSERT_EQ("{\"traceEvents\":[],\"displayTimeUnit\":\"ms\"}", tracer->toChromeTraceJson());
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
+
+static uint32_t sumNodeVisits(HPTracer* tracer, HPNodeRef node) {
+  uint32_t visits = tracer->getNodeVisits(node);
+  for (uint32_t i = 0; i < HPNodeChildCount(node); i++) {
+    visits += sumNodeVisits(tracer, HPNodeGetChild(node, i));
+  }
+  return visits;
+}
+
+TEST(HippyTest, trace_visits_of_parallel_layout) {
+  HPConfigRef config = new HPConfig();
+  config->SetParallelLayout(4, 2);
+  const HPNodeRef root = buildFeed(config);
+  HPTracer* tracer = config->GetTracer();
+  tracer->setEnabled(true);
+
+  // visits counted by the workers are merged at the end of the pass.
+  for (uint32_t pass = 0; pass < 3; pass++) {
+    HPNodeMarkDirty(HPNodeGetChild(HPNodeGetChild(root, pass), 1));
+    HPNodeDoLayout(root, 300, VALUE_UNDEFINED);
+    HPTracePassStats stats = tracer->getLastPassStats();
+    ASSERT_EQ(stats.layoutCount + stats.measureCount, sumNodeVisits(tracer, root));
+    ASSERT_GT(stats.nodeCount, 0u);
+    ASSERT_GE(stats.maxNodeVisits, 1u);
+  }
+
+  HPNodeFreeRecursive(root);
+  HPConfigFree(config);
+}
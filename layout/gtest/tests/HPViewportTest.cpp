@@ -0,0 +1,98 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2018 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Hippy.h>
+#include <gtest.h>
+
+#include "HPTestTrees.h"
+
+// scroll column of count rows, texts wrapped into 4 lines 80 high.
+static HPNodeRef buildScrollList(uint32_t count) {
+  const HPNodeRef list = HPNodeNew();
+  HPNodeStyleSetOverflow(list, OverflowScroll);
+  HPNodeStyleSetWidth(list, 300);
+  HPNodeStyleSetHeight(list, 500);
+  for (uint32_t i = 0; i < count; i++) {
+    HPNodeInsertChild(list, newText(HPConfigGetDefault(), 100), i);
+  }
+  return list;
+}
+
+TEST(HippyTest, viewport_lays_out_items_in_range_only) {
+  const HPNodeRef list = buildScrollList(1000);
+  HPNodeSetViewport(list, 0, 500, 100, 50);
+  textMeasureCount = 0;
+  HPNodeDoLayout(list, VALUE_UNDEFINED, VALUE_UNDEFINED);
+
+  // rows in [0, 600] are measured, the others take the estimated size.
+  ASSERT_LE(textMeasureCount.load(), 16);
+  ASSERT_FALSE(HPNodeIsOutOfViewport(HPNodeGetChild(list, 0)));
+  ASSERT_FLOAT_EQ(80, HPNodeLayoutGetHeight(HPNodeGetChild(list, 0)));
+  ASSERT_FLOAT_EQ(80, HPNodeLayoutGetTop(HPNodeGetChild(list, 1)));
+  const HPNodeRef far = HPNodeGetChild(list, 500);
+  ASSERT_TRUE(HPNodeIsOutOfViewport(far));
+  ASSERT_FLOAT_EQ(50, HPNodeLayoutGetHeight(far));
+  ASSERT_FLOAT_EQ(300, HPNodeLayoutGetWidth(far));
+
+  // scrolling within laid out rows needs no layout.
+  HPNodeSetViewport(list, 20, 500, 100, 50);
+  ASSERT_FALSE(HPNodeIsDirty(list));
+
+  // rows scrolled into range are laid out lazily.
+  float farTop = HPNodeLayoutGetTop(far);
+  HPNodeSetViewport(list, farTop, 500, 100, 50);
+  ASSERT_TRUE(HPNodeIsDirty(list));
+  textMeasureCount = 0;
+  HPNodeDoLayout(list, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_GT(textMeasureCount.load(), 0);
+  ASSERT_LE(textMeasureCount.load(), 16);
+  ASSERT_FALSE(HPNodeIsOutOfViewport(far));
+  ASSERT_FLOAT_EQ(80, HPNodeLayoutGetHeight(far));
+  // rows laid out before keep their size after scrolled out of range.
+  ASSERT_TRUE(HPNodeIsOutOfViewport(HPNodeGetChild(list, 0)));
+  ASSERT_FLOAT_EQ(80, HPNodeLayoutGetHeight(HPNodeGetChild(list, 0)));
+
+  HPNodeFreeRecursive(list);
+}
+
+TEST(HippyTest, viewport_covering_all_items_same_as_full_layout) {
+  const HPNodeRef list = buildScrollList(50);
+  const HPNodeRef windowed = buildScrollList(50);
+  HPNodeSetViewport(windowed, 0, 500, 10000, 50);
+  HPNodeDoLayout(list, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  HPNodeDoLayout(windowed, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  for (uint32_t i = 0; i < 50; i++) {
+    ASSERT_FALSE(HPNodeIsOutOfViewport(HPNodeGetChild(windowed, i)));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetTop(HPNodeGetChild(list, i)),
+                    HPNodeLayoutGetTop(HPNodeGetChild(windowed, i)));
+    ASSERT_FLOAT_EQ(HPNodeLayoutGetHeight(HPNodeGetChild(list, i)),
+                    HPNodeLayoutGetHeight(HPNodeGetChild(windowed, i)));
+  }
+
+  // viewport is ignored by containers that don't scroll.
+  const HPNodeRef plain = HPNodeNew();
+  HPNodeStyleSetHeight(plain, 500);
+  const HPNodeRef child = HPNodeNew();
+  HPNodeStyleSetHeight(child, 100);
+  HPNodeInsertChild(plain, child, 0);
+  HPNodeSetViewport(plain, 10000, 10, 0, 50);
+  HPNodeDoLayout(plain, VALUE_UNDEFINED, VALUE_UNDEFINED);
+  ASSERT_FALSE(HPNodeIsOutOfViewport(child));
+
+  HPNodeFreeRecursive(list);
+  HPNodeFreeRecursive(windowed);
+  HPNodeFreeRecursive(plain);
+}